@@ -3,6 +3,7 @@
  * @ Description: AScheduler
  */
 
+#include <cmath>
 #include <iostream>
 
 #include <Core/StringUtils.hpp>
@@ -18,13 +19,17 @@ AScheduler::AScheduler(void)
     for (auto &cache : _graphs) {
         cache.graph.setRepeatCallback([this](void) -> bool {
             bool exited = false;
-            if (_overflowCache) {
+            if (_hasOverflowBlock) {
+                exited = onAudioQueueBusy();
+            } else if (playbackMode() == PlaybackMode::Production && processRenderAhead()) {
+                // The speculative blocks were dropped, the rendering resumes before the edit
                 exited = onAudioQueueBusy();
             } else {
                 getCurrentBeatRange().increment(_processBeatSize);
                 processBeatMiss();
-                if (isLooping())
-                    processLooping();
+                const bool looped = isLooping() && processLooping();
+                if (playbackMode() == PlaybackMode::Partition)
+                    processPreviewCache(looped);
                 if (produceAudioData(_project->master()->cache())) {
                     exited = onAudioBlockGenerated();
                 } else {
@@ -33,6 +38,7 @@ AScheduler::AScheduler(void)
             }
             if (exited) {
                 std::cout << "Shutting down process graph, clearing cache" << std::endl;
+                _previewCache->stop();
                 clearAudioQueue();
                 clearOverflowCache();
                 return false;
@@ -42,6 +48,12 @@ AScheduler::AScheduler(void)
     }
 }
 
+AScheduler::~AScheduler(void)
+{
+    if (_project && _project->master())
+        UnbindCaches(*_project->master());
+}
+
 bool AScheduler::setState(const State state) noexcept
 {
     switch (state) {
@@ -89,7 +101,7 @@ void AScheduler::processBeatMiss(void) noexcept
         };
     }
 }
-void AScheduler::processLooping(void) noexcept
+bool AScheduler::processLooping(void) noexcept
 {
     auto &range = getCurrentBeatRange();
 
@@ -107,13 +119,114 @@ void AScheduler::processLooping(void) noexcept
             _loopBeatRange.from + _processBeatSize
         };
         _beatMissCount = _beatMissOffset;
+        return true;
+    }
+    return false;
+}
+
+bool AScheduler::processRenderAhead(void) noexcept
+{
+    const auto from = _renderAheadInvalidBeat.exchange(RenderAheadValidBeat);
+
+    // Nobody is editing the project, render further ahead
+    if (from == RenderAheadValidBeat) {
+        _AudioQueue.setDepth(_AudioQueue.depth() + 1);
+        return false;
+    }
+    _AudioQueue.setDepth(RenderAheadMinBlockCount);
+    const AudioBlockQueue::Block *lastKept;
+    const auto isValid = [from](const AudioBlockQueue::Block &block) { return block.nextRange.from <= from; };
+    // The audio callback is reading, retry on next block
+    if (!_AudioQueue.tryRetract(RenderAheadMinBlockCount, isValid, lastKept)) {
+        invalidateRenderAhead(from);
+        return false;
     }
+    // Resume from the state following the last kept block, the nodes state is reset to the resumed range
+    if (lastKept) {
+        getCurrentBeatRange() = lastKept->nextRange;
+        _beatMissCount = lastKept->nextBeatMissCount;
+        onAudioProcessStarted(getCurrentBeatRange());
+        return true;
+    }
+    // Every queued block is valid, only the block just rendered may have to be rendered again
+    if (getCurrentBeatRange().to <= from)
+        return false;
+    onAudioProcessStarted(getCurrentBeatRange());
+    return true;
+}
+
+void AScheduler::beginPreviewCache(const bool continued)
+{
+    const bool replaying = _previewCache->state() == PreviewCache::State::Replay;
+
+    if (playbackMode() != PlaybackMode::Partition || !_partitionNode || _partitionIndex >= _partitionNode->partitions().size()) {
+        _previewCache->stop();
+        return;
+    }
+    const auto &partition = _partitionNode->partitions()[_partitionIndex];
+    const auto &master = _project->master()->cache();
+    Beat tailBeat = 0u;
+    for (const auto &note : partition)
+        tailBeat = std::max(tailBeat, note.range.to);
+    const auto hash = PreviewCache::ComputeHash(
+        *_partitionNode,
+        partition,
+        AudioSpecs { _sampleRate, master.channelArrangement(), master.format(), _processBlockSize },
+        _bpm,
+        getCurrentBeatRange(),
+        _loopBeatRange,
+        _isLooping,
+        continued
+    );
+    // Blocks are reserved up to the last note and its tail, so the recording doesn't allocate
+    const auto from = getCurrentBeatRange().from;
+    const auto noteBlockCount = tailBeat > from ? (tailBeat - from) / std::max<Beat>(_processBeatSize, 1u) + 1u : 0u;
+    const auto tailBlockCount = static_cast<std::size_t>(std::ceil(PreviewTailDuration * static_cast<float>(_sampleRate) / static_cast<float>(std::max(_processBlockSize, 1u))));
+    // A preview can only be recorded if the nodes state follows the rendering, which is not the case after a replay
+    if (!_previewCache->begin(hash, tailBeat, !replaying, master, noteBlockCount + tailBlockCount) && replaying)
+        onAudioProcessStarted(getCurrentBeatRange());
+}
+
+bool AScheduler::replayPreviewCache(void) noexcept
+{
+    if (_previewCache->state() != PreviewCache::State::Replay)
+        return false;
+    if (!hasPreviewNotesOnTheFly() && _previewCache->replay(_project->master()->cache()))
+        return true;
+    // The preview is exhausted or live notes are pending, resume the rendering from a fresh generation state
+    _previewCache->stop();
+    onAudioProcessStarted(getCurrentBeatRange());
+    return false;
+}
+
+void AScheduler::processPreviewCache(const bool looped)
+{
+    // The tasks consumed the events on the fly while rendering, the block can't be part of a preview
+    const bool hasEventsOnTheFly = _hasConsumedEventsOnTheFly.exchange(false, std::memory_order_relaxed);
+
+    if (_previewCache->state() == PreviewCache::State::Record) {
+        if (hasEventsOnTheFly)
+            _previewCache->stop();
+        else
+            _previewCache->record(_project->master()->cache(), getCurrentBeatRange());
+    }
+    if (looped) {
+        _previewCache->complete();
+        beginPreviewCache(true);
+    }
+}
+
+bool AScheduler::hasPreviewNotesOnTheFly(void) const noexcept
+{
+    const auto &partitions = _partitionNode->partitions();
+
+    return partitions.isSafe() && partitions.headerCustomType().notesOnTheFly;
 }
 
 
 bool AScheduler::consumeAudioData(std::uint8_t *data, const std::size_t size)
 {
-    if (!_AudioQueue.tryPopRange(data, data + size)) {
+    if (!_AudioQueue.tryPop(data, size)) {
         std::memset(data, 0, size);
         return false;
     }
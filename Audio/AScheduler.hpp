@@ -8,14 +8,18 @@
 #include <functional>
 #include <atomic>
 #include <future>
+#include <limits>
 
 #include <Core/Functor.hpp>
-#include <Core/SPSCQueue.hpp>
 #include <Flow/Scheduler.hpp>
 
 #include "Project.hpp"
 #include "Buffer.hpp"
+#include "AudioBlockQueue.hpp"
 #include "SchedulerTask.hpp"
+#include "SchedulerTaskChain.hpp"
+#include "CacheAllocator.hpp"
+#include "PreviewCache.hpp"
 
 namespace Audio
 {
@@ -53,6 +57,29 @@ public:
     using PlaybackGraphs = std::array<PlaybackGraph, Audio::PlaybackModeCount>;
 
 
+    /** @brief Default duration rendered ahead of the audio callback while the project isn't edited (in seconds) */
+    static constexpr float DefaultRenderAheadDuration = 1.0f;
+
+    /** @brief Number of blocks queued ahead of the audio callback right after an edit */
+    static constexpr std::size_t RenderAheadMinBlockCount = 4u;
+
+    /** @brief Invalid beat of the render-ahead region when nothing has to be invalidated */
+    static constexpr Beat RenderAheadValidBeat = std::numeric_limits<Beat>::max();
+
+    /** @brief Duration reserved to record the tail of a preview after its last note (in seconds) */
+    static constexpr float PreviewTailDuration = 2.0f;
+
+
+    /** @brief Maximum number of lanes in which the leaf children of a node accumulate their output */
+    static constexpr std::size_t AccumulationLaneCount = 4u;
+
+    /** @brief Number of spare blocks pooled for the buffers requested while processing (recorded previews, queue fallback) */
+    static constexpr std::size_t PreWarmBlockCount = 8u;
+
+    /** @brief Default size of the arena mapped by the first 'prepareCache', the pooled buffers are carved from it */
+    static constexpr std::size_t DefaultBufferArenaByteSize = 64ul * 1024ul * 1024ul;
+
+
     /** @brief Default constructor (will crash if you play without project !) */
     AScheduler(void);
 
@@ -60,12 +87,12 @@ public:
     AScheduler(ProjectPtr &&project);
 
     /** @brief Virtual destructor */
-    virtual ~AScheduler(void) = default;
+    virtual ~AScheduler(void);
 
     /** @brief Get / Set internal project */
     [[nodiscard]] ProjectPtr &project(void) noexcept { return _project; }
     [[nodiscard]] const ProjectPtr &project(void) const noexcept { return _project; }
-    void setProject(ProjectPtr &&project) noexcept { _project = std::move(project); }
+    void setProject(ProjectPtr &&project);
 
 
     /** @brief Get / set internal state */
@@ -89,6 +116,11 @@ public:
     void setIsLooping(const bool isLooping) noexcept { _isLooping = isLooping; }
 
 
+    /** @brief Get / Set if the chains of nodes are fused into single tasks, applied on next graph build */
+    [[nodiscard]] bool taskFusion(void) const noexcept { return _taskFusion; }
+    void setTaskFusion(const bool taskFusion) noexcept { _taskFusion = taskFusion; setDirtyFlags(); }
+
+
     /** @brief Get / Set the playback mode */
     [[nodiscard]] PlaybackMode playbackMode(void) const noexcept { return _playbackMode; }
     void setPlaybackMode(const PlaybackMode mode) noexcept { _playbackMode = mode; }
@@ -115,6 +147,13 @@ public:
     [[nodiscard]] std::uint32_t partitionIndex(void) const noexcept { return _partitionIndex; }
     void setPartitionIndex(const std::uint32_t partitionIndex) noexcept { _partitionIndex = partitionIndex; }
 
+    /** @brief Get the partition preview cache */
+    [[nodiscard]] PreviewCache &previewCache(void) noexcept { return *_previewCache; }
+    [[nodiscard]] const PreviewCache &previewCache(void) const noexcept { return *_previewCache; }
+
+    /** @brief Get the number of caches shared between the nodes of the last built graph */
+    [[nodiscard]] std::size_t sharedCacheCount(void) const noexcept { return _sharedCaches.size(); }
+
     /** @brief Get the sample rate */
     [[nodiscard]] SampleRate sampleRate(void) const noexcept { return _sampleRate; }
 
@@ -133,13 +172,37 @@ public:
     void setBPM(const BPM bpm) noexcept;
 
 
-    /** @brief Add apply event to be dispatched */
+    /** @brief Get / Set the maximum duration rendered ahead in production mode (in seconds), applied on next 'prepareCache' */
+    [[nodiscard]] float renderAheadDuration(void) const noexcept { return _renderAheadDuration; }
+    void setRenderAheadDuration(const float duration) noexcept { _renderAheadDuration = duration; }
+
+    /** @brief Get / Set the configuration of the buffer arena, applied on the first 'prepareCache' (the arena is kept once mapped) */
+    [[nodiscard]] const Internal::BufferAllocator::ArenaConfig &bufferArenaConfig(void) const noexcept { return _bufferArenaConfig; }
+    void setBufferArenaConfig(const Internal::BufferAllocator::ArenaConfig &config) noexcept { _bufferArenaConfig = config; }
+
+    /** @brief Get the memory backing the buffer arena, None until the arena is mapped */
+    [[nodiscard]] Internal::BufferAllocator::ArenaBacking bufferArenaBacking(void) const noexcept { return Internal::BufferAllocator::GetArenaBacking(); }
+
+    /** @brief Invalidate the audio rendered ahead from a given beat, it will be rendered again
+     *  Must be called when the project is edited or when events are sent on the fly during playback */
+    void invalidateRenderAhead(const Beat from = 0u) noexcept;
+
+
+    /** @brief Add apply event to be dispatched, the whole audio rendered ahead is invalidated */
+    template<typename Apply>
+    void addEvent(Apply &&apply) { addEditEvent(0u, std::forward<Apply>(apply)); }
+
+    /** @brief Add apply and notify events to be dispatched, the whole audio rendered ahead is invalidated */
+    template<typename Apply, typename Notify>
+    void addEvent(Apply &&apply, Notify &&notify) { addEditEvent(0u, std::forward<Apply>(apply), std::forward<Notify>(notify)); }
+
+    /** @brief Add apply event editing the project from 'editBeat', only the audio rendered ahead after it is invalidated */
     template<typename Apply>
-    void addEvent(Apply &&apply);
+    void addEditEvent(const Beat editBeat, Apply &&apply);
 
-    /** @brief Add apply and notify events to be dispatched */
+    /** @brief Add apply and notify events editing the project from 'editBeat', only the audio rendered ahead after it is invalidated */
     template<typename Apply, typename Notify>
-    void addEvent(Apply &&apply, Notify &&notify);
+    void addEditEvent(const Beat editBeat, Apply &&apply, Notify &&notify);
 
 
     /** @brief Get the currently used graph (depend of playback mode) */
@@ -180,7 +243,7 @@ public:
     /** @brief Init internal cache */
     void prepareCache(const AudioSpecs &specs);
 
-    /** @brief Clear the overflow cache */
+    /** @brief Drop the block waiting for a free slot in the audio queue */
     void clearOverflowCache(void);
 
     /** @brief Clear the audio queue */
@@ -198,6 +261,10 @@ public:
     [[nodiscard]] Beat audioElapsedBeat(void) const noexcept { return _audioElapsedBeat.load(); }
 
 
+    /** @brief Signal that events sent on the fly were consumed by the block being rendered, called by the scheduler tasks */
+    void notifyEventsOnTheFlyConsumed(void) const noexcept { _hasConsumedEventsOnTheFly.store(true, std::memory_order_relaxed); }
+
+
     /** @brief Get the current beat miss offset / count */
     [[nodiscard]] double beatMissOffset(void) const noexcept { return _beatMissOffset; }
     [[nodiscard]] double beatMissCount(void) const noexcept { return _beatMissCount; }
@@ -227,9 +294,12 @@ private:
     std::unique_ptr<Flow::Scheduler> _scheduler { std::make_unique<Flow::Scheduler>() };
     Core::TinyVector<Event> _events {}; // @todo Use two vectors instead of one
     ProjectPtr _project {};
-    Buffer _overflowCache {};
+    std::unique_ptr<PreviewCache> _previewCache { std::make_unique<PreviewCache>() };
     PlaybackMode _playbackMode { PlaybackMode::Production };
+    bool _hasOverflowBlock { false }; // The master cache holds a block that didn't fit in the audio queue
     std::atomic<State> _state { State::Pause };
+    std::atomic<Beat> _renderAheadInvalidBeat { RenderAheadValidBeat };
+    float _renderAheadDuration { DefaultRenderAheadDuration };
 
     // Cacheline 2
     Audio::BeatRange _loopBeatRange {};
@@ -238,6 +308,8 @@ private:
     BlockSize _processBlockSize { 0u };
     bool _isLooping { false };
     bool _hasExitedGraph { true };
+    mutable std::atomic<bool> _hasConsumedEventsOnTheFly { false }; // Set when the block being rendered consumed events on the fly
+    bool _taskFusion { true };
     std::uint32_t _partitionIndex { 0 };
     Node *_partitionNode { nullptr };
     double _beatMissCount { 0.0 };
@@ -248,6 +320,7 @@ private:
 
     // Cacheline 3
     PlaybackGraphs _graphs {};
+    Internal::BufferAllocator::ArenaConfig _bufferArenaConfig { DefaultBufferArenaByteSize, true, false };
 
     // Cacheline 4 - High frequency atomic read / write
     std::atomic<Beat> _audioElapsedBeat { 0u }; // Represent elapsed beat since last play
@@ -255,9 +328,10 @@ private:
     BlockSize _audioBlockSize { 0u };
     double _audioBlockBeatMissCount { 0.0 };
     double _audioBlockBeatMissOffset { 0.0 };
+    CacheAllocator::Pool _sharedCaches {}; // Node caches shared according to their lifetimes, only touched when the graph is built
 
     /** @brief Audio callback queue */
-    static inline Core::SPSCQueue<std::uint8_t> _AudioQueue { 2048 * 4 * 4 };
+    static inline AudioBlockQueue _AudioQueue {};
 
 
     /** @brief Build a graph */
@@ -266,21 +340,65 @@ private:
 
     /** @brief Build a node in a graph */
     template<Audio::PlaybackMode Playback>
-    void buildNodeTask(const Node *node, std::pair<Flow::Task, const NoteEvents *> &parentNoteTask, std::pair<Flow::Task, const NoteEvents *> &parentAudioTask);
+    void buildNodeTask(Node *node, std::pair<Flow::Task, const NoteEvents *> &parentNoteTask, std::pair<Flow::Task, const NoteEvents *> &parentAudioTask,
+            CacheAllocator &cacheAllocator, const CacheAllocator::Step parentNoteStep, const CacheAllocator::Step parentAudioStep);
 
+    /** @brief Restore the own cache of every node of a tree */
+    static void UnbindCaches(Node &node);
 
-    /** @brief Will feed audio data into the global queue */
-    bool produceAudioData(const BufferView output);
+    /** @brief Count the lane caches that will be allocated when the graph of a node tree is built */
+    [[nodiscard]] static std::size_t CountMissingLaneCaches(const Node &node) noexcept;
+
+    /** @brief Check if a node and its descendants form a single chain (every node has at most one child) */
+    [[nodiscard]] static bool IsTaskChain(const Node &node) noexcept;
+
+    /** @brief Build a chain of nodes as a single task
+     *  Notes are processed from the top of the chain to its leaf, then audio goes back up */
+    template<Audio::PlaybackMode Playback>
+    [[nodiscard]] Flow::Task buildTaskChain(Node *node, const NoteEvents * const parentNoteStack,
+            CacheAllocator &cacheAllocator, const CacheAllocator::Step parentNoteStep, const CacheAllocator::Step parentAudioStep);
+
+    /** @brief Build the children of a node in a graph
+     *  Leaf children able to accumulate are spread over the node lane caches, the tasks of a lane run serially */
+    template<Audio::PlaybackMode Playback>
+    void buildChildrenTasks(Node *node, std::pair<Flow::Task, const NoteEvents *> &noteTask, std::pair<Flow::Task, const NoteEvents *> &audioTask,
+            CacheAllocator &cacheAllocator, const CacheAllocator::Step noteStep, const CacheAllocator::Step audioStep);
 
+
+    /** @brief Will hand the output block over to the global queue, output then holds a free block
+     *  If the queue is full, the block stays in output until flushOverflowCache succeeds */
+    bool produceAudioData(Buffer &output);
+
+    /** @brief Try to hand the pending master block over to the global queue */
     bool flushOverflowCache(void);
 
-    /** @brief Process looping, it modify the currentBeatRange */
-    void processLooping(void) noexcept;
+    /** @brief Process looping, it modify the currentBeatRange
+     *  @return true if the range went back to the loop begin */
+    bool processLooping(void) noexcept;
 
     /** @brief Process the beat misses, it modify the incrementation of the currentBeatRange */
     void processBeatMiss(void) noexcept;
 
 
+    /** @brief Grow the render-ahead region while idle, or drop its invalidated part
+     *  @return true if the block just rendered must be discarded */
+    [[nodiscard]] bool processRenderAhead(void) noexcept;
+
+
+    /** @brief Begin a partition preview using the cache, 'continued' is true when the preview went back to the loop begin */
+    void beginPreviewCache(const bool continued);
+
+    /** @brief Replay a block from the preview cache into the master cache
+     *  @return true if the block doesn't need to be rendered */
+    [[nodiscard]] bool replayPreviewCache(void) noexcept;
+
+    /** @brief Record the last rendered block into the preview cache */
+    void processPreviewCache(const bool looped);
+
+    /** @brief Check if the partition node has pending notes on the fly, making the preview not replayable */
+    [[nodiscard]] bool hasPreviewNotesOnTheFly(void) const noexcept;
+
+
     /** @brief Schedule the current graph */
     void scheduleCurrentGraph(void);
 };
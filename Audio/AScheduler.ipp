@@ -11,28 +11,39 @@ inline Audio::AScheduler::AScheduler(ProjectPtr &&project)
     setProject(std::move(project));
 }
 
+inline void Audio::AScheduler::setProject(ProjectPtr &&project)
+{
+    // The previous project may outlive the scheduler and its shared caches
+    if (_project && _project->master())
+        UnbindCaches(*_project->master());
+    _project = std::move(project);
+    setDirtyFlags();
+}
+
 template<typename Apply>
-inline void Audio::AScheduler::addEvent(Apply &&apply)
+inline void Audio::AScheduler::addEditEvent(const Beat editBeat, Apply &&apply)
 {
-    if (!_hasExitedGraph)
+    if (!_hasExitedGraph) {
+        invalidateRenderAhead(editBeat);
         _events.push(Event {
             std::forward<Apply>(apply),
             NotifyFunctor()
         });
-    else {
+    } else {
         apply();
     }
 }
 
 template<typename Apply, typename Notify>
-inline void Audio::AScheduler::addEvent(Apply &&apply, Notify &&notify)
+inline void Audio::AScheduler::addEditEvent(const Beat editBeat, Apply &&apply, Notify &&notify)
 {
-    if (!_hasExitedGraph)
+    if (!_hasExitedGraph) {
+        invalidateRenderAhead(editBeat);
         _events.push(Event {
             std::forward<Apply>(apply),
             std::forward<Notify>(notify)
         });
-    else {
+    } else {
         apply();
         notify();
     }
@@ -107,6 +118,13 @@ inline void Audio::AScheduler::invalidateCurrentGraph(void)
     }
 }
 
+inline void Audio::AScheduler::invalidateRenderAhead(const Beat from) noexcept
+{
+    auto expected = _renderAheadInvalidBeat.load();
+
+    while (from < expected && !_renderAheadInvalidBeat.compare_exchange_weak(expected, from));
+}
+
 inline void Audio::AScheduler::setDirtyFlags(void) noexcept
 {
     _dirtyFlags.fill(true);
@@ -139,12 +157,41 @@ inline void Audio::AScheduler::scheduleCurrentGraph(void)
 {
     _hasExitedGraph = false;
     onAudioProcessStarted(getCurrentBeatRange());
+    _hasConsumedEventsOnTheFly.store(false, std::memory_order_relaxed);
+    beginPreviewCache(false);
+    _renderAheadInvalidBeat = RenderAheadValidBeat;
+    _AudioQueue.setDepth(RenderAheadMinBlockCount);
     _scheduler->schedule(getCurrentGraph());
 }
 
 inline void Audio::AScheduler::prepareCache(const AudioSpecs &specs)
 {
+    const auto blockByteSize = GetFormatByteLength(specs.format) * specs.processBlockSize;
+
+    // Map the arena before the caches and the pool are allocated, it is kept once mapped
+    const auto backing = Internal::BufferAllocator::InitArena(_bufferArenaConfig);
+    if (_bufferArenaConfig.byteSize && backing == Internal::BufferAllocator::ArenaBacking::None)
+        std::cout << "AScheduler::prepareCache: Couldn't map the buffer arena, buffers are allocated by the system" << std::endl;
+    else if (_bufferArenaConfig.lockMemory && !Internal::BufferAllocator::IsArenaLocked())
+        std::cout << "AScheduler::prepareCache: Couldn't lock the buffer arena in memory" << std::endl;
+    // Shared caches are prepared first, lane caches copy the specs of their node cache
+    for (auto &cache : _sharedCaches)
+        cache->resize(blockByteSize, specs.sampleRate, specs.channelArrangement, specs.format);
     _project->master()->prepareCache(specs);
+    // Pre-warm the pool so the graph build and the processing don't reach the system allocator
+    Internal::BufferAllocator::Reserve(
+        blockByteSize * static_cast<std::size_t>(specs.channelArrangement),
+        PreWarmBlockCount + CountMissingLaneCaches(*_project->master())
+    );
+    const auto renderAheadBlockCount = static_cast<std::size_t>(std::ceil(_renderAheadDuration * specs.sampleRate / std::max(specs.processBlockSize, 1u)));
+
+    _AudioQueue.prepare(
+        std::max({ AudioBlockQueue::DefaultBlockCount, RenderAheadMinBlockCount, renderAheadBlockCount }),
+        blockByteSize,
+        specs.sampleRate,
+        specs.channelArrangement,
+        specs.format
+    );
 }
 
 inline void Audio::AScheduler::onAudioProcessStarted(const BeatRange &beatRange)
@@ -152,43 +199,32 @@ inline void Audio::AScheduler::onAudioProcessStarted(const BeatRange &beatRange)
     _project->onAudioGenerationStarted(beatRange);
 }
 
-inline bool Audio::AScheduler::produceAudioData(const BufferView output)
+inline bool Audio::AScheduler::produceAudioData(Buffer &output)
 {
-    const bool ok = _AudioQueue.tryPushRange(
-        output.byteData(),
-        output.byteData() + output.size<std::uint8_t>() - _processLoopCrop * sizeof(float)
-    );
-
-    if (!ok) {
-        _overflowCache.copy(output);
-        // std::cout << " - produce audio failed\n";
+    if (!_AudioQueue.tryPush(output, output.size<std::uint8_t>() - _processLoopCrop * sizeof(float) * output.channelCount(), getCurrentBeatRange(), _beatMissCount)) {
+        _hasOverflowBlock = true;
         return false;
-    } else {
-       _processLoopCrop = 0u;
-        // std::cout << " - produce audio success\n";
-        return true;
     }
+    _processLoopCrop = 0u;
+    return true;
 }
 
 inline bool Audio::AScheduler::flushOverflowCache(void)
 {
-    const auto res = _AudioQueue.tryPushRange(
-        _overflowCache.byteData(),
-        _overflowCache.byteData() + _overflowCache.size<std::uint8_t>() - _processLoopCrop * sizeof(float)
-    );
-    if (res)
-        _processLoopCrop = 0u;
-    return res;
+    if (!produceAudioData(_project->master()->cache()))
+        return false;
+    _hasOverflowBlock = false;
+    return true;
 }
 
 inline void Audio::AScheduler::clearAudioQueue(void)
 {
-    _overflowCache.release();
+    _AudioQueue.clear();
 }
 
 inline void Audio::AScheduler::clearOverflowCache(void)
 {
-    _AudioQueue.clear();
+    _hasOverflowBlock = false;
 }
 
 template<Audio::PlaybackMode Playback>
@@ -205,23 +241,27 @@ inline void Audio::AScheduler::buildGraph(void)
 
     auto &graph = this->graph<Playback>();
     auto conditional = graph.emplace([this] {
-        if (_overflowCache) {
+        if (_hasOverflowBlock) {
             // The delayed data has been consumed
             if (flushOverflowCache()) {
-                _overflowCache.release();
                 return true;
             // The delayed data must be re-delayed
             } else {
                 return false;
             }
-        // There is no data delayed
-        } else
+        // There is no data delayed, the block may be replayed from the preview cache
+        } else if constexpr (Playback == PlaybackMode::Partition)
+            return !replayPreviewCache();
+        else
             return true;
     });
+    CacheAllocator cacheAllocator;
     auto noteTask = MakeSchedulerTask<Playback, true, false>(graph, parent->flags(), this, parent, nullptr);
     noteTask.first.setName(parent->name() + "_control_note");
     auto audioTask = MakeSchedulerTask<Playback, false, true>(graph, parent->flags(), this, parent, nullptr);
     audioTask.first.setName(parent->name() + "_audio");
+    const auto noteStep = cacheAllocator.addStep();
+    auto audioStep = cacheAllocator.addStep();
 
     auto overflowTask = graph.emplace([]{
         std::this_thread::sleep_for(std::chrono::nanoseconds(5000));
@@ -231,46 +271,184 @@ inline void Audio::AScheduler::buildGraph(void)
     // If master is the only node, connect his tasks
     if (parent->children().empty()) {
         noteTask.first.precede(audioTask.first);
-        if (!parent->parent())
-            return;
-    } else {
-        for (auto &child : parent->children()) {
-            buildNodeTask<Playback>(child.get(), noteTask, audioTask);
-        }
-    }
+        cacheAllocator.precede(noteStep, audioStep);
+    } else
+        buildChildrenTasks<Playback>(parent, noteTask, audioTask, cacheAllocator, noteStep, audioStep);
     if constexpr (Playback == PlaybackMode::Partition || Playback == PlaybackMode::OnTheFly) {
+        Node *child = parent;
         parent = parent->parent();
         while (parent) {
-            auto parentAudioTask = MakeSchedulerTask<Playback, false, true>(graph, parent->flags(), this, parent, nullptr);
+            // Only the partition branch is rendered, the parents collect its cache
+            auto parentAudioTask = MakeSchedulerTask<Playback, false, true>(graph, parent->flags(), this, parent, nullptr, nullptr, false, child);
             parentAudioTask.first.setName(parent->name() + "_audio");
             parentAudioTask.first.succeed(audioTask.first);
+            const auto parentAudioStep = cacheAllocator.addStep();
+            cacheAllocator.precede(audioStep, parentAudioStep);
+            cacheAllocator.addCache(child, audioStep, parentAudioStep);
             audioTask = parentAudioTask;
+            audioStep = parentAudioStep;
+            child = parent;
             parent = parent->parent();
         }
     }
+
+    // Share node caches whose lifetimes never overlap, a master rooted graph rebinds every node
+    auto &master = *_project->master();
+    cacheAllocator.allocate(_sharedCaches, master.cache(), Playback == PlaybackMode::Production || Playback == PlaybackMode::Live);
+    // Other graphs must be rebuilt to match the new bindings
+    for (auto i = 0u; i < Audio::PlaybackModeCount; ++i)
+        _dirtyFlags[i] |= i != static_cast<std::size_t>(Playback);
 }
 
 template<Audio::PlaybackMode Playback>
-inline void Audio::AScheduler::buildNodeTask(const Node *node,
-        std::pair<Flow::Task, const NoteEvents *> &parentNoteTask, std::pair<Flow::Task, const NoteEvents *> &parentAudioTask)
+inline void Audio::AScheduler::buildNodeTask(Node *node,
+        std::pair<Flow::Task, const NoteEvents *> &parentNoteTask, std::pair<Flow::Task, const NoteEvents *> &parentAudioTask,
+        CacheAllocator &cacheAllocator, const CacheAllocator::Step parentNoteStep, const CacheAllocator::Step parentAudioStep)
 {
     if (node->children().empty()) {
-        auto task = MakeSchedulerTask<Playback, true, true>(graph<Playback>(), node->flags(), this, const_cast<Node *>(node), parentNoteTask.second);
+        auto task = MakeSchedulerTask<Playback, true, true>(graph<Playback>(), node->flags(), this, node, parentNoteTask.second);
         task.first.setName(node->name().toStdString() + "_control_note_audio");
         task.first.succeed(parentNoteTask.first);
         task.first.precede(parentAudioTask.first);
+        const auto step = cacheAllocator.addStep();
+        cacheAllocator.precede(parentNoteStep, step);
+        cacheAllocator.precede(step, parentAudioStep);
+        cacheAllocator.addCache(node, step, parentAudioStep);
+        return;
+    }
+    // A chain can't run in parallel, its tasks are fused to spare their scheduling
+    if (_taskFusion && IsTaskChain(*node)) {
+        auto task = buildTaskChain<Playback>(node, parentNoteTask.second, cacheAllocator, parentNoteStep, parentAudioStep);
+        task.setName(node->name().toStdString() + "_chain");
+        task.succeed(parentNoteTask.first);
+        task.precede(parentAudioTask.first);
         return;
     }
-    auto noteTask = MakeSchedulerTask<Playback, true, false>(graph<Playback>(), node->flags(), this, const_cast<Node *>(node), parentNoteTask.second);
+    auto noteTask = MakeSchedulerTask<Playback, true, false>(graph<Playback>(), node->flags(), this, node, parentNoteTask.second);
     noteTask.first.setName(node->name().toStdString() + "_control_note");
-    auto audioTask = MakeSchedulerTask<Playback, false, true>(graph<Playback>(), node->flags(), this, const_cast<Node *>(node), parentNoteTask.second);
+    auto audioTask = MakeSchedulerTask<Playback, false, true>(graph<Playback>(), node->flags(), this, node, parentNoteTask.second);
     audioTask.first.setName(node->name().toStdString() + "_audio");
     noteTask.first.succeed(parentNoteTask.first);
+    const auto noteStep = cacheAllocator.addStep();
+    const auto audioStep = cacheAllocator.addStep();
+    cacheAllocator.precede(parentNoteStep, noteStep);
 
+    buildChildrenTasks<Playback>(node, noteTask, audioTask, cacheAllocator, noteStep, audioStep);
+    audioTask.first.precede(parentAudioTask.first);
+    cacheAllocator.precede(audioStep, parentAudioStep);
+    cacheAllocator.addCache(node, audioStep, parentAudioStep);
+}
+
+inline void Audio::AScheduler::UnbindCaches(Node &node)
+{
+    node.bindCache(nullptr);
+    for (auto &child : node.children())
+        UnbindCaches(*child);
+}
+
+inline std::size_t Audio::AScheduler::CountMissingLaneCaches(const Node &node) noexcept
+{
+    std::size_t leafCount = 0u;
+    std::size_t count = 0u;
+
+    for (auto &child : node.children()) {
+        leafCount += child->canAccumulateIntoParent();
+        count += CountMissingLaneCaches(*child);
+    }
+    if (const auto laneCount = std::min(leafCount, AccumulationLaneCount); laneCount > node.laneCaches().size())
+        count += laneCount - node.laneCaches().size();
+    return count;
+}
+
+inline bool Audio::AScheduler::IsTaskChain(const Node &node) noexcept
+{
+    const Node *current = &node;
+
+    while (current->children().size() == 1u)
+        current = current->children()[0].get();
+    return current->children().empty();
+}
+
+template<Audio::PlaybackMode Playback>
+inline Flow::Task Audio::AScheduler::buildTaskChain(Node *node, const NoteEvents * const parentNoteStack,
+        CacheAllocator &cacheAllocator, const CacheAllocator::Step parentNoteStep, const CacheAllocator::Step parentAudioStep)
+{
+    SchedulerTaskChain chain;
+    const auto push = [&chain](auto &&schedulerTask) {
+        const auto noteStack = schedulerTask.noteStack();
+        chain.push(std::move(schedulerTask));
+        return noteStack;
+    };
+    const NoteEvents *noteStack = parentNoteStack;
+    Node *current = node;
+    // Each fused task is recorded as a step following the previous one
+    auto step = parentNoteStep;
+    const auto nextStep = [&cacheAllocator, &step] {
+        const auto next = cacheAllocator.addStep();
+        cacheAllocator.precede(step, next);
+        return step = next;
+    };
+
+    // Each node of the chain has a single child, which renders into its own cache
+    for (; !current->children().empty(); current = current->children()[0].get()) {
+        current->prepareLaneCaches(0u);
+        noteStack = DeduceSchedulerTask<Playback, true, false>(push, current->flags(), this, current, noteStack);
+        UNUSED(nextStep());
+    }
+    UNUSED(DeduceSchedulerTask<Playback, true, true>(push, current->flags(), this, current, noteStack));
+    auto producer = nextStep();
+    while (current != node) {
+        Node * const child = current;
+        current = current->parent();
+        UNUSED(DeduceSchedulerTask<Playback, false, true>(push, current->flags(), this, current, nullptr, nullptr, false, child));
+        cacheAllocator.addCache(child, producer, nextStep());
+        producer = step;
+    }
+    cacheAllocator.precede(step, parentAudioStep);
+    cacheAllocator.addCache(node, producer, parentAudioStep);
+    return graph<Playback>().emplace(std::move(chain));
+}
+
+template<Audio::PlaybackMode Playback>
+inline void Audio::AScheduler::buildChildrenTasks(Node *node,
+        std::pair<Flow::Task, const NoteEvents *> &noteTask, std::pair<Flow::Task, const NoteEvents *> &audioTask,
+        CacheAllocator &cacheAllocator, const CacheAllocator::Step noteStep, const CacheAllocator::Step audioStep)
+{
+    std::size_t leafCount = 0u;
+    for (auto &child : node->children())
+        leafCount += child->canAccumulateIntoParent();
+    const auto laneCount = std::min(leafCount, AccumulationLaneCount);
+    node->prepareLaneCaches(laneCount);
+
+    std::array<Flow::Task, AccumulationLaneCount> laneTails {};
+    std::array<CacheAllocator::Step, AccumulationLaneCount> laneTailSteps {};
+    std::size_t leafIndex = 0u;
     for (auto &child : node->children()) {
-        buildNodeTask<Playback>(child.get(), noteTask, audioTask);
+        if (!child->canAccumulateIntoParent()) {
+            buildNodeTask<Playback>(child.get(), noteTask, audioTask, cacheAllocator, noteStep, audioStep);
+            continue;
+        }
+        // The first task of a lane clears it, the following ones accumulate after it
+        const auto lane = leafIndex % laneCount;
+        const bool first = leafIndex < laneCount;
+        auto task = MakeSchedulerTask<Playback, true, true>(graph<Playback>(), child->flags(), this, child.get(), noteTask.second,
+                &node->laneCaches().at(lane), first);
+        task.first.setName(child->name().toStdString() + "_control_note_audio_lane");
+        task.first.succeed(noteTask.first);
+        const auto step = cacheAllocator.addStep();
+        cacheAllocator.precede(noteStep, step);
+        if (!first) {
+            task.first.succeed(laneTails[lane]);
+            cacheAllocator.precede(laneTailSteps[lane], step);
+        }
+        task.first.precede(audioTask.first);
+        cacheAllocator.precede(step, audioStep);
+        // The own cache of an accumulating node is only used by its task, when the node is muted
+        cacheAllocator.addCache(child.get(), step);
+        laneTails[lane] = task.first;
+        laneTailSteps[lane] = step;
+        ++leafIndex;
     }
-    audioTask.first.precede(parentAudioTask.first);
 }
 
 inline Audio::Beat Audio::AScheduler::ComputeBeatSize(const BlockSize blockSize, const Tempo tempo, const SampleRate sampleRate, double &beatMissOffset) noexcept
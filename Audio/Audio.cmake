@@ -7,7 +7,10 @@ get_filename_component(AudioDir ${CMAKE_CURRENT_LIST_FILE} PATH)
 
 set(AudioPrecompiledHeaders
     ${AudioDir}/AScheduler.hpp
+    ${AudioDir}/AudioBlockQueue.hpp
     ${AudioDir}/SchedulerTask.hpp
+    ${AudioDir}/SchedulerTaskChain.hpp
+    ${AudioDir}/CacheAllocator.hpp
     ${AudioDir}/Automation.hpp
     ${AudioDir}/Base.hpp
     ${AudioDir}/BaseVolume.hpp
@@ -15,6 +18,7 @@ set(AudioPrecompiledHeaders
     ${AudioDir}/BaseIndex.hpp
     ${AudioDir}/Math.hpp
     ${AudioDir}/Buffer.hpp
+    ${AudioDir}/BufferArena.hpp
     ${AudioDir}/Modifier.hpp
     ${AudioDir}/BufferOctave.hpp
     ${AudioDir}/Connection.hpp
@@ -31,6 +35,7 @@ set(AudioPrecompiledHeaders
     ${AudioDir}/Note.hpp
     ${AudioDir}/Partitions.hpp
     ${AudioDir}/Partition.hpp
+    ${AudioDir}/PreviewCache.hpp
     ${AudioDir}/PluginPtr.hpp
     ${AudioDir}/PluginTable.hpp
     ${AudioDir}/PluginUtils.hpp
@@ -49,10 +54,14 @@ set(AudioSources
     ${AudioDir}/PluginUtilsControlsVolume.hpp
     ${AudioDir}/AScheduler.ipp
     ${AudioDir}/AScheduler.cpp
+    ${AudioDir}/AudioBlockQueue.ipp
     ${AudioDir}/SchedulerTask.ipp
+    ${AudioDir}/SchedulerTaskChain.ipp
+    ${AudioDir}/CacheAllocator.cpp
     ${AudioDir}/BaseIndex.cpp
     ${AudioDir}/Buffer.ipp
     ${AudioDir}/Buffer.cpp
+    ${AudioDir}/BufferArena.cpp
     ${AudioDir}/ParameterTable.cpp
     ${AudioDir}/Device.cpp
     ${AudioDir}/Node.ipp
@@ -61,6 +70,7 @@ set(AudioSources
     ${AudioDir}/PluginPtr.ipp
     ${AudioDir}/PluginTable.cpp
     ${AudioDir}/PluginTable.ipp
+    ${AudioDir}/PreviewCache.ipp
     ${AudioDir}/Project.ipp
     ${AudioDir}/Volume.ipp
 )
@@ -87,6 +97,10 @@ set(AudioPluginsSources
     ${AudioPluginsDir}/SigmaFilter.ipp
     ${AudioPluginsDir}/GammaEqualizer.hpp
     ${AudioPluginsDir}/GammaEqualizer.ipp
+    ${AudioPluginsDir}/GraphicEqualizer.hpp
+    ${AudioPluginsDir}/GraphicEqualizer.ipp
+    ${AudioPluginsDir}/ParametricEqualizer.hpp
+    ${AudioPluginsDir}/ParametricEqualizer.ipp
     ${AudioPluginsDir}/SimpleDelay.hpp
     ${AudioPluginsDir}/SimpleDelay.ipp
     ${AudioPluginsDir}/Arpeggiator.hpp
@@ -115,6 +129,9 @@ set(AudioPluginManagersSources
     ${AudioSampleFileDir}/SampleManagerWAV.hpp
     ${AudioSampleFileDir}/SampleManagerWAV.cpp
     ${AudioSampleFileDir}/SampleManagerWAV.ipp
+    ${AudioSampleFileDir}/SampleStore.hpp
+    ${AudioSampleFileDir}/SampleStore.ipp
+    ${AudioSampleFileDir}/SampleStore.cpp
 )
 
 
@@ -123,12 +140,25 @@ set(AudioDSPDir ${AudioDir}/DSP)
 set(AudioDSPSources
     ${AudioDSPDir}/Merge.hpp
     ${AudioDSPDir}/Merge.ipp
+    ${AudioDSPDir}/Simd.hpp
+    ${AudioDSPDir}/SimdKernels.hpp
+    ${AudioDSPDir}/SimdKernelsScalar.cpp
+    ${AudioDSPDir}/SimdKernelsSSE2.cpp
+    ${AudioDSPDir}/SimdKernelsAVX2.cpp
+    ${AudioDSPDir}/SimdKernelsAVX512.cpp
+    ${AudioDSPDir}/SimdKernelsNEON.cpp
+    ${AudioDSPDir}/Dispatch.hpp
+    ${AudioDSPDir}/Dispatch.cpp
     ${AudioDSPDir}/Converter.hpp
     ${AudioDSPDir}/Converter.ipp
     ${AudioDSPDir}/Reformater.hpp
     ${AudioDSPDir}/Reformater.ipp
     ${AudioDSPDir}/Resampler.hpp
     ${AudioDSPDir}/Resampler.ipp
+    ${AudioDSPDir}/SincResampler.hpp
+    ${AudioDSPDir}/SincResampler.ipp
+    ${AudioDSPDir}/Wavetable.hpp
+    ${AudioDSPDir}/Wavetable.ipp
     ${AudioDSPDir}/Interpolation.ipp
     ${AudioDSPDir}/Decimation.ipp
     ${AudioDSPDir}/Biquad.hpp
@@ -136,6 +166,10 @@ set(AudioDSPSources
     ${AudioDSPDir}/Biquad.cpp
     ${AudioDSPDir}/EnvelopeGenerator.hpp
     ${AudioDSPDir}/EnvelopeGenerator.ipp
+    ${AudioDSPDir}/FFT.hpp
+    ${AudioDSPDir}/FFT.ipp
+    ${AudioDSPDir}/Convolution.hpp
+    ${AudioDSPDir}/Convolution.ipp
     ${AudioDSPDir}/FIR.hpp
     ${AudioDSPDir}/FM.hpp
     ${AudioDSPDir}/FMGenerator.hpp
@@ -145,6 +179,8 @@ set(AudioDSPSources
     ${AudioDSPDir}/FIRFilter.ipp
     ${AudioDSPDir}/Filter.hpp
     ${AudioDSPDir}/Filter.ipp
+    ${AudioDSPDir}/FilterDesigner.hpp
+    ${AudioDSPDir}/FilterDesigner.cpp
     ${AudioDSPDir}/Window.ipp
     ${AudioDSPDir}/Filter.hpp
     ${AudioDSPDir}/Delay.hpp
@@ -160,6 +196,29 @@ add_library(${PROJECT_NAME}
 
 target_precompile_headers(${PROJECT_NAME} PUBLIC ${AudioPrecompiledHeaders})
 
+# Each kernel unit is built with its own instruction set, the host CPU selects one of them at runtime
+set(AudioSimdKernelsSources
+    ${AudioDSPDir}/SimdKernelsSSE2.cpp
+    ${AudioDSPDir}/SimdKernelsAVX2.cpp
+    ${AudioDSPDir}/SimdKernelsAVX512.cpp
+)
+set_source_files_properties(${AudioSimdKernelsSources} PROPERTIES SKIP_PRECOMPILE_HEADERS ON)
+if(CMAKE_SYSTEM_PROCESSOR MATCHES "x86_64|AMD64|amd64|i.86|x86")
+    if(MSVC)
+        set_source_files_properties(${AudioDSPDir}/SimdKernelsAVX2.cpp PROPERTIES COMPILE_OPTIONS "/arch:AVX2")
+        set_source_files_properties(${AudioDSPDir}/SimdKernelsAVX512.cpp PROPERTIES COMPILE_OPTIONS "/arch:AVX512")
+    else()
+        set_source_files_properties(${AudioDSPDir}/SimdKernelsSSE2.cpp PROPERTIES COMPILE_OPTIONS "-msse2")
+        set_source_files_properties(${AudioDSPDir}/SimdKernelsAVX2.cpp PROPERTIES COMPILE_OPTIONS "-mavx2;-mfma")
+        set_source_files_properties(${AudioDSPDir}/SimdKernelsAVX512.cpp PROPERTIES COMPILE_OPTIONS "-mavx512f")
+    endif()
+endif()
+# Products and sums are never fused into FMA instructions, so every kernel unit rounds as the scalar one
+if(NOT MSVC)
+    set_property(SOURCE ${AudioSimdKernelsSources} ${AudioDSPDir}/SimdKernelsScalar.cpp ${AudioDSPDir}/SimdKernelsNEON.cpp
+        APPEND PROPERTY COMPILE_OPTIONS "-ffp-contract=off")
+endif()
+
 target_include_directories(${PROJECT_NAME} PUBLIC ${AudioDir}/..)
 
 target_link_libraries(${PROJECT_NAME} PUBLIC Core Flow)
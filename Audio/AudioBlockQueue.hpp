@@ -0,0 +1,88 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: AudioBlockQueue
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+
+#include <Core/Vector.hpp>
+
+#include "Buffer.hpp"
+
+namespace Audio
+{
+    class AudioBlockQueue;
+}
+
+/** @brief Single producer / single consumer queue of pre-allocated audio blocks
+ *  The producer hands a rendered block over by swapping it with a free slot, no sample is copied.
+ *  The consumer reads directly from the queued blocks into the device stream, interleaving their planar channels */
+class Audio::AudioBlockQueue
+{
+public:
+    /** @brief Default number of queued blocks */
+    static constexpr std::size_t DefaultBlockCount = 8u;
+
+    /** @brief A queued block */
+    struct Block
+    {
+        Buffer buffer {};
+        std::size_t size { 0u };
+        BeatRange nextRange {}; // Producer state following the block, used to resume after a retract
+        double nextBeatMissCount { 0.0 };
+    };
+
+    /** @brief List of blocks */
+    using Blocks = Core::TinyVector<Block>;
+
+
+    /** @brief Default constructor */
+    AudioBlockQueue(void) noexcept = default;
+
+    /** @brief Pre-allocate every block of the queue (must not be called while the queue is used) */
+    void prepare(const std::size_t blockCount, const std::size_t channelByteSize, const SampleRate sampleRate, const ChannelArrangement channelArrangement, const Format format);
+
+    /** @brief Get the number of slots */
+    [[nodiscard]] std::size_t blockCount(void) const noexcept { return _blocks.size(); }
+
+    /** @brief Get / Set the maximum number of blocks queued ahead of the consumer (producer only) */
+    [[nodiscard]] std::size_t depth(void) const noexcept { return _depth; }
+    void setDepth(const std::size_t depth) noexcept { _depth = std::min(std::max<std::size_t>(depth, 1u), _blocks.size()); }
+
+
+    /** @brief Try to hand over the first 'size' bytes of a block, swapping it with a free slot
+     *  The block must fit in the prepared slots, nothing is pushed otherwise
+     *  On success, 'block' holds an already consumed buffer of the same capacity */
+    [[nodiscard]] bool tryPush(Buffer &block, const std::size_t size, const BeatRange &nextRange = {}, const double nextBeatMissCount = 0.0) noexcept;
+
+    /** @brief Try to read 'size' bytes from the queued blocks, nothing is read if not enough data is available
+     *  Never waits: fails as well if a concurrent retract dropped the blocks to read */
+    [[nodiscard]] bool tryPop(std::uint8_t * const data, const std::size_t size) noexcept;
+
+    /** @brief Drop the queued blocks starting at the first one that fails 'isValid', the first 'minCount' blocks are always kept
+     *  Fails if the consumer is reading a block to drop or already read past the blocks to keep, nothing is dropped in this case
+     *  @param lastKept Set to the last block kept in the queue if some blocks were dropped, else nullptr
+     *  @return false if the consumer was reading */
+    template<typename Predicate>
+    [[nodiscard]] bool tryRetract(const std::size_t minCount, Predicate &&isValid, const Block *&lastKept) noexcept;
+
+    /** @brief Drop every queued block (must not be called while the queue is used) */
+    void clear(void) noexcept;
+
+private:
+    alignas_cacheline std::atomic<std::size_t> _head { 0u }; // Written by the producer
+    alignas_cacheline std::atomic<std::size_t> _tail { 0u }; // Written by the consumer
+    std::size_t _readOffset { 0u }; // Consumer offset into the tail block
+    alignas_cacheline std::atomic<std::size_t> _reserved { 0u }; // End of the blocks being read by the consumer, 0 if none
+    alignas_cacheline Blocks _blocks {};
+    std::size_t _depth { 0u };
+
+    /** @brief Read 'size' bytes of the device stream from a block, starting at 'offset'
+     *  Planar channels are interleaved on the fly */
+    static void ReadBlock(const Buffer &buffer, const std::size_t offset, std::uint8_t * const data, const std::size_t size) noexcept;
+};
+
+#include "AudioBlockQueue.ipp"
@@ -0,0 +1,144 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: AudioBlockQueue implementation
+ */
+
+#include <cstring>
+#include <type_traits>
+
+#include "DSP/Reformater.hpp"
+
+inline void Audio::AudioBlockQueue::prepare(const std::size_t blockCount, const std::size_t channelByteSize,
+        const SampleRate sampleRate, const ChannelArrangement channelArrangement, const Format format)
+{
+    clear();
+    _blocks.resize(blockCount);
+    for (auto &block : _blocks)
+        block.buffer.resize(channelByteSize, sampleRate, channelArrangement, format);
+    _depth = blockCount;
+}
+
+inline bool Audio::AudioBlockQueue::tryPush(Buffer &block, const std::size_t size, const BeatRange &nextRange, const double nextBeatMissCount) noexcept
+{
+    const auto count = _blocks.size();
+    const auto head = _head.load(std::memory_order_relaxed);
+
+    if (!count || head - _tail.load(std::memory_order_acquire) >= _depth)
+        return false;
+    auto &slot = _blocks[head % count];
+    // Blocks share the same specs, the rendered buffer is swapped instead of copied
+    if (!slot.buffer || slot.buffer.capacity() < block.size<std::uint8_t>())
+        return false;
+    std::swap(slot.buffer, block);
+    slot.size = std::min(size, slot.buffer.size<std::uint8_t>());
+    slot.nextRange = nextRange;
+    slot.nextBeatMissCount = nextBeatMissCount;
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+inline bool Audio::AudioBlockQueue::tryPop(std::uint8_t * const data, const std::size_t size) noexcept
+{
+    const auto count = _blocks.size();
+    const auto head = _head.load(std::memory_order_acquire);
+    auto tail = _tail.load(std::memory_order_relaxed);
+
+    // A failing retract may lower the head under the tail until it restores it
+    if (head < tail)
+        return false;
+    // Ensure that enough data is available
+    std::size_t available = 0u;
+    auto end = tail;
+    for (; end != head && available < size + _readOffset; ++end)
+        available += _blocks[end % count].size;
+    if (available < size + _readOffset)
+        return false;
+
+    // Reserve the blocks to read then check that no retract dropped them meanwhile, the reader never waits for the producer
+    _reserved.store(end);
+    if (_head.load() < end) {
+        _reserved.store(0u, std::memory_order_release);
+        return false;
+    }
+
+    // Read directly from the queued blocks
+    for (std::size_t read = 0u; read != size;) {
+        const auto &block = _blocks[tail % count];
+        const auto chunk = std::min(block.size - _readOffset, size - read);
+        ReadBlock(block.buffer, _readOffset, data + read, chunk);
+        read += chunk;
+        _readOffset += chunk;
+        if (_readOffset == block.size) {
+            _readOffset = 0u;
+            _tail.store(++tail, std::memory_order_release);
+        }
+    }
+    _reserved.store(0u, std::memory_order_release);
+    return true;
+}
+
+inline void Audio::AudioBlockQueue::ReadBlock(const Buffer &buffer, const std::size_t offset, std::uint8_t * const data, const std::size_t size) noexcept
+{
+    if (buffer.isSilent()) {
+        std::memset(data, 0, size);
+        return;
+    }
+    const auto channelCount = buffer.channelCount();
+    if (channelCount == 1u) {
+        std::memcpy(data, buffer.byteData() + offset, size);
+        return;
+    }
+    // Planar channels are interleaved frame by frame into the device stream
+    const auto sampleByteSize = GetFormatByteLength(buffer.format());
+    const auto frameByteSize = sampleByteSize * channelCount;
+    const auto frameOffset = offset / frameByteSize;
+    const auto frameCount = size / frameByteSize;
+    const auto channelStride = buffer.channelByteSize() / sampleByteSize;
+    const auto interleave = [&](auto * const output) {
+        using Type = std::remove_const_t<std::remove_pointer_t<decltype(output)>>;
+        DSP::Reformater::Interleave(buffer.data<Type>() + frameOffset, output, frameCount, channelCount, channelStride);
+    };
+    switch (sampleByteSize) {
+    case 1u:
+        return interleave(reinterpret_cast<std::uint8_t *>(data));
+    case 2u:
+        return interleave(reinterpret_cast<std::uint16_t *>(data));
+    case 8u:
+        return interleave(reinterpret_cast<std::uint64_t *>(data));
+    default:
+        return interleave(reinterpret_cast<std::uint32_t *>(data));
+    }
+}
+
+template<typename Predicate>
+inline bool Audio::AudioBlockQueue::tryRetract(const std::size_t minCount, Predicate &&isValid, const Block *&lastKept) noexcept
+{
+    lastKept = nullptr;
+    const auto count = _blocks.size();
+    const auto head = _head.load(std::memory_order_relaxed);
+    const auto tail = _tail.load(std::memory_order_acquire);
+    // The block being read is always kept, so is the one holding the state to resume from
+    auto index = tail + std::max<std::size_t>(minCount, 1u);
+
+    while (index < head && isValid(_blocks[index % count]))
+        ++index;
+    if (index >= head)
+        return true;
+    // Move the head back then restore it if the consumer reserved a dropped block, it either sees the new head or we see its reservation.
+    // A read completed since the tail was loaded may have consumed the kept blocks, its tail is visible once its reservation is released
+    _head.store(index);
+    if (_reserved.load() > index || _tail.load(std::memory_order_acquire) >= index) {
+        _head.store(head, std::memory_order_release);
+        return false;
+    }
+    lastKept = &_blocks[(index - 1) % count];
+    return true;
+}
+
+inline void Audio::AudioBlockQueue::clear(void) noexcept
+{
+    _head.store(0u, std::memory_order_relaxed);
+    _tail.store(0u, std::memory_order_relaxed);
+    _reserved.store(0u, std::memory_order_relaxed);
+    _readOffset = 0u;
+}
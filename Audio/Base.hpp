@@ -56,7 +56,7 @@ namespace Audio
     /** @brief Velocity of a note */
     using Velocity = std::uint16_t;
 
-    /** @brief Note pitch tuning */
+    /** @brief Note pitch tuning, signed offset in cents stored in two's complement */
     using Tuning = std::uint16_t;
 
     /** @brief Midi note channels */
@@ -89,6 +89,9 @@ namespace Audio
         Right
     };
 
+    /** @brief Maximum number of channels of an audio buffer */
+    constexpr std::size_t MaxChannelCount = static_cast<std::size_t>(ChannelArrangement::Stereo);
+
     /** @brief A sorted list of beat ranges */
     using BeatRanges = Core::SortedFlatVector<BeatRange>;
 
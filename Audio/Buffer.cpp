@@ -3,7 +3,9 @@
  * @ Description: Buffer
  */
 
+#include <algorithm>
 #include <bitset>
+#include <thread>
 
 #include "Buffer.hpp"
 
@@ -12,56 +14,63 @@ using namespace Audio;
 Internal::BufferAllocator Internal::BufferAllocator::_Instance {};
 
 
-Internal::AllocationHeader *Internal::BufferAllocator::allocate(
-        const std::size_t channelByteSize, const SampleRate sampleRate, const ChannelArrangement channelArrangement, const Format format) noexcept
+std::size_t Internal::BufferAllocator::GetBucketIndex(const std::size_t byteSize, std::size_t &capacity) noexcept
 {
-    const std::size_t usedSize = channelByteSize * static_cast<std::size_t>(channelArrangement);
-    std::size_t capacity = usedSize;
     std::size_t bucketIndex = 0u;
 
+    capacity = byteSize;
     // Check if the capacity is out of range
     if (capacity > MaxAllocationSize)
-        return AllocateFallback(channelByteSize, sampleRate, channelArrangement, format, usedSize, capacity, OutOfRangeAllocationPower);
+        return OutOfRangeAllocationPower;
     // Else, determines the real bucket capacity and index
+    if (capacity <= MinAllocationSize)
+        capacity = MinAllocationSize;
     else {
-        if (capacity <= MinAllocationSize)
-            capacity = MinAllocationSize;
-        else {
-            const std::bitset<64> capacityBit(capacity);
-            capacity >>= (MinAllocationPower + 1);
-            while (capacity != 0) {
-                capacity >>= 1;
-                ++bucketIndex;
-            }
-            if (capacityBit.count() > 1) {
-                capacity = (1ull << (bucketIndex + MinAllocationPower + 1));
-                bucketIndex++;
-            } else {
-                capacity = (1ull << (bucketIndex + MinAllocationPower));
-            }
+        const std::bitset<64> capacityBit(capacity);
+        capacity >>= (MinAllocationPower + 1);
+        while (capacity != 0) {
+            capacity >>= 1;
+            ++bucketIndex;
+        }
+        if (capacityBit.count() > 1) {
+            capacity = (1ull << (bucketIndex + MinAllocationPower + 1));
+            bucketIndex++;
+        } else {
+            capacity = (1ull << (bucketIndex + MinAllocationPower));
         }
     }
-        // std::cout << "final alloc: " << capacity << std::endl;
+    return bucketIndex;
+}
 
-    // Search if a bucket is available for a given size
-    auto &bucket = _buckets.at(bucketIndex);
-    AllocationHeader *expected, *desired;
-    while (true) {
-        expected = bucket.load();
-        if (!expected)
-            return AllocateFallback(channelByteSize, sampleRate, channelArrangement, format, usedSize, capacity, bucketIndex);
-        desired = expected->next;
-        if (bucket.compare_exchange_weak(expected, desired))
-            break;
+Internal::AllocationHeader *Internal::BufferAllocator::allocate(
+        const std::size_t channelByteSize, const SampleRate sampleRate, const ChannelArrangement channelArrangement, const Format format) noexcept
+{
+    const std::size_t usedSize = channelByteSize * static_cast<std::size_t>(channelArrangement);
+    std::size_t capacity;
+    const auto bucketIndex = GetBucketIndex(usedSize, capacity);
+
+    if (bucketIndex == OutOfRangeAllocationPower)
+        return AllocateFallback(channelByteSize, sampleRate, channelArrangement, format, usedSize, capacity, OutOfRangeAllocationPower);
+
+    // Take the most recently released allocation of the thread, refilling its magazine if needed
+    auto &magazine = LocalCache().magazines.at(bucketIndex);
+    if (!magazine.count && !refill(bucketIndex, magazine)) {
+        countFallback(bucketIndex);
+        return AllocateFallback(channelByteSize, sampleRate, channelArrangement, format, usedSize, capacity, bucketIndex);
     }
-    expected->size = usedSize;
-    expected->channelByteSize = channelByteSize;
-    expected->sampleRate = sampleRate;
-    expected->channelArrangement = channelArrangement;
-    expected->capacity = capacity;
-    expected->bucketIndex = bucketIndex;
-    expected->next = nullptr;
-    return expected;
+    ++magazine.hits;
+    auto * const header = magazine.headers[--magazine.count];
+    header->size = usedSize;
+    header->channelByteSize = channelByteSize;
+    header->sampleRate = sampleRate;
+    header->channelArrangement = channelArrangement;
+    header->format = format;
+    header->capacity = capacity;
+    header->bucketIndex = bucketIndex;
+    header->silent = false;
+    header->silenceMarked = false;
+    header->next = nullptr;
+    return header;
 }
 
 void Internal::BufferAllocator::deallocate(AllocationHeader * const header) noexcept
@@ -70,33 +79,208 @@ void Internal::BufferAllocator::deallocate(AllocationHeader * const header) noex
         Core::Utils::AlignedFree(header);
         return;
     }
-    auto &bucket = _buckets.at(header->bucketIndex);
-    AllocationHeader *expected;
-    while (true) {
-        expected = bucket.load();
-        if (expected)
-            header->next = expected;
-        else
-            header->next = nullptr;
-        if (bucket.compare_exchange_weak(expected, header))
+    auto &magazine = LocalCache().magazines.at(header->bucketIndex);
+    if (magazine.count == MagazineCapacity)
+        flush(header->bucketIndex, magazine, MagazineBatchSize);
+    magazine.headers[magazine.count++] = header;
+}
+
+void Internal::BufferAllocator::clear(void) noexcept
+{
+    flushLocalCache();
+    trim(0u);
+}
+
+void Internal::BufferAllocator::flushLocalCache(void) noexcept
+{
+    auto &cache = LocalCache();
+
+    for (auto i = 0u; i < AllocationPowerRange; ++i)
+        flush(i, cache.magazines[i], cache.magazines[i].count);
+}
+
+void Internal::BufferAllocator::reserve(const std::size_t byteSize, const std::size_t count) noexcept
+{
+    std::size_t capacity;
+    const auto bucketIndex = GetBucketIndex(byteSize, capacity);
+
+    if (bucketIndex == OutOfRangeAllocationPower)
+        return;
+    const auto retained = _counters[bucketIndex].retained.load(std::memory_order_relaxed);
+    if (retained >= count)
+        return;
+    AllocationHeader *first = nullptr, *last = nullptr;
+    std::size_t allocated = 0u;
+    for (; allocated < count - retained; ++allocated) {
+        auto * const header = AllocateFallback(byteSize, 0u, ChannelArrangement::Mono, Format::Fixed8, byteSize, capacity, bucketIndex);
+        if (!header)
             break;
+        countFallback(bucketIndex);
+        header->next = first;
+        first = header;
+        if (!last)
+            last = header;
     }
+    if (allocated)
+        pushList(bucketIndex, first, last, allocated);
 }
 
-void Internal::BufferAllocator::clear(void) noexcept
+Internal::BufferAllocator::BucketStats Internal::BufferAllocator::stats(const std::size_t bucketIndex) noexcept
+{
+    auto &counters = _counters.at(bucketIndex);
+    auto &magazine = LocalCache().magazines.at(bucketIndex);
+    BucketStats stats;
+
+    counters.hits.fetch_add(magazine.hits, std::memory_order_relaxed);
+    magazine.hits = 0u;
+    stats.capacity = 1ull << (bucketIndex + MinAllocationPower);
+    stats.hits = counters.hits.load(std::memory_order_relaxed);
+    stats.fallbacks = counters.fallbacks.load(std::memory_order_relaxed);
+    stats.allocatedCount = counters.allocated.load(std::memory_order_relaxed);
+    stats.highWaterCount = counters.highWater.load(std::memory_order_relaxed);
+    stats.retainedCount = counters.retained.load(std::memory_order_relaxed);
+    stats.retainedBytes = stats.retainedCount * (stats.capacity + Core::CacheLineSize);
+    return stats;
+}
+
+std::size_t Internal::BufferAllocator::trim(const std::size_t keepCount, const bool dropArena) noexcept
+{
+    std::size_t released = 0u;
+
+    for (auto i = 0u; i < AllocationPowerRange; ++i) {
+        auto &bucket = _buckets[i];
+        auto &counters = _counters[i];
+        // Detach the whole list, allocations requested meanwhile fall back to the system
+        auto head = bucket.load();
+        while (!bucket.compare_exchange_weak(head, NextHead(head, nullptr)));
+        if (!HeadPointer(head))
+            continue;
+        // A refill that loaded the head before the detach may still be walking the list
+        while (_refillCount.load())
+            std::this_thread::yield();
+        AllocationHeader *first = nullptr, *last = nullptr;
+        std::size_t kept = 0u, freed = 0u;
+        for (auto *it = HeadPointer(head); it;) {
+            auto * const next = it->next;
+            const bool arenaAllocation = _arena.contains(it);
+            // Arena allocations can't be returned to the system, they are only dropped with the arena itself
+            if (kept < keepCount || (arenaAllocation && !dropArena)) {
+                it->next = first;
+                first = it;
+                if (!last)
+                    last = it;
+                ++kept;
+            } else {
+                released += it->capacity + Core::CacheLineSize;
+                if (!arenaAllocation)
+                    Core::Utils::AlignedFree(it);
+                ++freed;
+            }
+            it = next;
+        }
+        counters.retained.fetch_sub(kept + freed, std::memory_order_relaxed);
+        counters.allocated.fetch_sub(freed, std::memory_order_relaxed);
+        if (kept)
+            pushList(i, first, last, kept);
+    }
+    return released;
+}
+
+bool Internal::BufferAllocator::releaseArena(void) noexcept
+{
+    flushLocalCache();
+    // An allocation that isn't pooled is still owned by a buffer
+    for (const auto &counters : _counters) {
+        if (counters.allocated.load(std::memory_order_relaxed) != counters.retained.load(std::memory_order_relaxed))
+            return false;
+    }
+    trim(0u, true);
+    _arena.release();
+    return true;
+}
+
+Internal::BufferAllocator::ThreadCache &Internal::BufferAllocator::LocalCache(void) noexcept
+{
+    static thread_local ThreadCache Cache {};
+
+    return Cache;
+}
+
+Internal::BufferAllocator::ThreadCache::~ThreadCache(void) noexcept
+{
+    for (auto i = 0u; i < AllocationPowerRange; ++i)
+        _Instance.flush(i, magazines[i], magazines[i].count);
+}
+
+bool Internal::BufferAllocator::refill(const std::size_t bucketIndex, Magazine &magazine) noexcept
 {
-    for (auto &bucket : _buckets) {
-        AllocationHeader *expected, *desired;
-        while (true) {
-            expected = bucket.load();
-            if (!expected)
-                break;
-            desired = expected->next;
-            if (!bucket.compare_exchange_weak(expected, desired))
-                continue;
-            Core::Utils::AlignedFree(expected);
-            if (desired == nullptr)
-                break;
+    auto &bucket = _buckets.at(bucketIndex);
+    AllocationHeader *first, *last;
+    std::size_t count;
+
+    // Announce the walk before loading the head, a concurrent trim waits for it before freeing the list
+    _refillCount.fetch_add(1u);
+    auto head = bucket.load();
+    // Detach up to a batch of allocations at once, the tag ensures that the list didn't change in between
+    do {
+        first = HeadPointer(head);
+        if (!first) {
+            _refillCount.fetch_sub(1u, std::memory_order_release);
+            return false;
+        }
+        last = first;
+        count = 1u;
+        while (count < MagazineBatchSize && last->next) {
+            last = last->next;
+            ++count;
         }
+    } while (!bucket.compare_exchange_weak(head, NextHead(head, last->next), std::memory_order_acquire, std::memory_order_acquire));
+    _refillCount.fetch_sub(1u, std::memory_order_release);
+    auto &counters = _counters[bucketIndex];
+    counters.retained.fetch_sub(count, std::memory_order_relaxed);
+    counters.hits.fetch_add(magazine.hits, std::memory_order_relaxed);
+    magazine.hits = 0u;
+    for (auto *it = first; count; --count, it = it->next)
+        magazine.headers[magazine.count++] = it;
+    return true;
+}
+
+void Internal::BufferAllocator::flush(const std::size_t bucketIndex, Magazine &magazine, const std::size_t count) noexcept
+{
+    if (magazine.hits) {
+        _counters[bucketIndex].hits.fetch_add(magazine.hits, std::memory_order_relaxed);
+        magazine.hits = 0u;
     }
+    if (!count)
+        return;
+    // The bottom of the magazine holds the least recently used allocations
+    auto &headers = magazine.headers;
+    for (auto i = 1u; i < count; ++i)
+        headers[i - 1]->next = headers[i];
+    auto * const first = headers[0];
+    auto * const last = headers[count - 1];
+    std::move(headers.begin() + count, headers.begin() + magazine.count, headers.begin());
+    magazine.count -= count;
+    pushList(bucketIndex, first, last, count);
+}
+
+void Internal::BufferAllocator::pushList(const std::size_t bucketIndex, AllocationHeader * const first, AllocationHeader * const last, const std::size_t count) noexcept
+{
+    auto &bucket = _buckets.at(bucketIndex);
+    auto head = bucket.load(std::memory_order_relaxed);
+
+    do {
+        last->next = HeadPointer(head);
+    } while (!bucket.compare_exchange_weak(head, NextHead(head, first), std::memory_order_release, std::memory_order_relaxed));
+    _counters[bucketIndex].retained.fetch_add(count, std::memory_order_relaxed);
+}
+
+void Internal::BufferAllocator::countFallback(const std::size_t bucketIndex) noexcept
+{
+    auto &counters = _counters[bucketIndex];
+    const auto allocated = counters.allocated.fetch_add(1u, std::memory_order_relaxed) + 1u;
+    auto highWater = counters.highWater.load(std::memory_order_relaxed);
+
+    counters.fallbacks.fetch_add(1u, std::memory_order_relaxed);
+    while (highWater < allocated && !counters.highWater.compare_exchange_weak(highWater, allocated, std::memory_order_relaxed));
 }
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cmath>
 #include <cstring>
 #include <memory>
 #include <atomic>
@@ -13,6 +14,7 @@
 #include <memory_resource>
 
 #include "Base.hpp"
+#include "BufferArena.hpp"
 
 namespace Audio
 {
@@ -36,6 +38,8 @@ namespace Audio
             SampleRate sampleRate {};
             ChannelArrangement channelArrangement {};
             Format format {};
+            bool silent { false }; // The content is known to be filled of zero
+            bool silenceMarked { false }; // Set by a plugin that wrote nothing during its last 'receiveAudio'
             // Chrono timestamp {}
             AllocationHeader *next { nullptr };
         };
@@ -53,6 +57,12 @@ public:
     static constexpr std::size_t MinAllocationSize = 1ull << MinAllocationPower;
     static constexpr std::size_t MaxAllocationSize = 1ull << MaxAllocationPower;
 
+    /** @brief Number of allocations cached per thread and per bucket */
+    static constexpr std::size_t MagazineCapacity = 8u;
+
+    /** @brief Number of allocations moved at once between a thread magazine and its global bucket */
+    static constexpr std::size_t MagazineBatchSize = MagazineCapacity / 2u;
+
     /** @brief Allocates a buffer in memory, setting-up its header */
     [[nodiscard]] static inline AllocationHeader *Allocate(
             const std::size_t channelByteSize, const SampleRate sampleRate, const ChannelArrangement channelArrangement, const Format format) noexcept
@@ -66,13 +76,131 @@ public:
     static void Clear(void) noexcept
         { _Instance.clear(); }
 
+    /** @brief Usage statistics of a bucket */
+    struct BucketStats
+    {
+        std::size_t capacity { 0u }; // Byte capacity of the bucket allocations
+        std::size_t hits { 0u }; // Allocations served from the pool
+        std::size_t fallbacks { 0u }; // Allocations that reached the system allocator
+        std::size_t allocatedCount { 0u }; // Allocations owned by the bucket, pooled or in use
+        std::size_t highWaterCount { 0u }; // Maximum number of allocations owned at once
+        std::size_t retainedCount { 0u }; // Allocations pooled in the global bucket (thread magazines excluded)
+        std::size_t retainedBytes { 0u };
+    };
+
+    /** @brief Ensure that the bucket of 'byteSize' allocations pools at least 'count' allocations
+     *  Must be called outside of the audio thread, before the buffers are requested */
+    static void Reserve(const std::size_t byteSize, const std::size_t count) noexcept
+        { _Instance.reserve(byteSize, count); }
+
+    /** @brief Get the usage statistics of a bucket (hits of other threads are published by batch) */
+    [[nodiscard]] static BucketStats Stats(const std::size_t bucketIndex) noexcept
+        { return _Instance.stats(bucketIndex); }
+
+    /** @brief Return the pooled allocations exceeding 'keepCount' per bucket to the system (should not be called during playback)
+     *  Waits for the concurrent refills walking the detached lists before freeing them
+     *  Allocations carved from the arena stay pooled
+     *  @return Released bytes */
+    static std::size_t Trim(const std::size_t keepCount = 0u) noexcept
+        { _Instance.flushLocalCache(); return _Instance.trim(keepCount); }
+
+    /** @brief Arena configuration and backing */
+    using ArenaConfig = BufferArena::Config;
+    using ArenaBacking = BufferArena::Backing;
+
+    /** @brief Map the arena from which bucket allocations are carved, must be called at startup
+     *  @return The backing actually obtained */
+    static ArenaBacking InitArena(const ArenaConfig &config) noexcept
+        { return _Instance._arena.init(config); }
+
+    /** @brief Return every pooled allocation to the system then unmap the arena, the arena can then be mapped again
+     *  Nothing is unmapped if a buffer is still alive, the threads that released buffers must have exited or flushed their magazines
+     *  @return false if the arena is still in use */
+    static bool ReleaseArena(void) noexcept
+        { return _Instance.releaseArena(); }
+
+    /** @brief Get the backing of the arena */
+    [[nodiscard]] static ArenaBacking GetArenaBacking(void) noexcept
+        { return _Instance._arena.backing(); }
+
+    /** @brief Check if the arena is locked in memory */
+    [[nodiscard]] static bool IsArenaLocked(void) noexcept
+        { return _Instance._arena.locked(); }
+
+    /** @brief Check if an allocation was carved from the arena */
+    [[nodiscard]] static bool IsArenaAllocation(const AllocationHeader * const header) noexcept
+        { return _Instance._arena.contains(header); }
+
+    /** @brief Get the bucket index and capacity of an allocation of 'byteSize' bytes
+     *  @return OutOfRangeAllocationPower if the allocation doesn't fit in any bucket */
+    [[nodiscard]] static std::size_t GetBucketIndex(const std::size_t byteSize, std::size_t &capacity) noexcept;
+
 private:
-    std::array<std::atomic<AllocationHeader *>, AllocationPowerRange> _buckets {};
+    /** @brief Head of a global bucket, the pointer is tagged with a counter incremented on each exchange to prevent ABA
+     *  The tag lives in the upper bits that user-space addresses never use */
+    using TaggedHead = std::uint64_t;
+
+    /** @brief Tagged head layout */
+    static constexpr std::size_t TagShift = 48u;
+    static constexpr TaggedHead PointerMask = (1ull << TagShift) - 1ull;
+
+    /** @brief Per-thread LIFO cache of a bucket */
+    struct Magazine
+    {
+        std::array<AllocationHeader *, MagazineCapacity> headers {};
+        std::size_t count { 0u };
+        std::size_t hits { 0u }; // Published to the bucket counters on refill / flush
+    };
+
+    /** @brief Shared counters of a bucket */
+    struct alignas_cacheline BucketCounters
+    {
+        std::atomic<std::size_t> hits { 0u };
+        std::atomic<std::size_t> fallbacks { 0u };
+        std::atomic<std::size_t> allocated { 0u };
+        std::atomic<std::size_t> highWater { 0u };
+        std::atomic<std::size_t> retained { 0u };
+    };
+
+    /** @brief Per-thread magazines of every bucket, flushed to the global buckets when the thread exits */
+    struct ThreadCache
+    {
+        std::array<Magazine, AllocationPowerRange> magazines {};
+
+        ~ThreadCache(void) noexcept;
+    };
+
+    std::array<std::atomic<TaggedHead>, AllocationPowerRange> _buckets {};
+    std::array<BucketCounters, AllocationPowerRange> _counters {};
+    alignas_cacheline std::atomic<std::size_t> _refillCount { 0u }; // Refills walking a global bucket, a trim can't free the allocations they may read
+    BufferArena _arena {};
 
     static BufferAllocator _Instance;
 
-    /** @brief Destructor */
-    ~BufferAllocator(void) noexcept { clear(); }
+    /** @brief Get the magazines of the calling thread */
+    [[nodiscard]] static ThreadCache &LocalCache(void) noexcept;
+
+    /** @brief Tagged head helpers */
+    [[nodiscard]] static AllocationHeader *HeadPointer(const TaggedHead head) noexcept
+        { return reinterpret_cast<AllocationHeader *>(head & PointerMask); }
+    [[nodiscard]] static TaggedHead NextHead(const TaggedHead head, const AllocationHeader * const pointer) noexcept
+        { return (((head >> TagShift) + 1ull) << TagShift) | (reinterpret_cast<TaggedHead>(pointer) & PointerMask); }
+
+    /** @brief Refill an empty magazine with a batch of allocations from its global bucket
+     *  @return false if the global bucket is empty */
+    [[nodiscard]] bool refill(const std::size_t bucketIndex, Magazine &magazine) noexcept;
+
+    /** @brief Flush the 'count' least recently used allocations of a magazine to its global bucket */
+    void flush(const std::size_t bucketIndex, Magazine &magazine, const std::size_t count) noexcept;
+
+    /** @brief Push a linked list of 'count' allocations to a global bucket */
+    void pushList(const std::size_t bucketIndex, AllocationHeader * const first, AllocationHeader * const last, const std::size_t count) noexcept;
+
+    /** @brief Count a system allocation made for a bucket */
+    void countFallback(const std::size_t bucketIndex) noexcept;
+
+    /** @brief Destructor, only system allocations are released since arena buffers may outlive the allocator */
+    ~BufferAllocator(void) noexcept { trim(0u); }
 
     /** @brief Allocates a buffer in memory, setting-up its header */
     [[nodiscard]] AllocationHeader *allocate(
@@ -81,9 +209,24 @@ private:
     /** @brief Deallocates a buffer in memory */
     void deallocate(AllocationHeader * const header) noexcept;
 
-    /** @brief Release all internal memory */
+    /** @brief Release all internal memory, including the magazines of the calling thread */
     void clear(void) noexcept;
 
+    /** @brief Flush every magazine of the calling thread to the global buckets */
+    void flushLocalCache(void) noexcept;
+
+    /** @brief Pool allocations up front */
+    void reserve(const std::size_t byteSize, const std::size_t count) noexcept;
+
+    /** @brief Get the usage statistics of a bucket */
+    [[nodiscard]] BucketStats stats(const std::size_t bucketIndex) noexcept;
+
+    /** @brief Release the allocations of the global buckets exceeding 'keepCount', arena allocations are only dropped if 'dropArena' is true */
+    std::size_t trim(const std::size_t keepCount, const bool dropArena = false) noexcept;
+
+    /** @brief Release every pooled allocation and unmap the arena if no buffer is alive */
+    [[nodiscard]] bool releaseArena(void) noexcept;
+
     /** @brief Fallback that allocates memory for a buffer */
     [[nodiscard]] static AllocationHeader *AllocateFallback(
             const std::size_t channelByteSize, const SampleRate sampleRate, const ChannelArrangement channelArrangement, const Format format,
@@ -113,8 +256,22 @@ public:
     /** @brief Swap two instances */
     void swap(BufferBase &other) noexcept { std::swap(_header, other._header); }
 
-    /** @brief Clear the internal content */
-    void clear(void) { std::memset(reinterpret_cast<void *>(_header + 1), 0, _header->channelByteSize * static_cast<std::size_t>(_header->channelArrangement)); }
+    /** @brief Clear the internal content, the buffer is then known to be silent */
+    void clear(void) { std::memset(reinterpret_cast<void *>(_header + 1), 0, _header->channelByteSize * static_cast<std::size_t>(_header->channelArrangement)); _header->silent = true; }
+
+    /** @brief Check if the buffer is known to be filled of zero, without reading its content
+     *  Writing through a data pointer doesn't reset the flag, the writer must call 'setSilent(false)' */
+    [[nodiscard]] bool isSilent(void) const noexcept { return _header && _header->silent; }
+
+    /** @brief Set the known-silent state, 'true' must only be set when the content is filled of zero */
+    void setSilent(const bool silent) noexcept { _header->silent = silent; }
+
+    /** @brief Declare that nothing was written into the buffer during the current 'receiveAudio' call
+     *  The scheduler keeps the buffer silent only if it was silent before the call */
+    void markSilent(void) noexcept { _header->silenceMarked = true; }
+
+    /** @brief Get and reset the silence mark */
+    [[nodiscard]] bool consumeSilenceMark(void) noexcept { const bool marked = _header->silenceMarked; _header->silenceMarked = false; return marked; }
 
     /** @brief Fast allocation check */
     [[nodiscard]] operator bool(void) const noexcept { return _header; }
@@ -124,10 +281,11 @@ public:
     [[nodiscard]] Type *data(const Channel channel) noexcept
         { return const_cast<Type *>(std::as_const<BufferBase>(*this).data<Type>(channel)); }
 
-    /** @brief Get constant data pointer reintrepreted to a given type & channel */
+    /** @brief Get constant data pointer reintrepreted to a given type & channel
+     *  Channels are planar: each one is stored contiguously, 'channelByteSize' bytes after the previous one */
     template<typename Type>
     [[nodiscard]] const Type *data(const Channel channel) const noexcept
-        { return reinterpret_cast<Type *>(_header + 1) + _header->channelByteSize * static_cast<std::uint32_t>(channel); }
+        { return reinterpret_cast<const Type *>(byteData() + _header->channelByteSize * static_cast<std::size_t>(channel)); }
 
     /** @brief Get data pointer reintrepreted to a given type */
     template<typename Type>
@@ -148,6 +306,9 @@ public:
     /** @brief Get the byte size per channel */
     [[nodiscard]] std::size_t channelByteSize(void) const noexcept { return _header->channelByteSize; }
 
+    /** @brief Get the number of channels */
+    [[nodiscard]] std::size_t channelCount(void) const noexcept { return static_cast<std::size_t>(_header->channelArrangement); }
+
     /** @brief Get the sample count per cahnnel */
     [[nodiscard]] std::size_t channelSampleCount(void) const noexcept { return _header->channelByteSize / GetFormatByteLength(_header->format); }
 
@@ -170,9 +331,13 @@ public:
     template<typename Type = std::byte>
     [[nodiscard]] std::size_t capacity(void) const noexcept { return _header->capacity / sizeof(Type); }
 
-    /** @brief Check if the buffer is filled of zero */
+    /** @brief Check if the buffer is filled of zero, scanning the content unless it is known to be silent */
     [[nodiscard]] bool isZero(void) const noexcept;
 
+    /** @brief Check if every sample has an absolute value lower or equal to 'threshold' */
+    template<typename Type>
+    [[nodiscard]] bool isBelowThreshold(const Type threshold) const noexcept;
+
 public: // Internal public functions for buffers compatibility
     /** @brief Get the allocation header */
     [[nodiscard]] AllocationHeader *header(void) const noexcept { return _header; }
@@ -10,7 +10,14 @@ inline Audio::Internal::AllocationHeader *Audio::Internal::BufferAllocator::Allo
         const std::size_t usedSize, const std::size_t capacity, const std::size_t bucketIndex) noexcept
 {
     // std::cout << "AllocateFallback: " << channelByteSize << ", " << usedSize << ", " << capacity << ", " << bucketIndex << std::endl;
-    if (const auto data = Core::Utils::AlignedAlloc<Core::CacheLineSize>(capacity + Core::CacheLineSize); data) {
+    void *data = nullptr;
+
+    // Bucket allocations are carved from the arena while it has room
+    if (bucketIndex != OutOfRangeAllocationPower)
+        data = _Instance._arena.allocate(capacity + Core::CacheLineSize);
+    if (!data)
+        data = Core::Utils::AlignedAlloc<Core::CacheLineSize>(capacity + Core::CacheLineSize);
+    if (data) {
         return new (data) AllocationHeader {
             /* capacity: */ capacity,
             /* channelByteSize: */ channelByteSize,
@@ -18,7 +25,9 @@ inline Audio::Internal::AllocationHeader *Audio::Internal::BufferAllocator::Allo
             /* bucketIndex: */ bucketIndex,
             /* sampleRate: */ sampleRate,
             /* channelArrangement: */ channelArrangement,
-            /* format: */ format
+            /* format: */ format,
+            /* silent: */ false,
+            /* silenceMarked: */ false
         };
     } else
         return nullptr;
@@ -26,16 +35,53 @@ inline Audio::Internal::AllocationHeader *Audio::Internal::BufferAllocator::Allo
 
 inline bool Audio::Internal::BufferBase::isZero(void) const noexcept
 {
-    // We can assert that a buffer has at least 3 * sizeof(size_t) because its buffer data is aligned to cacheline size
-    // if (!_header || data<std::size_t>()[0] || data<std::size_t>()[_header->size / 2] || data<std::size_t>()[_header->size - sizeof(std::size_t)])
-    //     return false;
-    if (!_header)
+    constexpr std::size_t WordsPerCacheLine = Core::CacheLineSize / sizeof(std::uint64_t);
+
+    if (!_header || _header->silent)
         return true;
-    return std::all_of(byteData(), byteData() + _header->size, [](const auto c) {
+    // The data is cacheline aligned, whole cachelines are OR-reduced as words so the inner loop gets vectorized
+    const auto size = _header->size;
+    const auto *it = byteData();
+    const auto * const lineEnd = it + size - size % Core::CacheLineSize;
+    for (; it != lineEnd; it += Core::CacheLineSize) {
+        std::uint64_t words[WordsPerCacheLine];
+        std::uint64_t accumulator = 0u;
+        std::memcpy(words, it, Core::CacheLineSize);
+        for (auto i = 0u; i < WordsPerCacheLine; ++i)
+            accumulator |= words[i];
+        if (accumulator)
+            return false;
+    }
+    return std::all_of(it, byteData() + size, [](const auto c) {
         return c == 0u;
     });
 }
 
+template<typename Type>
+inline bool Audio::Internal::BufferBase::isBelowThreshold(const Type threshold) const noexcept
+{
+    constexpr std::size_t Stride = Core::CacheLineSize / sizeof(Type);
+
+    if (!_header || _header->silent)
+        return true;
+    const auto count = size<Type>();
+    const Type *it = data<Type>();
+    std::size_t i = 0u;
+    // Branchless per cacheline, exits at the first cacheline holding a loud sample
+    for (; i + Stride <= count; i += Stride) {
+        bool above = false;
+        for (auto k = 0u; k < Stride; ++k)
+            above |= std::abs(it[i + k]) > threshold;
+        if (above)
+            return false;
+    }
+    for (; i < count; ++i) {
+        if (std::abs(it[i]) > threshold)
+            return false;
+    }
+    return true;
+}
+
 inline void Audio::Buffer::resize(const std::size_t channelByteSize, const SampleRate sampleRate, const ChannelArrangement channelArrangement, const Format format) noexcept
 {
     const auto totalSize = channelByteSize * static_cast<std::size_t>(channelArrangement);
@@ -46,6 +92,7 @@ inline void Audio::Buffer::resize(const std::size_t channelByteSize, const Sampl
         header()->sampleRate = sampleRate;
         header()->channelArrangement = channelArrangement;
         header()->format = format;
+        header()->silent = false;
     } else {
         *this = Buffer(channelByteSize, sampleRate, channelArrangement, format);
     }
@@ -65,6 +112,7 @@ inline void Audio::Buffer::copy(const Internal::BufferBase &target)
         *this = Buffer(target.channelByteSize(), target.sampleRate(), target.channelArrangement(), target.format());
         std::memcpy(byteData(), target.byteData(), target.size<std::uint8_t>());
     }
+    header()->silent = target.header()->silent;
 }
 
 inline void Audio::Buffer::copyRange(const Internal::BufferBase &target, const std::size_t from, const std::size_t to)
@@ -81,6 +129,7 @@ inline void Audio::Buffer::copyRange(const Internal::BufferBase &target, const s
         *this = Buffer(newSize, target.sampleRate(), target.channelArrangement(), target.format());
         std::memcpy(byteData(), target.byteData() + from, newSize);
     }
+    header()->silent = target.header()->silent;
 }
 
 #include <iostream>
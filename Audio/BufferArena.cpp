@@ -0,0 +1,91 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: BufferArena
+ */
+
+#if defined(__linux__) || defined(__APPLE__)
+# include <sys/mman.h>
+#endif
+
+#include "BufferArena.hpp"
+
+using namespace Audio;
+
+Internal::BufferArena::Backing Internal::BufferArena::init(const Config &config) noexcept
+{
+    if (_data || !config.byteSize)
+        return _backing;
+    const auto byteSize = ((config.byteSize + HugePageSize - 1u) / HugePageSize) * HugePageSize;
+
+#if defined(__linux__) || defined(__APPLE__)
+# if defined(MAP_HUGETLB)
+    // Explicit hugepages are only available if the system reserved some (vm.nr_hugepages)
+    if (config.hugePages) {
+        if (auto data = ::mmap(nullptr, byteSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0); data != MAP_FAILED) {
+            _data = reinterpret_cast<std::uint8_t *>(data);
+            _backing = Backing::HugeTLB;
+        }
+    }
+# endif
+    if (!_data) {
+        // Over-map to align the arena on a hugepage boundary, then unmap the slack
+        const auto mappedSize = byteSize + HugePageSize;
+        auto data = ::mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (data == MAP_FAILED)
+            return _backing;
+        const auto begin = reinterpret_cast<std::uintptr_t>(data);
+        const auto aligned = ((begin + HugePageSize - 1u) / HugePageSize) * HugePageSize;
+        if (aligned != begin)
+            ::munmap(data, aligned - begin);
+        if (const auto tail = (begin + mappedSize) - (aligned + byteSize); tail)
+            ::munmap(reinterpret_cast<void *>(aligned + byteSize), tail);
+        _data = reinterpret_cast<std::uint8_t *>(aligned);
+        _backing = Backing::Pages;
+# if defined(MADV_HUGEPAGE)
+        if (config.hugePages && !::madvise(_data, byteSize, MADV_HUGEPAGE))
+            _backing = Backing::TransparentHugePages;
+# endif
+    }
+    // Locking also faults every page in
+    if (config.lockMemory)
+        _locked = !::mlock(_data, byteSize);
+#else
+    _data = reinterpret_cast<std::uint8_t *>(Core::Utils::AlignedAlloc<Core::CacheLineSize>(byteSize));
+    if (!_data)
+        return _backing;
+    _backing = Backing::Heap;
+#endif
+    _byteSize = byteSize;
+    _offset.store(0u, std::memory_order_relaxed);
+    return _backing;
+}
+
+void Internal::BufferArena::release(void) noexcept
+{
+    if (!_data)
+        return;
+#if defined(__linux__) || defined(__APPLE__)
+    if (_locked)
+        ::munlock(_data, _byteSize);
+    ::munmap(_data, _byteSize);
+#else
+    Core::Utils::AlignedFree(_data);
+#endif
+    _data = nullptr;
+    _byteSize = 0u;
+    _backing = Backing::None;
+    _locked = false;
+    _offset.store(0u, std::memory_order_relaxed);
+}
+
+void *Internal::BufferArena::allocate(const std::size_t byteSize) noexcept
+{
+    const auto alignedSize = ((byteSize + Core::CacheLineSize - 1u) / Core::CacheLineSize) * Core::CacheLineSize;
+    auto offset = _offset.load(std::memory_order_relaxed);
+
+    do {
+        if (offset + alignedSize > _byteSize)
+            return nullptr;
+    } while (!_offset.compare_exchange_weak(offset, offset + alignedSize, std::memory_order_relaxed));
+    return _data + offset;
+}
@@ -0,0 +1,88 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: BufferArena
+ */
+
+#pragma once
+
+#include <atomic>
+
+#include "Base.hpp"
+
+namespace Audio
+{
+    namespace Internal
+    {
+        class BufferArena;
+    }
+}
+
+/** @brief Contiguous memory region from which buffer allocations are carved
+ *  The region is backed by 2MB hugepages when available, reducing TLB misses over large projects.
+ *  It can also be locked in memory so that the audio path never page-faults.
+ *  Allocations are never returned to the arena, they are recycled by the buffer allocator buckets */
+class alignas_cacheline Audio::Internal::BufferArena
+{
+public:
+    /** @brief Size of a hugepage */
+    static constexpr std::size_t HugePageSize = 2ul * 1024ul * 1024ul;
+
+    /** @brief Memory actually backing the arena */
+    enum class Backing : std::uint8_t {
+        None,                   // No arena
+        Heap,                   // Regular heap allocation (platform without page mapping)
+        Pages,                  // Mapped regular pages
+        TransparentHugePages,   // Mapped pages advised to be promoted to hugepages
+        HugeTLB                 // Explicit hugepages from the reserved pool
+    };
+
+    /** @brief Arena configuration */
+    struct Config
+    {
+        std::size_t byteSize { 0u };
+        bool hugePages { true };
+        bool lockMemory { false };
+    };
+
+
+    /** @brief Default constructor */
+    BufferArena(void) noexcept = default;
+
+    /** @brief Destructor, the mapping is left to the system at exit
+     *  Buffers destroyed later during the static destruction may still point into the arena */
+    ~BufferArena(void) noexcept = default;
+
+    /** @brief Map the arena, trying explicit hugepages then transparent hugepages then regular pages
+     *  Does nothing if the arena is already initialized
+     *  @return The obtained backing */
+    Backing init(const Config &config) noexcept;
+
+    /** @brief Unmap the arena (every allocation carved from it must be released) */
+    void release(void) noexcept;
+
+    /** @brief Carve a cacheline aligned allocation, nullptr if the arena is exhausted */
+    [[nodiscard]] void *allocate(const std::size_t byteSize) noexcept;
+
+    /** @brief Check if an allocation was carved from the arena */
+    [[nodiscard]] bool contains(const void * const data) const noexcept
+        { return data >= _data && data < _data + _byteSize; }
+
+    /** @brief Get the obtained backing */
+    [[nodiscard]] Backing backing(void) const noexcept { return _backing; }
+
+    /** @brief Check if the arena is locked in memory */
+    [[nodiscard]] bool locked(void) const noexcept { return _locked; }
+
+    /** @brief Get the arena size in bytes */
+    [[nodiscard]] std::size_t byteSize(void) const noexcept { return _byteSize; }
+
+    /** @brief Get the number of bytes already carved */
+    [[nodiscard]] std::size_t usedByteSize(void) const noexcept { return _offset.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<std::size_t> _offset { 0u };
+    std::uint8_t *_data { nullptr };
+    std::size_t _byteSize { 0u };
+    Backing _backing { Backing::None };
+    bool _locked { false };
+};
@@ -10,7 +10,9 @@ inline void Audio::GenerateOctave(const BufferView input, BufferOctave &octave)
 {
     DSP::Resampler<Type> resampler;
 
-    const std::size_t inputSize = input.size<Type>();
+    // Channels are planar, each one is resampled on its own
+    const std::size_t inputSize = input.channelSampleCount();
+    const std::size_t channelCount = input.channelCount();
     std::size_t nextSize = DSP::Resampler<Type>::GetResampleSemitoneBufferSize(inputSize, false);
     // std::size_t nextSize = DSP::Resampler<Type>::GetResampleOctaveBufferSize(inputSize, -1);
     std::size_t lastSize = inputSize;
@@ -36,7 +38,8 @@ inline void Audio::GenerateOctave(const BufferView input, BufferOctave &octave)
         const std::size_t nextIdx = lastIdx - 1;
         octave[nextIdx].resize(nextSize * sizeof(Type), octave[lastIdx].sampleRate(), octave[lastIdx].channelArrangement(), octave[lastIdx].format());
         octave[nextIdx].clear();
-        resampler.template resampleSemitone<false, 8u>(octave[lastIdx].data<Type>(), octave[nextIdx].data<Type>(), lastSize, octave[OctaveRootKey].sampleRate(), false);
+        for (auto channel = 0u; channel < channelCount; ++channel)
+            resampler.template resampleSemitone<false, 8u>(octave[lastIdx].data<Type>(static_cast<Channel>(channel)), octave[nextIdx].data<Type>(static_cast<Channel>(channel)), lastSize, octave[OctaveRootKey].sampleRate(), false);
         // resampler.template resampleOctave<false, 8u>(octave[lastIdx].data<Type>(), octave[nextIdx].data<Type>(), lastSize, octave[OctaveRootKey].sampleRate(), 1);
         GetMinMax(octave[nextIdx]);
         lastSize = nextSize;
@@ -53,7 +56,8 @@ inline void Audio::GenerateOctave(const BufferView input, BufferOctave &octave)
         const std::size_t nextIdx = lastIdx + 1;
         octave[nextIdx].resize(nextSize * sizeof(Type), octave[lastIdx].sampleRate(), octave[lastIdx].channelArrangement(), octave[lastIdx].format());
         octave[nextIdx].clear();
-        resampler.template resampleSemitone<false, 8u>(octave[lastIdx].data<Type>(), octave[nextIdx].data<Type>(), lastSize, octave[OctaveRootKey].sampleRate(), true);
+        for (auto channel = 0u; channel < channelCount; ++channel)
+            resampler.template resampleSemitone<false, 8u>(octave[lastIdx].data<Type>(static_cast<Channel>(channel)), octave[nextIdx].data<Type>(static_cast<Channel>(channel)), lastSize, octave[OctaveRootKey].sampleRate(), true);
         // resampler.template resampleOctave<false, 8u>(octave[lastIdx].data<Type>(), octave[nextIdx].data<Type>(), lastSize, octave[OctaveRootKey].sampleRate(), 1);
         GetMinMax(octave[nextIdx]);
         lastSize = nextSize;
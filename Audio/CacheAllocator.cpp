@@ -0,0 +1,98 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: CacheAllocator
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include "CacheAllocator.hpp"
+
+using namespace Audio;
+
+CacheAllocator::Step CacheAllocator::addStep(void)
+{
+    _successors.push();
+    return static_cast<Step>(_successors.size() - 1u);
+}
+
+void CacheAllocator::precede(const Step from, const Step to)
+{
+    _successors.at(from).push(to);
+}
+
+void CacheAllocator::addCache(Node * const node, const Step producer, const Step consumer)
+{
+    if (!node->parent())
+        return;
+    _uses.push(CacheUse { node, producer, consumer == NoStep ? producer : consumer });
+}
+
+std::size_t CacheAllocator::allocate(Pool &pool, const Buffer &model, const bool shrink)
+{
+    const std::size_t stepCount = _successors.size();
+    const std::size_t wordCount = (stepCount + 63u) / 64u;
+
+    // Topological order of the steps
+    std::vector<std::uint32_t> inDegrees(stepCount, 0u);
+    std::vector<Step> order;
+    order.reserve(stepCount);
+    for (const auto &successors : _successors) {
+        for (const auto successor : successors)
+            ++inDegrees[successor];
+    }
+    for (Step step = 0u; step < stepCount; ++step) {
+        if (!inDegrees[step])
+            order.push_back(step);
+    }
+    for (std::size_t i = 0u; i < order.size(); ++i) {
+        for (const auto successor : _successors[order[i]]) {
+            if (!--inDegrees[successor])
+                order.push_back(successor);
+        }
+    }
+
+    // Steps that always run after each step
+    std::vector<std::uint64_t> reach(stepCount * wordCount, 0u);
+    const auto reachable = [&reach, wordCount](const Step from, const Step to) {
+        return (reach[from * wordCount + to / 64u] >> (to % 64u)) & 1u;
+    };
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        auto * const words = &reach[*it * wordCount];
+        for (const auto successor : _successors[*it]) {
+            const auto * const successorWords = &reach[successor * wordCount];
+            for (std::size_t i = 0u; i < wordCount; ++i)
+                words[i] |= successorWords[i];
+            words[successor / 64u] |= 1ull << (successor % 64u);
+        }
+    }
+
+    // Greedy assignment in topological order of the producers, each shared cache is a chain of ordered lifetimes
+    std::vector<std::uint32_t> ranks(stepCount, 0u);
+    for (std::uint32_t i = 0u; i < order.size(); ++i)
+        ranks[order[i]] = i;
+    std::sort(_uses.begin(), _uses.end(), [&ranks](const CacheUse &lhs, const CacheUse &rhs) {
+        return ranks[lhs.producer] < ranks[rhs.producer];
+    });
+    std::vector<Step> lastConsumers;
+    for (const auto &use : _uses) {
+        std::size_t index = 0u;
+        while (index < lastConsumers.size() && !reachable(lastConsumers[index], use.producer))
+            ++index;
+        if (index == lastConsumers.size())
+            lastConsumers.push_back(use.consumer);
+        else
+            lastConsumers[index] = use.consumer;
+        if (index >= pool.size())
+            pool.push(std::make_unique<Buffer>());
+        auto &cache = *pool[index];
+        if (!cache && model)
+            cache.resize(model.channelByteSize(), model.sampleRate(), model.channelArrangement(), model.format());
+        use.node->bindCache(&cache);
+    }
+    if (shrink && pool.size() > lastConsumers.size())
+        pool.resize(lastConsumers.size());
+    _successors.clear();
+    _uses.clear();
+    return lastConsumers.size();
+}
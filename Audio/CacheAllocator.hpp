@@ -0,0 +1,62 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: CacheAllocator
+ */
+
+#pragma once
+
+#include <memory>
+
+#include <Core/Vector.hpp>
+
+#include "Node.hpp"
+
+namespace Audio
+{
+    class CacheAllocator;
+}
+
+/** @brief Assign node caches to a small pool of shared buffers, like a register allocator
+ *  While a graph is built, every task is recorded as a step with its dependencies, and every node cache
+ *  as an interval from the step producing it to the step consuming it.
+ *  Two caches can share a buffer if one is always consumed before the other is produced, whatever the tasks scheduling */
+class Audio::CacheAllocator
+{
+public:
+    /** @brief Index of a step */
+    using Step = std::uint32_t;
+
+    /** @brief Pool of shared caches (pointers remain stable when the pool grows) */
+    using Pool = Core::TinyVector<std::unique_ptr<Buffer>>;
+
+    /** @brief Consumer of a cache that is only used by its producer */
+    static constexpr Step NoStep = ~static_cast<Step>(0);
+
+
+    /** @brief Record a new step */
+    [[nodiscard]] Step addStep(void);
+
+    /** @brief Record that 'from' always completes before 'to' starts */
+    void precede(const Step from, const Step to);
+
+    /** @brief Record the lifetime of a node cache, nodes without parent keep their own cache */
+    void addCache(Node * const node, const Step producer, const Step consumer = NoStep);
+
+    /** @brief Assign every recorded cache to a buffer of the pool
+     *  @param model Buffer whose specs are used for new shared caches
+     *  @param shrink If true, every node is expected to be recorded and unused shared caches are released
+     *  @return Number of shared caches used */
+    std::size_t allocate(Pool &pool, const Buffer &model, const bool shrink);
+
+private:
+    /** @brief Lifetime of a node cache */
+    struct CacheUse
+    {
+        Node *node { nullptr };
+        Step producer { 0u };
+        Step consumer { 0u };
+    };
+
+    Core::TinyVector<Core::TinyVector<Step>> _successors {};
+    Core::TinyVector<CacheUse> _uses {};
+};
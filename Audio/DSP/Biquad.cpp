@@ -3,4 +3,120 @@
  * @ Description: Biquad.cpp
  */
 
+#include <algorithm>
+#include <cstring>
+
 #include "Biquad.hpp"
+#include "Dispatch.hpp"
+
+using namespace Audio::DSP::Biquad;
+
+namespace
+{
+    /** @brief Round a count up to a multiple of the widest lane count */
+    std::size_t GetStride(const std::size_t count) noexcept
+    {
+        return (count + Audio::DSP::Simd::MaxWidth - 1u) / Audio::DSP::Simd::MaxWidth * Audio::DSP::Simd::MaxWidth;
+    }
+
+    /** @brief Write the coefficients of a section, feedback coefficients are negated so the kernels only add */
+    void WriteCoefficients(float *coefficients, const std::size_t stride, const Internal::Coefficients &section) noexcept
+    {
+        coefficients[0u] = section.b[0];
+        coefficients[stride] = section.b[1];
+        coefficients[2u * stride] = section.b[2];
+        coefficients[3u * stride] = -section.a[1];
+        coefficients[4u * stride] = -section.a[2];
+    }
+
+    /** @brief Multiply a block by a gain */
+    void ApplyGain(float *output, const std::size_t size, const float gain) noexcept
+    {
+        if (gain == 1.0f)
+            return;
+        for (auto i = 0u; i < size; ++i)
+            output[i] *= gain;
+    }
+
+    /** @brief Identity section */
+    constexpr Internal::Coefficients Identity { { 1.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f } };
+}
+
+void Cascade::setSectionCount(const std::size_t sectionCount)
+{
+    const auto stride = GetStride(sectionCount);
+
+    if (stride != _stride) {
+        Core::TinyVector<float> coefficients(Cascade::CoefficientCount * stride);
+        for (auto section = 0u; section < stride; ++section)
+            WriteCoefficients(coefficients.data() + section, stride, Identity);
+        // Sections are kept at their index
+        for (auto section = 0u; section < std::min(_sectionCount, sectionCount); ++section) {
+            for (auto coefficient = 0u; coefficient < Cascade::CoefficientCount; ++coefficient)
+                coefficients[coefficient * stride + section] = _coefficients[coefficient * _stride + section];
+        }
+        _coefficients = std::move(coefficients);
+        _stride = stride;
+        for (auto &registers : _registers)
+            registers.resize(2u * stride);
+    } else {
+        for (auto section = sectionCount; section < _sectionCount; ++section)
+            WriteCoefficients(_coefficients.data() + section, _stride, Identity);
+    }
+    _sectionCount = sectionCount;
+    resetRegisters();
+}
+
+void Cascade::setupCoefficients(const std::size_t section, const Internal::Coefficients &coefficients) noexcept
+{
+    WriteCoefficients(_coefficients.data() + section, _stride, coefficients);
+}
+
+void Cascade::filterBlock(const float *input, const std::size_t size, float *output, const DB outGain, const Channel channel) noexcept
+{
+    if (!_sectionCount) {
+        if (output != input)
+            std::memmove(output, input, size * sizeof(float));
+    } else {
+        Simd::Kernels().biquadCascade(_coefficients.data(), _registers[static_cast<std::size_t>(channel)].data(), _stride, _sectionCount,
+            input, output, size);
+    }
+    ApplyGain(output, size, outGain);
+}
+
+void Cascade::resetRegisters(void) noexcept
+{
+    for (auto &registers : _registers)
+        std::fill(registers.begin(), registers.end(), 0.0f);
+}
+
+void Bank::resize(const std::size_t filterCount, const std::size_t sectionCount)
+{
+    _filterCount = filterCount;
+    _sectionCount = sectionCount;
+    _stride = GetStride(filterCount);
+    _coefficients.resize(Cascade::CoefficientCount * _stride * sectionCount);
+    _registers.resize(2u * _stride * sectionCount);
+    for (auto section = 0u; section < sectionCount; ++section) {
+        for (auto filter = 0u; filter < _stride; ++filter)
+            WriteCoefficients(_coefficients.data() + section * Cascade::CoefficientCount * _stride + filter, _stride, Identity);
+    }
+    resetRegisters();
+}
+
+void Bank::setupCoefficients(const std::size_t filter, const std::size_t section, const Internal::Coefficients &coefficients) noexcept
+{
+    WriteCoefficients(_coefficients.data() + section * Cascade::CoefficientCount * _stride + filter, _stride, coefficients);
+}
+
+void Bank::filterBlock(const float * const *inputs, float * const *outputs, const std::size_t size, const DB outGain) noexcept
+{
+    Simd::Kernels().biquadBank(_coefficients.data(), _registers.data(), _stride, _sectionCount, inputs, outputs, _filterCount, size);
+    for (auto filter = 0u; filter < _filterCount; ++filter)
+        ApplyGain(outputs[filter], size, outGain);
+}
+
+void Bank::resetRegisters(void) noexcept
+{
+    std::fill(_registers.begin(), _registers.end(), 0.0f);
+}
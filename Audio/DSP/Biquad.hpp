@@ -9,9 +9,12 @@
 #include <math.h>
 #include <cmath>
 
+#include <array>
 #include <cstdint>
 #include <type_traits>
 
+#include <Core/Vector.hpp>
+
 #include <Audio/Base.hpp>
 #include "Filter.hpp"
 
@@ -31,6 +34,7 @@ namespace Audio::DSP::Biquad
         };
         // static_assert(sizeof(Coefficients) == 24, "Coefficients must take 24 bytes !");
 
+        /** @brief Parameters of a section, 'gain' is in decibels and only used by peak and shelf sections (RBJ cookbook formulas) */
         struct Specs
         {
             DSP::Filter::AdvancedType filterType { DSP::Filter::AdvancedType::LowPass };
@@ -74,6 +78,9 @@ namespace Audio::DSP::Biquad
     // template<Internal::Form Form, typename T>
     template<Internal::Form Form>
     class Filter;
+
+    class Cascade;
+    class Bank;
 }
 
 template<Audio::DSP::Biquad::Internal::Form Form>
@@ -87,9 +94,9 @@ public:
     [[nodiscard]] const Internal::Coefficients &coefficients(void) const noexcept { return _coefs; }
     void setupCoefficients(const Internal::Coefficients &coefficients) noexcept { _coefs = coefficients; }
 
-    /** Process a block of samples */
+    /** Process a block of samples of a channel, each channel keeps its own registers */
     template<typename Type>
-    void filterBlock(const Type *input, const std::size_t size, Type *output, const DB outGain = 1.0) noexcept;
+    void filterBlock(const Type *input, const std::size_t size, Type *output, const DB outGain = 1.0, const Channel channel = Channel::Mono) noexcept;
     // void processBlock1(Type *block, std::size_t len) noexcept;
 
     float foo1(const float a, const float b, const float c) noexcept {
@@ -102,16 +109,79 @@ public:
     void resetRegisters(void) noexcept;
 
 protected:
+    static constexpr std::size_t RegisterCount = (Form == Internal::Form::Direct1 || Form == Internal::Form::Transposed1) ? 4 : 2;
+
     Internal::Coefficients   _coefs;
-    float _regs[(Form == Internal::Form::Direct1 || Form == Internal::Form::Transposed1) ? 4 : 2] { 0.0 };
+    float _regs[MaxChannelCount][RegisterCount] {};
 
-    /** @brief Process a sample into the biquad */
+    /** @brief Process a sample into the biquad using the registers of a channel */
     template<typename Type>
-    [[nodiscard]] Type process(const Type in, const DB outGain) noexcept;
+    [[nodiscard]] Type process(const Type in, const DB outGain, float * const regs) noexcept;
     // [[nodiscard]] float process1(const float in) noexcept;
 };
 
 
+/** @brief Serial cascade of biquad sections in transposed direct form 2
+ *  Sections are stored as structure of arrays and run in the vector lanes of the host CPU, each lane on the previous lane output */
+class Audio::DSP::Biquad::Cascade
+{
+public:
+    /** @brief Number of coefficients of a section */
+    static constexpr std::size_t CoefficientCount = 5u;
+
+    /** @brief Get the number of sections */
+    [[nodiscard]] std::size_t sectionCount(void) const noexcept { return _sectionCount; }
+
+    /** @brief Set the number of sections, new sections let the signal through */
+    void setSectionCount(const std::size_t sectionCount);
+
+    /** @brief Set the coefficients of a section */
+    void setupCoefficients(const std::size_t section, const Internal::Coefficients &coefficients) noexcept;
+
+    /** @brief Process a block of samples of a channel through every section, each channel keeps its own registers */
+    void filterBlock(const float *input, const std::size_t size, float *output, const DB outGain = 1.0, const Channel channel = Channel::Mono) noexcept;
+
+    void resetRegisters(void) noexcept;
+
+private:
+    std::size_t _sectionCount { 0u };
+    /** @brief Number of sections allocated, a multiple of the widest lane count */
+    std::size_t _stride { 0u };
+    Core::TinyVector<float> _coefficients {};
+    std::array<Core::TinyVector<float>, MaxChannelCount> _registers {};
+};
+
+/** @brief Bank of independent biquad cascades, a filter can be a channel of a signal or a band of an equalizer
+ *  Filters are stored as structure of arrays and run side by side in the vector lanes of the host CPU */
+class Audio::DSP::Biquad::Bank
+{
+public:
+    /** @brief Get the number of filters */
+    [[nodiscard]] std::size_t filterCount(void) const noexcept { return _filterCount; }
+
+    /** @brief Get the number of sections of each filter */
+    [[nodiscard]] std::size_t sectionCount(void) const noexcept { return _sectionCount; }
+
+    /** @brief Set the number of filters and their sections, every section lets the signal through */
+    void resize(const std::size_t filterCount, const std::size_t sectionCount);
+
+    /** @brief Set the coefficients of a section of a filter */
+    void setupCoefficients(const std::size_t filter, const std::size_t section, const Internal::Coefficients &coefficients) noexcept;
+
+    /** @brief Process one block of samples per filter */
+    void filterBlock(const float * const *inputs, float * const *outputs, const std::size_t size, const DB outGain = 1.0) noexcept;
+
+    void resetRegisters(void) noexcept;
+
+private:
+    std::size_t _filterCount { 0u };
+    std::size_t _sectionCount { 0u };
+    /** @brief Number of filters allocated, a multiple of the widest lane count */
+    std::size_t _stride { 0u };
+    Core::TinyVector<float> _coefficients {};
+    Core::TinyVector<float> _registers {};
+};
+
 // template<Audio::DSP::Internal::Optimization Opti>
 // struct Audio::DSP::BiquadMaker
 // {
@@ -9,43 +9,47 @@
 template<Audio::DSP::Biquad::Internal::Form Form>
 inline void Audio::DSP::Biquad::Filter<Form>::resetRegisters(void) noexcept
 {
-    for (auto i = 0u; i < sizeof(_regs) / 4; ++i)
-        _regs[i] = 0.0f;
+    for (auto &regs : _regs) {
+        for (auto &reg : regs)
+            reg = 0.0f;
+    }
 }
 
 template<>
 template<typename Type>
-inline Type Audio::DSP::Biquad::Filter<Audio::DSP::Biquad::Internal::Form::Direct1>::process(const Type in, const Audio::DB outGain) noexcept
+inline Type Audio::DSP::Biquad::Filter<Audio::DSP::Biquad::Internal::Form::Direct1>::process(const Type in, const Audio::DB outGain, float * const regs) noexcept
 {
-    float out = _coefs.b[0] * in + _coefs.b[1] * _regs[0] + _coefs.b[2] * _regs[1] -
-                _coefs.a[1] * _regs[2] - _coefs.a[2] * _regs[3];
+    float out = _coefs.b[0] * in + _coefs.b[1] * regs[0] + _coefs.b[2] * regs[1] -
+                _coefs.a[1] * regs[2] - _coefs.a[2] * regs[3];
 
     // Shift registers
-    _regs[1] = _regs[0];
-    _regs[0] = in;
-    _regs[3] = _regs[2];
-    _regs[2] = out;
+    regs[1] = regs[0];
+    regs[0] = in;
+    regs[3] = regs[2];
+    regs[2] = out;
     return out * outGain;
 }
 
 template<>
 template<typename Type>
-void Audio::DSP::Biquad::Filter<Audio::DSP::Biquad::Internal::Form::Direct1>::filterBlock(const Type *input, const std::size_t inputSize, Type *output, const Audio::DB outGain) noexcept
+void Audio::DSP::Biquad::Filter<Audio::DSP::Biquad::Internal::Form::Direct1>::filterBlock(const Type *input, const std::size_t inputSize, Type *output, const Audio::DB outGain, const Audio::Channel channel) noexcept
 {
+    auto * const regs = _regs[static_cast<std::size_t>(channel)];
+
     for (auto i = 0ul; i < inputSize; ++i) {
-        *output++ = process(input[i], outGain);
+        *output++ = process(input[i], outGain, regs);
     }
 }
 
 template<>
 template<>
-inline float Audio::DSP::Biquad::Filter<Audio::DSP::Biquad::Internal::Form::Transposed2>::process(const float in, const Audio::DB outGain) noexcept
+inline float Audio::DSP::Biquad::Filter<Audio::DSP::Biquad::Internal::Form::Transposed2>::process(const float in, const Audio::DB outGain, float * const regs) noexcept
 {
-    const float out = in * _coefs.a[0] + _regs[0];
+    const float out = in * _coefs.b[0] + regs[0];
 
     // return out;
-    _regs[0] = in * _coefs.a[1] + _regs[1] - _coefs.b[1] * out;
-    _regs[1] = in * _coefs.a[2] - _coefs.b[2] * out;
+    regs[0] = in * _coefs.b[1] + regs[1] - _coefs.a[1] * out;
+    regs[1] = in * _coefs.b[2] - _coefs.a[2] * out;
     return out * outGain;
 }
 
@@ -61,14 +65,16 @@ inline float Audio::DSP::Biquad::Filter<Audio::DSP::Biquad::Internal::Form::Tran
 
 template<>
 template<>
-inline void Audio::DSP::Biquad::Filter<Audio::DSP::Biquad::Internal::Form::Transposed2>::filterBlock(const float *input, const std::size_t inputSize, float *output, const Audio::DB outGain) noexcept
+inline void Audio::DSP::Biquad::Filter<Audio::DSP::Biquad::Internal::Form::Transposed2>::filterBlock(const float *input, const std::size_t inputSize, float *output, const Audio::DB outGain, const Audio::Channel channel) noexcept
 {
+    auto * const regs = _regs[static_cast<std::size_t>(channel)];
+
     // process(input[0]);
     // process(input[1]);
     // len -= 2;
     // input += 2;
     for (auto i = 0ul; i < inputSize; ++i) {
-        *output++ = process(input[i], outGain);
+        *output++ = process(input[i], outGain, regs);
     }
     // *input = process(0.f);
     // ++input;
@@ -97,6 +103,17 @@ inline Audio::DSP::Biquad::Internal::Coefficients Audio::DSP::Biquad::GenerateCo
         return Internal::GenerateCoefficientsLowPass(specs.sampleRate, specs.cutoffs[0], specs.qFactor, specs.qAsBandWidth);
     case DSP::Filter::AdvancedType::HighPass:
         return Internal::GenerateCoefficientsHighPass(specs.sampleRate, specs.cutoffs[0], specs.qFactor, specs.qAsBandWidth);
+    case DSP::Filter::AdvancedType::BandPass:
+    case DSP::Filter::AdvancedType::BandPass2:
+        return Internal::GenerateCoefficientsBandPass(specs.sampleRate, specs.cutoffs[0], specs.qFactor, specs.qAsBandWidth);
+    case DSP::Filter::AdvancedType::BandStop:
+        return Internal::GenerateCoefficientsBandStop(specs.sampleRate, specs.cutoffs[0], specs.qFactor, specs.qAsBandWidth);
+    case DSP::Filter::AdvancedType::Peak:
+        return Internal::GenerateCoefficientsPeak(specs.sampleRate, specs.cutoffs[0], specs.gain, specs.qFactor, specs.qAsBandWidth);
+    case DSP::Filter::AdvancedType::LowShelf:
+        return Internal::GenerateCoefficientsLowShelf(specs.sampleRate, specs.cutoffs[0], specs.gain, specs.qFactor);
+    case DSP::Filter::AdvancedType::HighShelf:
+        return Internal::GenerateCoefficientsHighShelf(specs.sampleRate, specs.cutoffs[0], specs.gain, specs.qFactor);
     default:
         return Internal::GenerateCoefficientsLowPass(specs.sampleRate, specs.cutoffs[0], specs.qFactor, specs.qAsBandWidth);
     }
@@ -0,0 +1,79 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: Uniformly partitioned FFT convolution
+ */
+
+#pragma once
+
+#include <array>
+
+#include <Audio/Base.hpp>
+
+#include "FFT.hpp"
+
+namespace Audio::DSP::FIR::Internal
+{
+    template<typename Type>
+    class PartitionedConvolution;
+}
+
+/** @brief Overlap-save convolution with a frequency-domain delay line
+ *  The kernel is split in partitions of 'partitionSize' taps, each input block of the same size is transformed once
+ *  and multiplied with every partition spectrum, so the cost per sample grows with the partition count instead of the filter size.
+ *  Blocks are processed as soon as they are received, there is no added latency */
+template<typename Type>
+class Audio::DSP::FIR::Internal::PartitionedConvolution
+{
+public:
+    /** @brief Set the kernel to convolve with, its coefficients are ordered like the ones of the direct form
+     *  The delay lines are kept if the partitioning doesn't change */
+    void setKernel(const Type *coefficients, const std::uint32_t filterSize, const std::uint32_t partitionSize) noexcept;
+
+    /** @brief Get the partition size, 0 if no kernel is set */
+    [[nodiscard]] std::uint32_t partitionSize(void) const noexcept { return _partitionSize; }
+
+    /** @brief Check if a channel delay line matches the input history */
+    [[nodiscard]] bool isPrimed(const Channel channel) const noexcept { return _channels[static_cast<std::size_t>(channel)].primed; }
+
+    /** @brief Load the delay line of a channel from the last 'filterSize - 1' inputs (oldest first), null for silence */
+    void prime(const Type *history, const Channel channel) noexcept;
+
+    /** @brief Mark the delay line of a channel as outdated */
+    void invalidate(const Channel channel) noexcept { _channels[static_cast<std::size_t>(channel)].primed = false; }
+
+    /** @brief Mark the delay line of every channel as outdated */
+    void invalidate(void) noexcept { for (auto &state : _channels) state.primed = false; }
+
+    /** @brief Filter 'size' samples of a channel, which must be a multiple of the partition size */
+    void filter(const Type *input, const std::uint32_t size, Type *output, const Type outGain, const Channel channel) noexcept;
+
+private:
+    /** @brief Convolution state of a channel */
+    struct ChannelState
+    {
+        /** @brief Last two input blocks */
+        Core::TinyVector<Type> window {};
+        /** @brief Spectrums of the last 'partitionCount' windows */
+        Core::TinyVector<Type> delayLineReal {};
+        Core::TinyVector<Type> delayLineImag {};
+        std::uint32_t head { 0u };
+        bool primed { false };
+    };
+
+    RealFFT<Type> _fft {};
+    std::uint32_t _filterSize { 0u };
+    std::uint32_t _partitionSize { 0u };
+    std::uint32_t _partitionCount { 0u };
+    /** @brief Spectrums of the kernel partitions, normalized for the inverse transform */
+    Core::TinyVector<Type> _kernelReal {};
+    Core::TinyVector<Type> _kernelImag {};
+    Core::TinyVector<Type> _spectrumReal {};
+    Core::TinyVector<Type> _spectrumImag {};
+    Core::TinyVector<Type> _result {};
+    std::array<ChannelState, MaxChannelCount> _channels {};
+
+    /** @brief Transform the window of a channel into the current slot of its delay line */
+    void pushWindow(ChannelState &state) noexcept;
+};
+
+#include "Convolution.ipp"
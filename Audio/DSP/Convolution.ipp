@@ -0,0 +1,112 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: Uniformly partitioned FFT convolution implementation
+ */
+
+#include <algorithm>
+#include <cstring>
+
+template<typename Type>
+inline void Audio::DSP::FIR::Internal::PartitionedConvolution<Type>::setKernel(const Type *coefficients, const std::uint32_t filterSize, const std::uint32_t partitionSize) noexcept
+{
+    const auto partitionCount = (filterSize + partitionSize - 1u) / partitionSize;
+    const auto binCount = partitionSize + 1u;
+
+    if (partitionSize != _partitionSize || partitionCount != _partitionCount) {
+        _fft.init(2u * partitionSize);
+        _partitionSize = partitionSize;
+        _partitionCount = partitionCount;
+        _kernelReal.resize(partitionCount * binCount);
+        _kernelImag.resize(partitionCount * binCount);
+        _spectrumReal.resize(binCount);
+        _spectrumImag.resize(binCount);
+        _result.resize(2u * partitionSize);
+        for (auto &state : _channels) {
+            state.window.resize(2u * partitionSize);
+            state.delayLineReal.resize(partitionCount * binCount);
+            state.delayLineImag.resize(partitionCount * binCount);
+            state.primed = false;
+        }
+    }
+    _filterSize = filterSize;
+    // The direct form correlates the coefficients with the inputs, the impulse response is reversed
+    const auto scale = static_cast<Type>(1) / static_cast<Type>(partitionSize);
+    for (auto partition = 0u; partition < partitionCount; ++partition) {
+        std::fill(_result.begin(), _result.end(), Type {});
+        const auto begin = partition * partitionSize;
+        const auto end = std::min(begin + partitionSize, filterSize);
+        for (auto k = begin; k < end; ++k)
+            _result[k - begin] = coefficients[filterSize - 1u - k] * scale;
+        _fft.forward(_result.data(), _kernelReal.data() + partition * binCount, _kernelImag.data() + partition * binCount);
+    }
+}
+
+template<typename Type>
+inline void Audio::DSP::FIR::Internal::PartitionedConvolution<Type>::prime(const Type *history, const Channel channel) noexcept
+{
+    auto &state = _channels[static_cast<std::size_t>(channel)];
+    const auto historySize = _filterSize - 1u;
+    // Sample 'index' inputs before the next block, older samples only meet null taps
+    const auto past = [history, historySize](const std::uint32_t index) -> Type {
+        return history && index <= historySize ? history[historySize - index] : Type {};
+    };
+    // The window of the block received 'blockIndex' blocks ago
+    const auto loadWindow = [&](const std::uint32_t blockIndex) {
+        for (auto i = 0u; i < 2u * _partitionSize; ++i)
+            state.window[i] = past((blockIndex + 1u) * _partitionSize - i);
+    };
+
+    // Replay the blocks which are still in the delay line, from the oldest one
+    state.head = 0u;
+    for (auto block = _partitionCount - 1u; block > 0u; --block) {
+        loadWindow(block);
+        pushWindow(state);
+        state.head = (state.head + 1u) % _partitionCount;
+    }
+    loadWindow(1u);
+    std::copy(state.window.begin() + _partitionSize, state.window.end(), state.window.begin());
+    state.primed = true;
+}
+
+template<typename Type>
+inline void Audio::DSP::FIR::Internal::PartitionedConvolution<Type>::filter(const Type *input, const std::uint32_t size, Type *output, const Type outGain, const Channel channel) noexcept
+{
+    auto &state = _channels[static_cast<std::size_t>(channel)];
+    const auto binCount = _partitionSize + 1u;
+
+    for (auto offset = 0u; offset < size; offset += _partitionSize) {
+        std::memcpy(state.window.data() + _partitionSize, input + offset, _partitionSize * sizeof(Type));
+        pushWindow(state);
+        // Multiply-accumulate every partition with the input spectrum of its delay
+        std::fill(_spectrumReal.begin(), _spectrumReal.end(), Type {});
+        std::fill(_spectrumImag.begin(), _spectrumImag.end(), Type {});
+        Type * const spectrumReal = _spectrumReal.data();
+        Type * const spectrumImag = _spectrumImag.data();
+        auto slot = state.head;
+        for (auto partition = 0u; partition < _partitionCount; ++partition) {
+            const Type * const kernelReal = _kernelReal.data() + partition * binCount;
+            const Type * const kernelImag = _kernelImag.data() + partition * binCount;
+            const Type * const delayedReal = state.delayLineReal.data() + slot * binCount;
+            const Type * const delayedImag = state.delayLineImag.data() + slot * binCount;
+            for (auto k = 0u; k < binCount; ++k) {
+                spectrumReal[k] += kernelReal[k] * delayedReal[k] - kernelImag[k] * delayedImag[k];
+                spectrumImag[k] += kernelReal[k] * delayedImag[k] + kernelImag[k] * delayedReal[k];
+            }
+            slot = slot ? slot - 1u : _partitionCount - 1u;
+        }
+        _fft.inverse(spectrumReal, spectrumImag, _result.data());
+        // Only the second half of the window is free of circular aliasing
+        for (auto i = 0u; i < _partitionSize; ++i)
+            output[offset + i] = _result[_partitionSize + i] * outGain;
+        state.head = (state.head + 1u) % _partitionCount;
+        std::memcpy(state.window.data(), state.window.data() + _partitionSize, _partitionSize * sizeof(Type));
+    }
+}
+
+template<typename Type>
+inline void Audio::DSP::FIR::Internal::PartitionedConvolution<Type>::pushWindow(ChannelState &state) noexcept
+{
+    const auto offset = state.head * (_partitionSize + 1u);
+
+    _fft.forward(state.window.data(), state.delayLineReal.data() + offset, state.delayLineImag.data() + offset);
+}
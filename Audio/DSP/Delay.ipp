@@ -18,9 +18,10 @@ inline void Audio::DSP::BasicDelay<Type>::reset(const AudioSpecs &audioSpecs, co
     _readIndex = 0u;
     _writeIndex = _delayTime;
 
-    _lastIn.resize(GetFormatByteLength(audioSpecs.format) * audioSpecs.processBlockSize, audioSpecs.sampleRate, audioSpecs.channelArrangement, audioSpecs.format);
+    // A delay line processes a single channel
+    _lastIn.resize(GetFormatByteLength(audioSpecs.format) * audioSpecs.processBlockSize, audioSpecs.sampleRate, ChannelArrangement::Mono, audioSpecs.format);
     _lastIn.clear();
-    _lastOut.resize(GetFormatByteLength(audioSpecs.format) * audioSpecs.processBlockSize, audioSpecs.sampleRate, audioSpecs.channelArrangement, audioSpecs.format);
+    _lastOut.resize(GetFormatByteLength(audioSpecs.format) * audioSpecs.processBlockSize, audioSpecs.sampleRate, ChannelArrangement::Mono, audioSpecs.format);
     _lastOut.clear();
 }
 
@@ -0,0 +1,131 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: Runtime selection of the DSP kernels matching the host CPU
+ */
+
+#include <atomic>
+#include <initializer_list>
+
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+# include <intrin.h>
+#endif
+
+#include "Dispatch.hpp"
+
+using namespace Audio::DSP::Simd;
+
+namespace
+{
+    /** @brief Selected kernels, null until the first use */
+    std::atomic<const KernelTable *> SelectedKernels { nullptr };
+
+    /** @brief Get the kernels of an instruction set, null if they are not compiled in */
+    const KernelTable *GetKernels(const InstructionSet instructionSet) noexcept
+    {
+        switch (instructionSet) {
+        case InstructionSet::SSE2:
+            return Internal::GetSSE2Kernels();
+        case InstructionSet::AVX2:
+            return Internal::GetAVX2Kernels();
+        case InstructionSet::AVX512:
+            return Internal::GetAVX512Kernels();
+        case InstructionSet::NEON:
+            return Internal::GetNEONKernels();
+        default:
+            return Internal::GetScalarKernels();
+        }
+    }
+
+    /** @brief Get the best kernels supported by the host CPU */
+    const KernelTable *SelectKernels(void) noexcept
+    {
+        for (const auto instructionSet : { InstructionSet::AVX512, InstructionSet::AVX2, InstructionSet::SSE2, InstructionSet::NEON }) {
+            if (IsSupported(instructionSet))
+                return GetKernels(instructionSet);
+        }
+        return Internal::GetScalarKernels();
+    }
+}
+
+InstructionSet Audio::DSP::Simd::DetectInstructionSet(void) noexcept
+{
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+# if defined(_MSC_VER) && !defined(__clang__)
+    int info[4] {};
+    __cpuid(info, 0);
+    const auto maxLeaf = info[0];
+    __cpuid(info, 1);
+    const bool sse2 = info[3] & (1 << 26);
+    const bool avx = info[2] & (1 << 28);
+    const bool fma = info[2] & (1 << 12);
+    // The OS must save the vector registers on context switches
+    const bool osxsave = info[2] & (1 << 27);
+    const auto xcr0 = osxsave ? _xgetbv(0) : 0u;
+    bool avx2 = false, avx512 = false;
+    if (maxLeaf >= 7 && avx && (xcr0 & 0x6) == 0x6) {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) && fma;
+        avx512 = avx2 && (info[1] & (1 << 16)) && (xcr0 & 0xE6) == 0xE6;
+    }
+# else
+    __builtin_cpu_init();
+    const bool sse2 = __builtin_cpu_supports("sse2");
+    // The AVX2 and AVX512 kernels are built with FMA enabled
+    const bool avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    const bool avx512 = avx2 && __builtin_cpu_supports("avx512f");
+# endif
+    if (avx512)
+        return InstructionSet::AVX512;
+    if (avx2)
+        return InstructionSet::AVX2;
+    if (sse2)
+        return InstructionSet::SSE2;
+    return InstructionSet::Scalar;
+#elif defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+    return InstructionSet::NEON;
+#else
+    return InstructionSet::Scalar;
+#endif
+}
+
+bool Audio::DSP::Simd::IsSupported(const InstructionSet instructionSet) noexcept
+{
+    static const InstructionSet Detected = DetectInstructionSet();
+
+    if (!GetKernels(instructionSet))
+        return false;
+    switch (instructionSet) {
+    case InstructionSet::Scalar:
+        return true;
+    case InstructionSet::NEON:
+        return Detected == InstructionSet::NEON;
+    default:
+        // x86 instruction sets are supersets of each other
+        return Detected != InstructionSet::NEON && static_cast<std::uint8_t>(instructionSet) <= static_cast<std::uint8_t>(Detected);
+    }
+}
+
+const KernelTable &Audio::DSP::Simd::Kernels(void) noexcept
+{
+    auto *kernels = SelectedKernels.load(std::memory_order_acquire);
+
+    // Concurrent first uses select the same kernels
+    if (!kernels) {
+        kernels = SelectKernels();
+        SelectedKernels.store(kernels, std::memory_order_release);
+    }
+    return *kernels;
+}
+
+bool Audio::DSP::Simd::ForceInstructionSet(const InstructionSet instructionSet) noexcept
+{
+    if (!IsSupported(instructionSet))
+        return false;
+    SelectedKernels.store(GetKernels(instructionSet), std::memory_order_release);
+    return true;
+}
+
+void Audio::DSP::Simd::ResetInstructionSet(void) noexcept
+{
+    SelectedKernels.store(SelectKernels(), std::memory_order_release);
+}
@@ -0,0 +1,73 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: Runtime selection of the DSP kernels matching the host CPU
+ */
+
+#pragma once
+
+#include "Simd.hpp"
+
+namespace Audio::DSP::Simd
+{
+    /** @brief Merge kernel signature, see DSP::Internal::MergeGroup */
+    using MergeGroupFunc = void(*)(const float * const *inputs, const std::size_t inputCount, float *output, const std::size_t size,
+            const float ratio, const bool accumulate, const bool scale) noexcept;
+
+    /** @brief FIR dot products kernel signature, see Simd::Convolve */
+    using ConvolveFunc = void(*)(const float *samples, const float *coefficients, const std::size_t filterSize, float *output, const std::size_t outputSize,
+            const float gain) noexcept;
+
+    /** @brief Serial biquad cascade kernel signature, see Simd::BiquadCascade */
+    using BiquadCascadeFunc = void(*)(const float *coefficients, float *registers, const std::size_t stride, const std::size_t sectionCount,
+            const float *input, float *output, const std::size_t size) noexcept;
+
+    /** @brief Parallel biquad bank kernel signature, see Simd::BiquadBank */
+    using BiquadBankFunc = void(*)(const float *coefficients, float *registers, const std::size_t stride, const std::size_t sectionCount,
+            const float * const *inputs, float * const *outputs, const std::size_t filterCount, const std::size_t size) noexcept;
+
+    /** @brief Gain buffer kernel signature, see Simd::MultiplyGains */
+    using MultiplyGainsFunc = void(*)(const float *input, const float *gains, float *output, const std::size_t size,
+            const float gain, const bool accumulate) noexcept;
+
+    /** @brief Phase modulated sine kernel signature, see Simd::ModulatedSine */
+    using ModulatedSineFunc = void(*)(float *output, const float *gains, const float *modulation, const float modulationScale,
+            const double phase, const double increment, const std::size_t size, const bool accumulate) noexcept;
+
+    /** @brief Kernels compiled for a single instruction set */
+    struct KernelTable
+    {
+        InstructionSet instructionSet { InstructionSet::Scalar };
+        MergeGroupFunc mergeGroup { nullptr };
+        ConvolveFunc convolve { nullptr };
+        BiquadCascadeFunc biquadCascade { nullptr };
+        BiquadBankFunc biquadBank { nullptr };
+        MultiplyGainsFunc multiplyGains { nullptr };
+        ModulatedSineFunc modulatedSine { nullptr };
+    };
+
+    /** @brief Detect the widest instruction set supported by the host CPU */
+    [[nodiscard]] InstructionSet DetectInstructionSet(void) noexcept;
+
+    /** @brief Check if the kernels of an instruction set are compiled in and supported by the host CPU */
+    [[nodiscard]] bool IsSupported(const InstructionSet instructionSet) noexcept;
+
+    /** @brief Get the selected kernels, the best supported ones are selected on first use */
+    [[nodiscard]] const KernelTable &Kernels(void) noexcept;
+
+    /** @brief Force the kernels of an instruction set (for testing)
+     *  @return false if the instruction set is not supported, the selection is left unchanged */
+    bool ForceInstructionSet(const InstructionSet instructionSet) noexcept;
+
+    /** @brief Select the best supported kernels again */
+    void ResetInstructionSet(void) noexcept;
+
+    namespace Internal
+    {
+        /** @brief Get the kernels of an instruction set, null if they are not compiled for this architecture */
+        [[nodiscard]] const KernelTable *GetScalarKernels(void) noexcept;
+        [[nodiscard]] const KernelTable *GetSSE2Kernels(void) noexcept;
+        [[nodiscard]] const KernelTable *GetAVX2Kernels(void) noexcept;
+        [[nodiscard]] const KernelTable *GetAVX512Kernels(void) noexcept;
+        [[nodiscard]] const KernelTable *GetNEONKernels(void) noexcept;
+    }
+}
@@ -10,6 +10,7 @@
 
 #include <Audio/Base.hpp>
 
+#include <algorithm>
 #include <iostream>
 
 namespace Audio::DSP
@@ -115,6 +116,16 @@ public:
             const float sustain, const float release,
             const SampleRate sampleRate) noexcept;
 
+    /** @brief Render 'size' consecutive enveloppe gains starting at 'index'
+     *  Each segment of the enveloppe is filled as a whole ramp, the gains are the same than successive getGain calls */
+    template<unsigned Index = 0u>
+    void getGains(
+            const Key key, const std::uint32_t index, float *gains, const std::uint32_t size,
+            const float delay, const float attack,
+            const float hold, const float decay,
+            const float sustain, const float release,
+            const SampleRate sampleRate) noexcept;
+
     /** @brief AR implementation */
     template<unsigned Index = 0u>
     [[nodiscard]] float attackRelease(
@@ -133,10 +144,34 @@ public:
             const Key key, const std::uint32_t index,
             const float attack, const float decay, const float sustain, const float release, const SampleRate sampleRate) noexcept;
 
+    /** @brief AR block implementation */
+    template<unsigned Index = 0u>
+    void attackReleaseBlock(
+            const Key key, const std::uint32_t index, float *gains, const std::uint32_t size,
+            const float attack, const float release, const SampleRate sampleRate) noexcept;
+
+    /** @brief AD block implementation */
+    template<unsigned Index = 0u>
+    void attackDecayBlock(
+            const Key key, const std::uint32_t index, float *gains, const std::uint32_t size,
+            const float attack, const float decay, const SampleRate sampleRate) noexcept;
+
+    /** @brief ADSR block implementation */
+    template<unsigned Index = 0u>
+    void adsrBlock(
+            const Key key, const std::uint32_t index, float *gains, const std::uint32_t size,
+            const float attack, const float decay, const float sustain, const float release, const SampleRate sampleRate) noexcept;
+
 private:
     CacheList _cache;
 
-    [[nodiscard]] float smoothGain(KeyCache &keyCache, const float nextGain, const SampleRate sampleRate) noexcept;
+    /** @brief Fill the gains of the indexes [from, to[ using a ramp functor, returns the end of the filled range */
+    template<typename Functor>
+    [[nodiscard]] static float *FillSegment(float *gains, const std::uint32_t from, const std::uint32_t to, Functor &&functor) noexcept;
+
+    /** @brief Get the first index of the release part of a block starting at 'index' */
+    [[nodiscard]] static std::uint32_t GetReleaseBegin(const KeyCache &keyCache, const std::uint32_t index, const std::uint32_t end) noexcept
+        { return keyCache.triggerIndex ? std::min(std::max(keyCache.triggerIndex, index), end) : end; }
 };
 
 #include "EnvelopeGenerator.ipp"
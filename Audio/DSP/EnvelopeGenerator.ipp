@@ -164,6 +164,30 @@ inline float Audio::DSP::EnvelopeBase<Envelope, Count>::getGain(
     return 0.0f;
 }
 
+template<Audio::DSP::EnvelopeType Envelope, unsigned Count>
+template<unsigned Index>
+inline void Audio::DSP::EnvelopeBase<Envelope, Count>::getGains(
+        const Key key, const std::uint32_t index, float *gains, const std::uint32_t size,
+        const float delay, const float attack,
+        const float hold, const float decay,
+        const float sustain, const float release,
+        const SampleRate sampleRate) noexcept
+{
+    static_assert(Index < Count,
+        "Audio::DSP::EnvelopeBase::getGains: Index must be less than Instance Count");
+
+    UNUSED(delay);
+    UNUSED(hold);
+    if constexpr (Envelope == EnvelopeType::AR)
+        attackReleaseBlock<Index>(key, index, gains, size, (attack >= EnvelopeMinTimeStepUp ? attack : EnvelopeMinTimeStepUp), (release >= EnvelopeMinTimeStepDown ? release : EnvelopeMinTimeStepDown), sampleRate);
+    else if constexpr (Envelope == EnvelopeType::AD)
+        attackDecayBlock<Index>(key, index, gains, size, (attack >= EnvelopeMinTimeStepUp ? attack : EnvelopeMinTimeStepUp), (decay >= EnvelopeMinTimeStepDown ? decay : EnvelopeMinTimeStepDown), sampleRate);
+    else if constexpr (Envelope == EnvelopeType::ADSR)
+        adsrBlock<Index>(key, index, gains, size, (attack >= EnvelopeMinTimeStepUp ? attack : EnvelopeMinTimeStepUp), (decay >= EnvelopeMinTimeStepDown ? decay : EnvelopeMinTimeStepDown), sustain, (release >= EnvelopeMinTimeStepDown ? release : EnvelopeMinTimeStepDown), sampleRate);
+    else
+        std::fill_n(gains, size, 0.0f);
+}
+
 template<Audio::DSP::EnvelopeType Envelope, unsigned Count>
 template<unsigned Index>
 inline float Audio::DSP::EnvelopeBase<Envelope, Count>::attackRelease(
@@ -208,12 +232,16 @@ inline float Audio::DSP::EnvelopeBase<Envelope, Count>::attackDecay(
     auto &keyCache = _cache[key][Index];
 
     if (!keyCache.triggerIndex || (index < keyCache.triggerIndex)) {
-        const std::uint32_t attackIdx = attack * static_cast<float>(sampleRate);
-        if (attackIdx >= index) {
+        const std::uint32_t attackIdx = static_cast<std::uint32_t>(attack * static_cast<float>(sampleRate));
+        // Attack
+        if (index < attackIdx)
             outGain = static_cast<float>(index) / static_cast<float>(attackIdx);
-        }
-        if (const std::uint32_t decayIdx = decay * static_cast<float>(sampleRate); index < decayIdx + attackIdx)
+        // Decay
+        else if (const std::uint32_t decayIdx = static_cast<std::uint32_t>(decay * static_cast<float>(sampleRate)); index < decayIdx + attackIdx)
             outGain = 1.0f - static_cast<float>(index - attackIdx) / static_cast<float>(decayIdx);
+        // End of the enveloppe
+        else
+            outGain = 0.0f;
     } else {
         outGain = 0.0f;
     }
@@ -279,27 +307,138 @@ inline float Audio::DSP::EnvelopeBase<Envelope, Count>::adsr(
     }
     // if (outGain && outGain != 1.0f)
     //     std::cout << outGain << std::endl;
-    return smoothGain(keyCache, outGain, sampleRate);
+    keyCache.gain = outGain;
+    return outGain;
 }
 
 template<Audio::DSP::EnvelopeType Envelope, unsigned Count>
-inline float Audio::DSP::EnvelopeBase<Envelope, Count>::smoothGain(KeyCache &keyCache, const float nextGain, const SampleRate sampleRate) noexcept
+template<typename Functor>
+inline float *Audio::DSP::EnvelopeBase<Envelope, Count>::FillSegment(float *gains, const std::uint32_t from, const std::uint32_t to, Functor &&functor) noexcept
+{
+    // Signed indexes let the int to float conversion vectorize
+    const auto count = static_cast<std::int32_t>(to > from ? to - from : 0u);
+
+    for (std::int32_t i = 0; i < count; ++i)
+        gains[i] = functor(static_cast<std::int32_t>(from) + i);
+    return gains + count;
+}
+
+template<Audio::DSP::EnvelopeType Envelope, unsigned Count>
+template<unsigned Index>
+inline void Audio::DSP::EnvelopeBase<Envelope, Count>::attackReleaseBlock(
+        const Key key, const std::uint32_t index, float *gains, const std::uint32_t size,
+        const float attack, const float release, const SampleRate sampleRate) noexcept
 {
-    // time * sampleRate = samples
-    // gainStep = 1/samples <=> samples = 1/gainStep
-    //
-    // const auto dt = (nextGain - keyCache.gain);
-
-    // if (!dt) {
-    //     keyCache.gain = nextGain;
-    // } else if (auto step = 1.0f / dt * static_cast<float>(sampleRate); step < -EnvelopeMinTimeStepDown) {
-    //     // Go down (1 -> 0)
-    //     keyCache.gain = nextGain + (dt / 2.0f);
-    // } else if (step > EnvelopeMinTimeStepUp) {
-    //     // Go up (0 -> 1)
-    //     keyCache.gain = nextGain;
-    // }
-    UNUSED(sampleRate);
-    keyCache.gain = nextGain;
-    return keyCache.gain;
+    static_assert(Index < Count,
+        "Audio::DSP::EnvelopeBase::attackReleaseBlock: Index must be less than Instance Count");
+
+    if (!size)
+        return;
+    const std::uint32_t attackIdx = static_cast<std::uint32_t>(attack * static_cast<float>(sampleRate));
+    const std::uint32_t releaseIdx = static_cast<std::uint32_t>(release * static_cast<float>(sampleRate));
+    const std::uint32_t end = index + size;
+    auto &keyCache = _cache[key][Index];
+    const auto releaseBegin = GetReleaseBegin(keyCache, index, end);
+    const auto attackEnd = std::min(releaseBegin, std::max(attackIdx, index));
+    const auto releaseEnd = std::min(end, std::max(keyCache.triggerIndex + releaseIdx, releaseBegin));
+    auto *out = gains;
+
+    // Attack
+    out = FillSegment(out, index, attackEnd, [attackIdx](const std::int32_t i) {
+        return static_cast<float>(i) / static_cast<float>(attackIdx);
+    });
+    // Sustain
+    out = FillSegment(out, attackEnd, releaseBegin, [](const std::int32_t) { return 1.0f; });
+    // Release
+    out = FillSegment(out, releaseBegin, releaseEnd, [releaseIdx, triggerIndex = static_cast<std::int32_t>(keyCache.triggerIndex)](const std::int32_t i) {
+        return 1.0f - static_cast<float>(i - triggerIndex) / static_cast<float>(releaseIdx);
+    });
+    // End of the enveloppe
+    std::fill(out, gains + size, 0.0f);
+    keyCache.gain = gains[size - 1u];
+}
+
+template<Audio::DSP::EnvelopeType Envelope, unsigned Count>
+template<unsigned Index>
+inline void Audio::DSP::EnvelopeBase<Envelope, Count>::attackDecayBlock(
+        const Key key, const std::uint32_t index, float *gains, const std::uint32_t size,
+        const float attack, const float decay, const SampleRate sampleRate) noexcept
+{
+    static_assert(Index < Count,
+        "Audio::DSP::EnvelopeBase::attackDecayBlock: Index must be less than Instance Count");
+
+    if (!size)
+        return;
+    const std::uint32_t attackIdx = static_cast<std::uint32_t>(attack * static_cast<float>(sampleRate));
+    const std::uint32_t decayIdx = static_cast<std::uint32_t>(decay * static_cast<float>(sampleRate));
+    const std::uint32_t end = index + size;
+    auto &keyCache = _cache[key][Index];
+    const auto releaseBegin = GetReleaseBegin(keyCache, index, end);
+    const auto attackEnd = std::min(releaseBegin, std::max(attackIdx, index));
+    const auto decayEnd = std::min(releaseBegin, std::max(attackIdx + decayIdx, attackEnd));
+    auto *out = gains;
+
+    // Attack
+    out = FillSegment(out, index, attackEnd, [attackIdx](const std::int32_t i) {
+        return static_cast<float>(i) / static_cast<float>(attackIdx);
+    });
+    // Decay
+    out = FillSegment(out, attackEnd, decayEnd, [attackIdx = static_cast<std::int32_t>(attackIdx), decayIdx](const std::int32_t i) {
+        return 1.0f - static_cast<float>(i - attackIdx) / static_cast<float>(decayIdx);
+    });
+    // End of the enveloppe & release
+    std::fill(out, gains + size, 0.0f);
+    keyCache.gain = gains[size - 1u];
+}
+
+template<Audio::DSP::EnvelopeType Envelope, unsigned Count>
+template<unsigned Index>
+inline void Audio::DSP::EnvelopeBase<Envelope, Count>::adsrBlock(
+        const Key key, const std::uint32_t index, float *gains, const std::uint32_t size,
+        const float attack, const float decay, const float sustain, const float release, const SampleRate sampleRate) noexcept
+{
+    static_assert(Index < Count,
+        "Audio::DSP::EnvelopeBase::adsrBlock: Index must be less than Instance Count");
+
+    if (!size)
+        return;
+    const float OneMinusSustain = 1.0f - sustain;
+    const std::uint32_t attackIdx = static_cast<std::uint32_t>(attack * static_cast<float>(sampleRate));
+    const std::uint32_t decayIdx = static_cast<std::uint32_t>(decay * static_cast<float>(sampleRate));
+    const std::uint32_t releaseIdx = static_cast<std::uint32_t>(release * static_cast<float>(sampleRate));
+    const std::uint32_t end = index + size;
+    auto &keyCache = _cache[key][Index];
+    const auto releaseBegin = GetReleaseBegin(keyCache, index, end);
+    const auto attackEnd = std::min(releaseBegin, std::max(attackIdx, index));
+    const auto decayEnd = std::min(releaseBegin, std::max(attackIdx + decayIdx, attackEnd));
+    const auto releaseEnd = std::min(end, std::max(keyCache.triggerIndex + releaseIdx, releaseBegin));
+    auto *out = gains;
+
+    // Attack
+    out = FillSegment(out, index, attackEnd, [attackIdx, offset = keyCache.sustain](const std::int32_t i) {
+        return offset + static_cast<float>(i) / static_cast<float>(attackIdx);
+    });
+    // Decay, sustain max -> no decay
+    out = FillSegment(out, attackEnd, decayEnd, [attackIdx = static_cast<std::int32_t>(attackIdx), decayIdx, sustain, OneMinusSustain](const std::int32_t i) {
+        return sustain == 1.0f ? 1.0f : (1.0f - static_cast<float>(i - attackIdx) / static_cast<float>(decayIdx)) * OneMinusSustain + sustain;
+    });
+    // Sustain
+    if (decayEnd < releaseBegin) {
+        keyCache.sustain = 0.0f;
+        out = FillSegment(out, decayEnd, releaseBegin, [sustain](const std::int32_t) { return sustain; });
+    }
+    // Release from the gain reached before the note off
+    if (releaseBegin < releaseEnd) {
+        if (!keyCache.sustain)
+            keyCache.sustain = out != gains ? out[-1] : keyCache.gain;
+        out = FillSegment(out, releaseBegin, releaseEnd, [releaseIdx, triggerIndex = static_cast<std::int32_t>(keyCache.triggerIndex), from = keyCache.sustain](const std::int32_t i) {
+            return (1.0f - static_cast<float>(i - triggerIndex) / static_cast<float>(releaseIdx)) * from;
+        });
+    }
+    // End of the enveloppe
+    if (releaseEnd < end) {
+        keyCache.sustain = 0.0f;
+        std::fill(out, gains + size, 0.0f);
+    }
+    keyCache.gain = gains[size - 1u];
 }
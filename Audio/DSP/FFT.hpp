@@ -0,0 +1,66 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: Real FFT
+ */
+
+#pragma once
+
+#include <Core/Vector.hpp>
+
+#include <Audio/Math.hpp>
+
+namespace Audio::DSP
+{
+    template<typename Type>
+    class RealFFT;
+}
+
+/** @brief Radix-2 FFT of real signals, computed through a complex FFT of half the size
+ *  A transform of 'size' samples produces 'size / 2 + 1' bins, the other ones are conjugate symmetric.
+ *  Complex values are stored as separate real and imaginary arrays, which keeps every loop vectorizable */
+template<typename Type>
+class Audio::DSP::RealFFT
+{
+public:
+    /** @brief Default constructor, 'init' must be called before any transform */
+    RealFFT(void) noexcept = default;
+
+    /** @brief Init constructor */
+    RealFFT(const std::uint32_t size) noexcept { init(size); }
+
+    /** @brief Prepare the tables of a transform size, which must be a power of two of at least 4 */
+    void init(const std::uint32_t size) noexcept;
+
+    /** @brief Get the transform size */
+    [[nodiscard]] std::uint32_t size(void) const noexcept { return _size; }
+
+    /** @brief Get the number of bins of a transform */
+    [[nodiscard]] std::uint32_t binCount(void) const noexcept { return _size / 2u + 1u; }
+
+    /** @brief Transform 'size' real samples into 'binCount' bins */
+    void forward(const Type *input, Type *real, Type *imag) noexcept;
+
+    /** @brief Transform 'binCount' bins into 'size' real samples
+     *  The output is not normalized, it is scaled by 'size / 2' */
+    void inverse(const Type *real, const Type *imag, Type *output) noexcept;
+
+private:
+    std::uint32_t _size { 0u };
+    /** @brief Bit reversal permutation of the half size complex transform */
+    Core::TinyVector<std::uint32_t> _reversed {};
+    /** @brief Twiddles of the half size complex transform, stored per stage */
+    Core::TinyVector<Type> _twiddleReal {};
+    Core::TinyVector<Type> _twiddleImag {};
+    /** @brief Twiddles used to split the half size transform into the real one */
+    Core::TinyVector<Type> _splitReal {};
+    Core::TinyVector<Type> _splitImag {};
+    /** @brief Working buffer of the half size transform */
+    Core::TinyVector<Type> _bufferReal {};
+    Core::TinyVector<Type> _bufferImag {};
+
+    /** @brief In-place complex transform of the working buffer, already bit reversed */
+    template<bool Inverse>
+    void transform(void) noexcept;
+};
+
+#include "FFT.ipp"
@@ -0,0 +1,122 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: Real FFT implementation
+ */
+
+template<typename Type>
+inline void Audio::DSP::RealFFT<Type>::init(const std::uint32_t size) noexcept
+{
+    if (_size == size)
+        return;
+    const auto half = size / 2u;
+    auto bits = 0u;
+    while ((1u << bits) < half)
+        ++bits;
+
+    _size = size;
+    _reversed.resize(half);
+    for (auto i = 0u; i < half; ++i) {
+        std::uint32_t reversed = 0u;
+        for (auto bit = 0u; bit < bits; ++bit)
+            reversed |= ((i >> bit) & 1u) << (bits - 1u - bit);
+        _reversed[i] = reversed;
+    }
+    // The twiddles of a stage of 'span' butterflies start at index 'span - 1', so each stage reads them contiguously
+    _twiddleReal.resize(half);
+    _twiddleImag.resize(half);
+    for (auto span = 1u; span < half; span *= 2u) {
+        for (auto i = 0u; i < span; ++i) {
+            const auto angle = -M_PI * static_cast<double>(i) / static_cast<double>(span);
+            _twiddleReal[span - 1u + i] = static_cast<Type>(std::cos(angle));
+            _twiddleImag[span - 1u + i] = static_cast<Type>(std::sin(angle));
+        }
+    }
+    _splitReal.resize(half + 1u);
+    _splitImag.resize(half + 1u);
+    for (auto i = 0u; i <= half; ++i) {
+        const auto angle = -2.0 * M_PI * static_cast<double>(i) / static_cast<double>(size);
+        _splitReal[i] = static_cast<Type>(std::cos(angle));
+        _splitImag[i] = static_cast<Type>(std::sin(angle));
+    }
+    _bufferReal.resize(half);
+    _bufferImag.resize(half);
+}
+
+template<typename Type>
+inline void Audio::DSP::RealFFT<Type>::forward(const Type *input, Type *real, Type *imag) noexcept
+{
+    const auto half = _size / 2u;
+
+    // Even samples are packed as the real part and odd ones as the imaginary part
+    for (auto i = 0u; i < half; ++i) {
+        _bufferReal[_reversed[i]] = input[2u * i];
+        _bufferImag[_reversed[i]] = input[2u * i + 1u];
+    }
+    transform<false>();
+    real[0] = _bufferReal[0] + _bufferImag[0];
+    imag[0] = 0;
+    real[half] = _bufferReal[0] - _bufferImag[0];
+    imag[half] = 0;
+    for (auto k = 1u; k < half; ++k) {
+        // Z[k] and conj(Z[half - k]) hold the spectrums of the even and odd samples
+        const auto zr = _bufferReal[k], zi = _bufferImag[k];
+        const auto mr = _bufferReal[half - k], mi = -_bufferImag[half - k];
+        const auto evenReal = (zr + mr) * static_cast<Type>(0.5), evenImag = (zi + mi) * static_cast<Type>(0.5);
+        const auto oddReal = (zi - mi) * static_cast<Type>(0.5), oddImag = (mr - zr) * static_cast<Type>(0.5);
+        real[k] = evenReal + _splitReal[k] * oddReal - _splitImag[k] * oddImag;
+        imag[k] = evenImag + _splitReal[k] * oddImag + _splitImag[k] * oddReal;
+    }
+}
+
+template<typename Type>
+inline void Audio::DSP::RealFFT<Type>::inverse(const Type *real, const Type *imag, Type *output) noexcept
+{
+    const auto half = _size / 2u;
+
+    // Rebuild the spectrums of the even and odd samples, then pack them into the half size transform
+    for (auto k = 0u; k < half; ++k) {
+        const auto xr = real[k], xi = imag[k];
+        const auto mr = real[half - k], mi = -imag[half - k];
+        const auto evenReal = (xr + mr) * static_cast<Type>(0.5), evenImag = (xi + mi) * static_cast<Type>(0.5);
+        const auto diffReal = (xr - mr) * static_cast<Type>(0.5), diffImag = (xi - mi) * static_cast<Type>(0.5);
+        const auto oddReal = diffReal * _splitReal[k] + diffImag * _splitImag[k];
+        const auto oddImag = diffImag * _splitReal[k] - diffReal * _splitImag[k];
+        _bufferReal[_reversed[k]] = evenReal - oddImag;
+        _bufferImag[_reversed[k]] = evenImag + oddReal;
+    }
+    transform<true>();
+    for (auto i = 0u; i < half; ++i) {
+        output[2u * i] = _bufferReal[i];
+        output[2u * i + 1u] = _bufferImag[i];
+    }
+}
+
+template<typename Type>
+template<bool Inverse>
+inline void Audio::DSP::RealFFT<Type>::transform(void) noexcept
+{
+    const auto half = _size / 2u;
+    Type * const bufferReal = _bufferReal.data();
+    Type * const bufferImag = _bufferImag.data();
+
+    for (auto span = 1u; span < half; span *= 2u) {
+        const Type * const twiddleReal = _twiddleReal.data() + span - 1u;
+        const Type * const twiddleImag = _twiddleImag.data() + span - 1u;
+        for (auto begin = 0u; begin < half; begin += 2u * span) {
+            Type * const evenReal = bufferReal + begin;
+            Type * const evenImag = bufferImag + begin;
+            Type * const oddReal = evenReal + span;
+            Type * const oddImag = evenImag + span;
+            for (auto i = 0u; i < span; ++i) {
+                const auto wr = twiddleReal[i];
+                const auto wi = Inverse ? -twiddleImag[i] : twiddleImag[i];
+                const auto tr = oddReal[i] * wr - oddImag[i] * wi;
+                const auto ti = oddReal[i] * wi + oddImag[i] * wr;
+                oddReal[i] = evenReal[i] - tr;
+                oddImag[i] = evenImag[i] - ti;
+                evenReal[i] += tr;
+                evenImag[i] += ti;
+            }
+        }
+    }
+}
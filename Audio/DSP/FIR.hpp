@@ -10,7 +10,12 @@
 
 #include <Core/Vector.hpp>
 
+#include <Audio/Base.hpp>
+
 #include "Filter.hpp"
+#include "FilterDesigner.hpp"
+#include "Convolution.hpp"
+#include "Dispatch.hpp"
 
 namespace Audio::DSP::FIR
 {
@@ -29,6 +34,9 @@ namespace Audio::DSP::FIR
         /** @brief Instance with coefficients cache & lastInputCache */
         template<typename Type>
         class Instance;
+        /** @brief Pair of instances crossfading from a previous kernel to a new one */
+        template<typename Type>
+        class CrossfadeInstance;
         /** @brief Instance with multiple coefficients caches */
         template<unsigned InstanceCount, typename Type>
         class MultiInstance;
@@ -57,26 +65,103 @@ template<typename Type>
 class Audio::DSP::FIR::Internal::Instance
 {
 public:
-    /** @brief Perform filtering using convolution. */
+    /** @brief Filter size from which the partitioned convolution is faster than the direct form (see bench_FIR) */
+    static constexpr std::uint32_t PartitionedFilterSize = 128u;
+    /** @brief Bounds of the partition size of the partitioned convolution */
+    static constexpr std::uint32_t MinPartitionSize = 32u;
+    static constexpr std::uint32_t MaxPartitionSize = 512u;
+
+    /** @brief Get the partition size used to filter blocks of 'blockSize' samples, 0 if the direct form is used */
+    [[nodiscard]] static std::uint32_t GetPartitionSize(const std::uint32_t filterSize, const std::uint32_t blockSize) noexcept;
+
+    /** @brief Perform filtering using convolution, each channel keeps its own input history
+     *  Long filters are processed by the partitioned convolution when the block size allows it */
+    template<bool Accumulate>
+    VoidType<Type> filter(const Type *input, const std::uint32_t inputSize, Type *output, const Type outGain, const Channel channel = Channel::Mono) noexcept;
+
+    /** @brief Perform filtering using the direct form convolution */
+    template<bool Accumulate>
+    VoidType<Type> filterDirect(const Type *input, const std::uint32_t inputSize, Type *output, const Type outGain, const Channel channel = Channel::Mono) noexcept;
+
+    /** @brief Perform filtering using the partitioned convolution, 'inputSize' must be a multiple of 'partitionSize' */
     template<bool Accumulate>
-    VoidType<Type> filter(const Type *input, const std::uint32_t inputSize, Type *output, const Type outGain) noexcept;
+    VoidType<Type> filterPartitioned(const Type *input, const std::uint32_t inputSize, Type *output, const Type outGain,
+            const std::uint32_t partitionSize, const Channel channel = Channel::Mono) noexcept;
+
+    /** @brief Signal that the coefficients were modified, must be called after any change */
+    void onCoefficientsChanged(void) noexcept { _coefficientsChanged = true; }
 
     /** @brief Get the internal cache coefficients */
     [[nodiscard]] const Cache<Type> &coefficients(void) const noexcept { return _coefficients; }
     [[nodiscard]] Cache<Type> &coefficients(void) noexcept { return _coefficients; }
 
-    /** @brief Get the internal cache for the last input */
-    [[nodiscard]] const Cache<Type> &lastInput(void) const noexcept { return _lastInputCache; }
-    [[nodiscard]] Cache<Type> &lastInput(void) noexcept { return _lastInputCache; }
+    /** @brief Get the internal cache for the last input of a channel */
+    [[nodiscard]] const Cache<Type> &lastInput(const Channel channel = Channel::Mono) const noexcept { return _lastInputCaches[static_cast<std::size_t>(channel)]; }
+    [[nodiscard]] Cache<Type> &lastInput(const Channel channel = Channel::Mono) noexcept { return _lastInputCaches[static_cast<std::size_t>(channel)]; }
+
+    /** @brief Resize the last input cache of every channel */
+    void resizeLastInputs(const std::uint32_t size) noexcept { for (auto &cache : _lastInputCaches) cache.resize(size); _convolution.invalidate(); }
+    /** @brief Reset the last input cache of every channel */
+    void resetLastInputs(void) noexcept { for (auto &cache : _lastInputCaches) cache.clear(); _convolution.invalidate(); }
+    /** @brief Copy the last input cache of every channel from another instance
+     *  Only the most recent inputs fit a shorter history, the older ones missing from a longer history are silence */
+    void copyLastInputs(const Instance &other) noexcept;
+
+    /** @brief Set the coefficients and size every cache for blocks of 'blockSize' samples, so filtering them never allocates
+     *  The last inputs are resized but not copied */
+    template<typename CoefficientType>
+    void prepare(const Core::TinyVector<CoefficientType> &coefficients, const std::uint32_t blockSize) noexcept;
 
 private:
-    template<bool Accumulate>
-    ProcessType<Type> filterImpl(const Type *input, const std::uint32_t size, const std::uint32_t zeroPad = 0ul) noexcept;
+    /** @brief Save the last inputs of a block into the history of a channel */
+    void saveLastInput(const Type *input, const std::uint32_t inputSize, Cache<Type> &lastInputCache) noexcept;
 
     /** @brief Filter cache coefficients */
     Cache<Type> _coefficients;
-    /** @brief Last input cache used for block processing */
-    Cache<Type> _lastInputCache;
+    /** @brief Last input caches used for block processing, one per channel */
+    std::array<Cache<Type>, MaxChannelCount> _lastInputCaches;
+    /** @brief Partitioned convolution of long filters */
+    PartitionedConvolution<Type> _convolution;
+    /** @brief Contiguous history and input block of the direct form */
+    Cache<Type> _workspace;
+    bool _coefficientsChanged { true };
+};
+
+template<typename Type>
+class Audio::DSP::FIR::Internal::CrossfadeInstance
+{
+public:
+    /** @brief Get the instance holding the current kernel */
+    [[nodiscard]] Instance<Type> &current(void) noexcept { return _instances[_active]; }
+    [[nodiscard]] const Instance<Type> &current(void) const noexcept { return _instances[_active]; }
+
+    /** @brief Get both instances */
+    [[nodiscard]] std::array<Instance<Type>, 2u> &instances(void) noexcept { return _instances; }
+
+    /** @brief Get the inactive instance, sharing the input history of the current one, to write a new kernel into it */
+    [[nodiscard]] Instance<Type> &prepareNext(void) noexcept;
+
+    /** @brief Exchange the inactive instance with one prepared beforehand, then make it share the input history of the current one */
+    Instance<Type> &prepareNext(Instance<Type> &prepared) noexcept { std::swap(_instances[_active ^ 1u], prepared); return prepareNext(); }
+
+    /** @brief Make the prepared instance current, each channel crossfades to it during its next block */
+    void swap(void) noexcept { _active ^= 1u; _fading.fill(true); }
+
+    /** @brief Resize the last input cache of every channel */
+    void resizeLastInputs(const std::uint32_t size) noexcept { for (auto &instance : _instances) instance.resizeLastInputs(size); }
+    /** @brief Reset the last input cache of every channel */
+    void resetLastInputs(void) noexcept { for (auto &instance : _instances) instance.resetLastInputs(); _fading.fill(false); }
+
+    /** @brief Filter a channel with the current kernel, the block is crossfaded from the previous kernel after a swap */
+    template<bool Accumulate>
+    VoidType<Type> filter(const Type *input, const std::uint32_t inputSize, Type *output, const Type outGain, const Channel channel = Channel::Mono) noexcept;
+
+private:
+    std::array<Instance<Type>, 2u> _instances;
+    std::uint32_t _active { 0u };
+    /** @brief Channels which still need to crossfade from the previous kernel */
+    std::array<bool, MaxChannelCount> _fading {};
+    Cache<Type> _fadeCache;
 };
 
 template<unsigned InstanceCount, typename Type>
@@ -133,23 +218,48 @@ public:
     /** @brief Set the internal window type */
     bool setWindowType(const DSP::Filter::WindowType windowType) noexcept;
 
-    /** @brief Reset the internal last input cache */
-    void resetLastInputCache(void) noexcept { _instance.lastInput().clear(); }
-    /** @brief Resize the internal last input cache */
-    void resizeLastInputCache(const std::uint32_t size) noexcept { _instance.lastInput().resize(size); }
+    /** @brief Reset the internal last input caches */
+    void resetLastInputCache(void) noexcept { _instance.resetLastInputs(); }
+    /** @brief Resize the internal last input caches */
+    void resizeLastInputCache(const std::uint32_t size) noexcept { _instance.resizeLastInputs(size); }
+
+    /** @brief Check if the coefficients don't match the specs yet */
+    [[nodiscard]] bool isDesignPending(void) const noexcept { return _designPending; }
+
+    /** @brief Get the current coefficients */
+    [[nodiscard]] const Internal::Cache<Type> &coefficients(void) const noexcept { return _instance.current().coefficients(); }
 
-    /** @brief Call the filter instance */
+    /** @brief Call the filter instance on a channel
+     *  A design made in background since the last call is swapped in and crossfaded */
     template<bool Accumulate = false>
-    VoidType<Type> filter(const Type *input, const std::uint32_t inputSize, Type *output, const Type outGain = 1.0) noexcept { _instance.template filter<Accumulate>(input, inputSize, output, outGain); }
+    VoidType<Type> filter(const Type *input, const std::uint32_t inputSize, Type *output, const Type outGain = 1.0, const Channel channel = Channel::Mono) noexcept
+        { updateDesign(inputSize); _instance.template filter<Accumulate>(input, inputSize, output, outGain, channel); }
 
 private:
-    /** @brief Internal instance */
-    Internal::Instance<Type> _instance;
+    /** @brief Exchange area preparing a whole instance on the designer thread, whatever the order of the design */
+    struct DesignSlot final : public DSP::Filter::DesignSlot
+    {
+        /** @brief Instance of the designed coefficients, exchanged with the inactive one of the filter */
+        Internal::Instance<Type> instance {};
+        /** @brief Size of the blocks to prepare the instance for */
+        std::uint32_t blockSize { 0u };
+
+        void onDesigned(void) override { instance.prepare(coefficients, blockSize); }
+    };
+
+    /** @brief Internal instances */
+    Internal::CrossfadeInstance<Type> _instance;
     /** @brief Filter specs */
     DSP::Filter::FIRSpecs _specs;
+    /** @brief Exchange area with the background designer */
+    std::shared_ptr<DesignSlot> _slot { std::make_shared<DesignSlot>() };
+    bool _designPending { false };
+
+    /** @brief Request a new design when specs changed */
+    void onSpecChanged(void) noexcept { _designPending = true; }
 
-    /** @brief Compute cache when specs changed */
-    void onSpecChanged(void) noexcept;
+    /** @brief Swap a finished design in and request the pending one for blocks of 'blockSize' samples */
+    void updateDesign(const std::uint32_t blockSize) noexcept;
 };
 
 template<unsigned InstanceCount, typename Type>
@@ -184,31 +294,34 @@ public:
     /** @brief Set the internal sampleRate */
     bool setSampleRate(const float sampleRate) noexcept;
 
-    /** @brief Reset the internal last input cache */
-    void resetLastInputCache(void) noexcept { _instance.lastInput().clear(); }
+    /** @brief Reset the internal last input caches */
+    void resetLastInputCache(void) noexcept { _instance.resetLastInputs(); }
 
-    /** @brief Call the filter instance */
+    /** @brief Call the filter instance on a channel
+     *  The bands are linear and share the same order, so they are folded into a single kernel weighted by their gains.
+     *  When the gains change the kernel is rebuilt and the block is crossfaded from the previous kernel */
     template<bool Accumutale = false, typename GainType, std::uint32_t GainSize>
-    VoidType<Type> filter(const Type *input, const std::uint32_t inputSize, Type *output, const GainType(&gains)[GainSize]) noexcept;
+    VoidType<Type> filter(const Type *input, const std::uint32_t inputSize, Type *output, const GainType(&gains)[GainSize], const Channel channel = Channel::Mono) noexcept;
 
 private:
-    /** @brief Internal instance */
-    Internal::Instance<Type> _instance;
+    /** @brief Internal instances */
+    Internal::CrossfadeInstance<Type> _instance;
     /** @brief Filter specs */
     DSP::Filter::WindowType _windowType { DSP::Filter::WindowType::Hanning };
     float _sampleRate;
     std::uint32_t _filterOrder;
     Core::TinyVector<float> _gain;
+    /** @brief Unit gain coefficients of each band */
     Internal::CacheList<InstanceCount, Type> _coefficients;
 
     void reloadAll(void) noexcept;
-    void mergeToInstance(void) noexcept;
+    void mergeToInstance(Internal::Instance<Type> &instance) noexcept;
     void reloadLowPass(const float rootFreq, const float gain) noexcept;
     void reloadBandPass(const std::uint32_t filterIndex, const float rootFreq, const float gain) noexcept;
     void reloadHighPass(const float rootFreq, const float gain) noexcept;
 
-    /** @brief Resize the internal last input cache */
-    void resizeLastInputCache(const std::uint32_t size) noexcept { _instance.lastInput().resize(size); }
+    /** @brief Resize the internal last input caches */
+    void resizeLastInputCache(const std::uint32_t size) noexcept { _instance.resizeLastInputs(size); }
 };
 
 // template<unsigned InstanceCount, typename Type>
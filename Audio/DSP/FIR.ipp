@@ -6,41 +6,154 @@
  * @date 2021-04-22
  */
 
+template<typename Type>
+inline std::uint32_t Audio::DSP::FIR::Internal::Instance<Type>::GetPartitionSize(const std::uint32_t filterSize, const std::uint32_t blockSize) noexcept
+{
+    if (filterSize < PartitionedFilterSize)
+        return 0u;
+    // Partitions as long as the filter, but blocks must be split into whole partitions
+    auto partitionSize = MinPartitionSize;
+    while (partitionSize < filterSize && partitionSize < MaxPartitionSize)
+        partitionSize *= 2u;
+    partitionSize = std::min(partitionSize, blockSize & (~blockSize + 1u));
+    return partitionSize >= MinPartitionSize ? partitionSize : 0u;
+}
+
+template<typename Type>
+template<bool Accumulate>
+inline typename Audio::DSP::FIR::VoidType<Type> Audio::DSP::FIR::Internal::Instance<Type>::filter(const Type *input, const std::uint32_t inputSize, Type *output, const Type outGain, const Channel channel) noexcept
+{
+    const auto partitionSize = GetPartitionSize(static_cast<std::uint32_t>(_coefficients.size()), inputSize);
+
+    if (partitionSize)
+        filterPartitioned<Accumulate>(input, inputSize, output, outGain, partitionSize, channel);
+    else
+        filterDirect<Accumulate>(input, inputSize, output, outGain, channel);
+}
+
 template<typename Type>
 template<bool Accumulate>
-typename Audio::DSP::FIR::VoidType<Type> Audio::DSP::FIR::Internal::Instance<Type>::filter(const Type *input, const std::uint32_t inputSize, Type *output, const Type outGain) noexcept
+inline typename Audio::DSP::FIR::VoidType<Type> Audio::DSP::FIR::Internal::Instance<Type>::filterDirect(const Type *input, const std::uint32_t inputSize, Type *output, const Type outGain, const Channel channel) noexcept
 {
     const auto filterSize = static_cast<std::uint32_t>(_coefficients.size());
-    const auto filterSizeMinusOne = filterSize - 1;
+    const auto historySize = filterSize - 1u;
+    auto &lastInputCache = lastInput(channel);
 
-    // Begin
-    for (auto i = 0u; i < filterSizeMinusOne; ++i) {
-        output[i] = filterImpl<Accumulate>(input, filterSize, filterSizeMinusOne - i) * outGain;
-    }
-    // Body
-    const Type *inputShifted = input - filterSizeMinusOne;
-    for (auto i = filterSizeMinusOne; i < inputSize; ++i) {
-        output[i] = filterImpl<Accumulate>(inputShifted + i, filterSize) * outGain;
+    // The history is followed by the block so every output is a dot product of contiguous samples
+    _workspace.resize(historySize + inputSize);
+    std::memcpy(_workspace.data(), lastInputCache.data(), historySize * sizeof(Type));
+    std::memcpy(_workspace.data() + historySize, input, inputSize * sizeof(Type));
+    if constexpr (std::is_same_v<Type, float>) {
+        Simd::Kernels().convolve(_workspace.data(), _coefficients.data(), filterSize, output, inputSize, outGain);
+    } else {
+        for (auto i = 0u; i < inputSize; ++i) {
+            const Type *samples = _workspace.data() + i;
+            Type sample {};
+            for (auto k = 0u; k < filterSize; ++k)
+                sample += samples[k] * _coefficients[k];
+            output[i] = sample * outGain;
+        }
     }
-    // Save for last input
-    std::memcpy(_lastInputCache.data(), input + inputSize - filterSizeMinusOne, filterSizeMinusOne * sizeof(Type));
+    saveLastInput(input, inputSize, lastInputCache);
+    // The delay line of the partitioned convolution doesn't hold this block
+    _convolution.invalidate(channel);
 }
 
 template<typename Type>
 template<bool Accumulate>
-typename Audio::DSP::FIR::ProcessType<Type> Audio::DSP::FIR::Internal::Instance<Type>::filterImpl(const Type *input, const std::uint32_t size, const std::uint32_t zeroPad) noexcept
+inline typename Audio::DSP::FIR::VoidType<Type> Audio::DSP::FIR::Internal::Instance<Type>::filterPartitioned(const Type *input, const std::uint32_t inputSize, Type *output, const Type outGain,
+        const std::uint32_t partitionSize, const Channel channel) noexcept
 {
-    const std::uint32_t realSize = size - zeroPad;
-    const std::uint32_t realSizeMinusOne = realSize - 1;
-    Type sample {};
+    const auto filterSize = static_cast<std::uint32_t>(_coefficients.size());
+    auto &lastInputCache = lastInput(channel);
 
-    for (auto i = 0u; i < zeroPad; ++i) {
-        sample += _lastInputCache[realSizeMinusOne + i] * _coefficients[i];
+    // Kernel spectrums are only computed again when the coefficients or the partitioning changed
+    if (_coefficientsChanged || partitionSize != _convolution.partitionSize()) {
+        _convolution.setKernel(_coefficients.data(), filterSize, partitionSize);
+        _coefficientsChanged = false;
     }
-    for (auto i = 0u; i < realSize; ++i) {
-        sample += input[i] * _coefficients[zeroPad + i];
+    // The delay line is rebuilt from the history when the direct form was used in between
+    if (!_convolution.isPrimed(channel))
+        _convolution.prime(lastInputCache.size() + 1u == filterSize ? lastInputCache.data() : nullptr, channel);
+    _convolution.filter(input, inputSize, output, outGain, channel);
+    saveLastInput(input, inputSize, lastInputCache);
+}
+
+template<typename Type>
+inline void Audio::DSP::FIR::Internal::Instance<Type>::copyLastInputs(const Instance &other) noexcept
+{
+    const auto historySize = static_cast<std::uint32_t>(_coefficients.size()) - 1u;
+    const auto otherHistorySize = static_cast<std::uint32_t>(other._coefficients.size()) - 1u;
+    const auto copySize = std::min(historySize, otherHistorySize);
+
+    for (auto channel = 0u; channel < MaxChannelCount; ++channel) {
+        auto *history = _lastInputCaches[channel].data();
+        std::fill(history, history + historySize - copySize, Type {});
+        std::memcpy(history + historySize - copySize, other._lastInputCaches[channel].data() + otherHistorySize - copySize, copySize * sizeof(Type));
     }
-    return sample;
+    _convolution.invalidate();
+}
+
+template<typename Type>
+template<typename CoefficientType>
+inline void Audio::DSP::FIR::Internal::Instance<Type>::prepare(const Core::TinyVector<CoefficientType> &coefficients, const std::uint32_t blockSize) noexcept
+{
+    const auto filterSize = static_cast<std::uint32_t>(coefficients.size());
+
+    _coefficients.resize(filterSize);
+    std::copy(coefficients.begin(), coefficients.end(), _coefficients.begin());
+    resizeLastInputs(filterSize - 1u);
+    _workspace.resize(filterSize - 1u + blockSize);
+    // The kernel spectrums are computed here rather than by the first filtering
+    if (const auto partitionSize = GetPartitionSize(filterSize, blockSize); partitionSize) {
+        _convolution.setKernel(_coefficients.data(), filterSize, partitionSize);
+        _coefficientsChanged = false;
+    } else
+        _coefficientsChanged = true;
+}
+
+template<typename Type>
+inline void Audio::DSP::FIR::Internal::Instance<Type>::saveLastInput(const Type *input, const std::uint32_t inputSize, Cache<Type> &lastInputCache) noexcept
+{
+    const auto historySize = static_cast<std::uint32_t>(_coefficients.size()) - 1u;
+
+    // Blocks shorter than the history only shift it
+    if (inputSize < historySize) {
+        std::memmove(lastInputCache.data(), lastInputCache.data() + inputSize, (historySize - inputSize) * sizeof(Type));
+        std::memcpy(lastInputCache.data() + historySize - inputSize, input, inputSize * sizeof(Type));
+    } else
+        std::memcpy(lastInputCache.data(), input + inputSize - historySize, historySize * sizeof(Type));
+}
+
+template<typename Type>
+inline Audio::DSP::FIR::Internal::Instance<Type> &Audio::DSP::FIR::Internal::CrossfadeInstance<Type>::prepareNext(void) noexcept
+{
+    auto &next = _instances[_active ^ 1u];
+
+    // Both instances must start the next block from the same input history
+    next.copyLastInputs(_instances[_active]);
+    return next;
+}
+
+template<typename Type>
+template<bool Accumulate>
+inline typename Audio::DSP::FIR::VoidType<Type> Audio::DSP::FIR::Internal::CrossfadeInstance<Type>::filter(const Type *input, const std::uint32_t inputSize, Type *output, const Type outGain, const Channel channel) noexcept
+{
+    auto &current = _instances[_active];
+    const auto channelIndex = static_cast<std::size_t>(channel);
+
+    if (!_fading[channelIndex]) {
+        current.template filter<Accumulate>(input, inputSize, output, outGain, channel);
+        return;
+    }
+    // Linear crossfade over the block to avoid clicks
+    _fading[channelIndex] = false;
+    _fadeCache.resize(inputSize);
+    _instances[_active ^ 1u].template filter<Accumulate>(input, inputSize, _fadeCache.data(), outGain, channel);
+    current.template filter<Accumulate>(input, inputSize, output, outGain, channel);
+    const auto step = static_cast<Type>(1) / static_cast<Type>(inputSize);
+    for (auto i = 0u; i < inputSize; ++i)
+        output[i] = _fadeCache[i] + (output[i] - _fadeCache[i]) * static_cast<Type>(i + 1u) * step;
 }
 
 template<unsigned InstanceCount, typename Type>
@@ -12,7 +12,13 @@
 template<typename Type>
 inline void Audio::DSP::FIR::BasicFilter<Type>::init(const DSP::Filter::FIRSpecs &specs) noexcept
 {
-    setSpecs(specs);
+    // The first design is made synchronously, a running request is ignored once it completes
+    _specs = specs;
+    _designPending = false;
+    for (auto &instance : _instance.instances()) {
+        DSP::Filter::Designer::Design(_specs, instance.coefficients());
+        instance.onCoefficientsChanged();
+    }
     resizeLastInputCache(_specs.filterSize - 1u);
     resetLastInputCache();
 }
@@ -33,7 +39,7 @@ inline bool Audio::DSP::FIR::BasicFilter<Type>::setCutoffs(const float cutoffBeg
     if (cutoffBegin == _specs.cutoffBegin && cutoffEnd == _specs.cutoffEnd)
         return false;
     _specs.cutoffBegin = cutoffBegin;
-    _specs.cutoffBegin = cutoffBegin;
+    _specs.cutoffEnd = cutoffEnd;
     onSpecChanged();
     return true;
 }
@@ -65,9 +71,7 @@ inline bool Audio::DSP::FIR::BasicFilter<Type>::setOrder(const std::uint32_t ord
         return false;
     _specs.order = order + (order & 1u);
     _specs.filterSize = _specs.order + 1u;
-    // We don't need the last coefficient to process the first filter frame
-    resizeLastInputCache(_specs.filterSize - 1u);
-    resetLastInputCache();
+    // The input history is resized when the design of the new order is swapped in
     onSpecChanged();
     return true;
 }
@@ -93,10 +97,31 @@ inline bool Audio::DSP::FIR::BasicFilter<Type>::setWindowType(const DSP::Filter:
 }
 
 template<typename Type>
-inline void Audio::DSP::FIR::BasicFilter<Type>::onSpecChanged(void) noexcept
+inline void Audio::DSP::FIR::BasicFilter<Type>::updateDesign(const std::uint32_t blockSize) noexcept
 {
-    _instance.coefficients().resize(_specs.filterSize);
-    Filter::GenerateFilter<true>(_specs, _instance.coefficients().data());
+    using State = DSP::Filter::DesignSlot::State;
+
+    auto &slot = *_slot;
+    const auto state = slot.state.load(std::memory_order_acquire);
+
+    if (state == State::Requested)
+        return;
+    if (state == State::Ready) {
+        slot.state.store(State::Idle, std::memory_order_relaxed);
+        // A design of outdated specs is dropped, the latest ones are requested below
+        if (slot.specs == _specs) {
+            // The designer prepared the instance for any order, it is exchanged without allocating and crossfaded
+            _instance.prepareNext(slot.instance);
+            _instance.swap();
+            _designPending = false;
+        }
+    }
+    if (_designPending) {
+        slot.specs = _specs;
+        slot.blockSize = blockSize;
+        if (!DSP::Filter::Designer::Request(_slot))
+            slot.state.store(State::Idle, std::memory_order_relaxed);
+    }
 }
 
 
@@ -104,10 +129,13 @@ inline void Audio::DSP::FIR::BasicFilter<Type>::onSpecChanged(void) noexcept
  * @brief BandFilter implementation
  */
 template<unsigned InstanceCount, typename Type>
-inline void Audio::DSP::FIR::BandFilter<InstanceCount, Type>::init(const Audio::DSP::Filter::WindowType windowType, const float sampleRate, const std::uint32_t order) noexcept
+inline void Audio::DSP::FIR::BandFilter<InstanceCount, Type>::init(const Audio::DSP::Filter::WindowType windowType, const float sampleRate, const std::uint32_t desiredOrder) noexcept
 {
+    // The band designs round the order up to an even one, like FIRSpecs
+    const auto order = desiredOrder + (desiredOrder & 1u);
     const auto filterSize = order + 1u;
-    _instance.coefficients().resize(filterSize);
+    for (auto &instance : _instance.instances())
+        instance.coefficients().resize(filterSize);
     _filterOrder = order;
     _windowType = windowType;
     _sampleRate = sampleRate;
@@ -121,79 +149,39 @@ inline void Audio::DSP::FIR::BandFilter<InstanceCount, Type>::init(const Audio::
 
 template<unsigned InstanceCount, typename Type>
 template<bool Accumulate, typename GainType, std::uint32_t GainSize>
-inline typename Audio::DSP::FIR::VoidType<Type> Audio::DSP::FIR::BandFilter<InstanceCount, Type>::filter(const Type *input, const std::uint32_t inputSize, Type *output, const GainType(&gains)[GainSize]) noexcept
+inline typename Audio::DSP::FIR::VoidType<Type> Audio::DSP::FIR::BandFilter<InstanceCount, Type>::filter(const Type *input, const std::uint32_t inputSize, Type *output, const GainType(&gains)[GainSize], const Channel channel) noexcept
 {
-    // std::cout << "FIlter:::" << std::endl;
-    // ASSERT GainSize == InstanceCount
-    auto ProcessGainUpdate = [&](const std::uint32_t filterIndex, const auto rootFreq, const auto gain, const auto newGain) -> bool
-    {
-        if (gain == newGain)
-            return false;
-        // std::cout << "  update(" << filterIndex << "): " << gain << " -> " << newGain << std::endl;
-        _gain[filterIndex] = newGain;
-        switch (filterIndex) {
-        case 0u:
-            reloadLowPass(rootFreq, newGain);
-            break;
-        case InstanceCount - 1:
-            reloadHighPass(rootFreq, newGain);
-            break;
-        default:
-            reloadBandPass(filterIndex, rootFreq, newGain);
-            break;
-        }
-        return true;
-    };
-
-    auto rootFreq = RootFrequency;
-    if constexpr (InstanceCount == 3)
-        rootFreq = 3000;
-    if constexpr (InstanceCount == 4)
-        rootFreq = 2000;
-    if constexpr (InstanceCount == 5)
-        rootFreq = 1024;
+    static_assert(GainSize == InstanceCount, "Audio::DSP::FIR::BandFilter::filter: a gain is required for each band");
 
     bool updated { false };
-    if constexpr (InstanceCount != MinBandFilterSize)
-        rootFreq = rootFreq * 3 / 2;
-
     for (auto i = 0u; i < GainSize; ++i) {
-        if (ProcessGainUpdate(i, rootFreq, _gain[i], gains[i]) && !updated)
-            updated = true;
-        if constexpr (InstanceCount != MinBandFilterSize) {
-            if (i)
-                rootFreq *= 2.0f;
-        }
+        if (_gain[i] == static_cast<float>(gains[i]))
+            continue;
+        _gain[i] = static_cast<float>(gains[i]);
+        updated = true;
     }
+    // The previous kernel is kept to crossfade the block
     if (updated) {
-        mergeToInstance();
+        mergeToInstance(_instance.prepareNext());
+        _instance.swap();
     }
-    UNUSED(input);
-    UNUSED(inputSize);
-    UNUSED(output);
-    _instance.template filter<Accumulate>(input, inputSize, output, 1.0f);
-    // for (auto i = 0u; i < InstanceCount; ++i) {
-    //     _instance.template filter<Accumulate>(input, inputSize, output, 1.0f);
-    // }
+    _instance.template filter<Accumulate>(input, inputSize, output, 1.0f, channel);
 }
 
 template<unsigned InstanceCount, typename Type>
-inline void Audio::DSP::FIR::BandFilter<InstanceCount, Type>::mergeToInstance(void) noexcept
+inline void Audio::DSP::FIR::BandFilter<InstanceCount, Type>::mergeToInstance(Internal::Instance<Type> &instance) noexcept
 {
-    // /** @todo REMOVE THIS */
-    // for (auto k = 0u; k <= _filterOrder; ++k) {
-    //     _instance.coefficients()[k] = _coefficients[1][k];
-    // }
-    // return;
+    auto &coefficients = instance.coefficients();
 
     for (auto k = 0u; k <= _filterOrder; ++k) {
-        _instance.coefficients()[k] = _coefficients[0][k];
+        coefficients[k] = _coefficients[0][k] * _gain[0];
     }
     for (auto i = 1u; i < InstanceCount; ++i) {
         for (auto k = 0u; k <= _filterOrder; ++k) {
-            _instance.coefficients()[k] += _coefficients[i][k];
+            coefficients[k] += _coefficients[i][k] * _gain[i];
         }
     }
+    instance.onCoefficientsChanged();
 }
 
 template<unsigned InstanceCount, typename Type>
@@ -220,7 +208,9 @@ inline void Audio::DSP::FIR::BandFilter<InstanceCount, Type>::reloadAll(void) no
         rootFreq *= 2.f;
     // High-pass filters
     reloadHighPass(rootFreq, 1.0f);
-    mergeToInstance();
+    // Both instances start with the unit gain kernel
+    for (auto &instance : _instance.instances())
+        mergeToInstance(instance);
 }
 
 template<unsigned InstanceCount, typename Type>
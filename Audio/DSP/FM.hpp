@@ -8,9 +8,13 @@
 
 #pragma once
 
+#include <array>
+#include <cmath>
+
 #include <Core/FlatVector.hpp>
 
 #include "EnvelopeGenerator.hpp"
+#include "Dispatch.hpp"
 
 namespace Audio::DSP::FM
 {
@@ -73,31 +77,37 @@ public:
     //         return std::sin(2.0f * static_cast<float>(M_PI) * phaseIndex * frequency);
     // }
 
+    /** @brief Render an operator, its sine is evaluated in vector lanes with its envelope applied as a gain block
+     *  The increment is the phase step of the operator in turns per sample */
     template<bool Accumulate, bool Modulate, unsigned OperatorIndex>
     inline void processOperator(
             const float *input, float *output, const std::uint32_t processSize, const float outputGain,
-            const std::uint32_t phaseIndex, const float frequencyNorm, const Key key,
+            const std::uint32_t phaseIndex, const double increment, const Key key,
             const Internal::Operator &op
     ) noexcept
     {
+        constexpr float RadianToTurn = 0.5f / static_cast<float>(M_PI);
         const auto outGain = op.volume * outputGain;
-
-        for (auto i = 0u; i < processSize; ++i) {
-            const auto index = i + phaseIndex;
-            const auto realOutGain = outGain * _envelopes.template getGain<OperatorIndex>(key, index, 0.0f, op.attack, 0.0f, op.decay, op.sustain, op.release, _sampleRate);
-            const auto freq = 2.0f * static_cast<float>(M_PI) * (static_cast<float>(index)) * frequencyNorm;
-
-            if constexpr (Modulate) {
-                if constexpr (Accumulate)
-                    output[i] += realOutGain * std::sin(freq + static_cast<float>(M_PI) * input[i]);
-                else
-                    output[i] = realOutGain * std::sin(freq + static_cast<float>(M_PI) * input[i]);
-            } else {
-                if constexpr (Accumulate)
-                    output[i] += realOutGain * processFeedback(freq, op.feedback);
-                else
-                    output[i] = realOutGain * processFeedback(freq, op.feedback);
-            }
+        const auto &kernels = Simd::Kernels();
+        const auto phase = static_cast<double>(phaseIndex) * increment;
+        auto * const gains = _gainCache.data();
+
+        _envelopes.template getGains<OperatorIndex>(key, phaseIndex, gains, processSize, 0.0f, op.attack, 0.0f, op.decay, op.sustain, op.release, _sampleRate);
+        for (auto i = 0u; i < processSize; ++i)
+            gains[i] *= outGain;
+        if constexpr (Modulate) {
+            // The input modulates the phase by half a turn at full scale
+            kernels.modulatedSine(output, gains, input, 0.5f, phase, increment, processSize, Accumulate);
+        } else {
+            // Each feedback step modulates the sine by itself, in radians
+            const auto feedback = op.feedback <= MaxFeedback ? op.feedback : 0u;
+            if (!feedback)
+                return kernels.modulatedSine(output, gains, nullptr, 0.0f, phase, increment, processSize, Accumulate);
+            auto * const loop = _feedbackCache.data();
+            kernels.modulatedSine(loop, nullptr, nullptr, 0.0f, phase, increment, processSize, false);
+            for (auto i = 1u; i < feedback; ++i)
+                kernels.modulatedSine(loop, nullptr, loop, RadianToTurn, phase, increment, processSize, false);
+            kernels.modulatedSine(output, gains, loop, RadianToTurn, phase, increment, processSize, Accumulate);
         }
     }
 
@@ -107,112 +117,93 @@ public:
 
     void setSampleRate(const SampleRate sampleRate) noexcept { _sampleRate = sampleRate; }
 
+    /** @brief Prepare the operators of a block, the parameters shared by every note are only computed here */
+    void prepareOperators(const Internal::OperatorArray<OperatorCount> &operators) noexcept
+    {
+        _operators = operators;
+        for (auto i = 0u; i < OperatorCount; ++i)
+            _incrementRatios[i] = GetDetuneRatio(operators[i].detune) * static_cast<double>(operators[i].frequencyDelta) / static_cast<double>(_sampleRate);
+    }
+
+    /** @brief Process a note with the operators of the last prepareOperators call */
     template<bool Accumulate>
     void process(
             float *output, const std::uint32_t processSize, const float outputGain,
-            const std::uint32_t phaseIndex, const Key key, const float rootFrequency,
-            const Internal::OperatorArray<OperatorCount> &operators
+            const std::uint32_t phaseIndex, const Key key, const float rootFrequency
     ) noexcept
     {
         _cache.resize(static_cast<Internal::ProcessSizeType>(processSize));
+        _feedbackCache.resize(static_cast<Internal::ProcessSizeType>(processSize));
+        _gainCache.resize(static_cast<Internal::ProcessSizeType>(processSize));
         if constexpr (OperatorCount == 2u) {
-            oneCarrierOneModulator<Accumulate>(output, processSize, outputGain, phaseIndex, key, rootFrequency, operators);
+            oneCarrierOneModulator<Accumulate>(output, processSize, outputGain, phaseIndex, key, rootFrequency);
         } else if constexpr (OperatorCount == 6u) {
-            dx7_05<Accumulate>(output, processSize, outputGain, phaseIndex, key, rootFrequency, operators);
+            dx7_05<Accumulate>(output, processSize, outputGain, phaseIndex, key, rootFrequency);
         }
     }
 
 private:
+    /** @brief Highest feedback amount, each step is one more sine of the operator */
+    static constexpr std::uint32_t MaxFeedback = 7u;
+
     EnvelopeList _envelopes;
     SampleRate _sampleRate;
     Internal::CacheList _cache;
+    /** @brief Self modulation of the operator being processed */
+    Internal::CacheList _feedbackCache;
+    /** @brief Envelope gains of the operator being processed */
+    Internal::CacheList _gainCache;
+    Internal::OperatorArray<OperatorCount> _operators {};
+    /** @brief Phase increment of each operator for a root frequency of 1 Hz */
+    std::array<double, OperatorCount> _incrementRatios {};
 
     template<bool Accumulate>
     void oneCarrierOneModulator(
             float *output, const std::uint32_t processSize, const float outputGain,
-            const std::uint32_t phaseIndex, const Key key, const float rootFrequency,
-            const Internal::OperatorArray<OperatorCount> &operators
+            const std::uint32_t phaseIndex, const Key key, const float rootFrequency
     ) noexcept
     {
         // Op_1 modulate Op_0
-        // processOperator<Accumulate, false, 1>(nullptr, _cache.data(), processSize, 1.0f, phaseIndex, (rootFrequency * operators[1].frequencyDelta) / static_cast<float>(_sampleRate), key, operators[1]);
-        // processOperator<Accumulate, true, 0>(_cache.data(), output, processSize, outputGain, phaseIndex, (rootFrequency * operators[0].frequencyDelta) / static_cast<float>(_sampleRate), key, operators[0]);
+        // processOperator<Accumulate, false, 1>(nullptr, _cache.data(), processSize, 1.0f, phaseIndex, rootFrequency * _incrementRatios[1], key, _operators[1]);
+        // processOperator<Accumulate, true, 0>(_cache.data(), output, processSize, outputGain, phaseIndex, rootFrequency * _incrementRatios[0], key, _operators[0]);
 
         // Op_0 only
-        processOperator<Accumulate, false, 0>(nullptr, output, processSize, outputGain, phaseIndex, (rootFrequency * operators[0].frequencyDelta) / static_cast<float>(_sampleRate), key, operators[0]);
+        processOperator<Accumulate, false, 0>(nullptr, output, processSize, outputGain, phaseIndex, rootFrequency * _incrementRatios[0], key, _operators[0]);
     }
 
     template<bool Accumulate>
     void dx7_05(
             float *output, const std::uint32_t processSize, const float outputGain,
-            const std::uint32_t phaseIndex, const Key key, const float rootFrequency,
-            const Internal::OperatorArray<OperatorCount> &operators
+            const std::uint32_t phaseIndex, const Key key, const float rootFrequency
     ) noexcept
     {
         constexpr auto CarrierCount = 3u;
         const auto realOutputGain = outputGain / static_cast<float>(CarrierCount);
 
-        dx7_05_impl<Accumulate>(output, processSize, realOutputGain, phaseIndex, rootFrequency, key, operators);
+        dx7_05_impl<Accumulate>(output, processSize, realOutputGain, phaseIndex, rootFrequency, key);
     }
 
     template<bool Accumulate, unsigned Index = 0u>
     void dx7_05_impl(
             float *output, const std::uint32_t processSize, const float outputGain,
-            const std::uint32_t phaseIndex, const float rootFrequency, const Key key,
-            const Internal::OperatorArray<OperatorCount> &operators
+            const std::uint32_t phaseIndex, const float rootFrequency, const Key key
     ) noexcept
     {
         if constexpr (Index < OperatorCount) {
             constexpr auto CarrierIdx = Index;
             constexpr auto ModIdx = Index + 1;
 
-            // _cache.clear();
-            processOperator<false, false, ModIdx>(nullptr, _cache.data(), processSize, 1.0f, phaseIndex, (getDetuneFrequency(rootFrequency, operators[ModIdx].detune) * operators[ModIdx].frequencyDelta) / static_cast<float>(_sampleRate), key, operators[ModIdx]);
-            processOperator<Accumulate, true, CarrierIdx>(_cache.data(), output, processSize, outputGain, phaseIndex, (getDetuneFrequency(rootFrequency, operators[CarrierIdx].detune) * operators[CarrierIdx].frequencyDelta) / static_cast<float>(_sampleRate), key, operators[CarrierIdx]);
-            dx7_05_impl<Accumulate, Index + 2>(output, processSize, outputGain, phaseIndex, rootFrequency, key, operators);
-        }
-    }
-
-    [[nodiscard]] float processFeedback(const float freq, const std::uint32_t feedbackAmount) const noexcept
-    {
-        switch (feedbackAmount) {
-        case 0:
-            return unrollFeedback<0u>(freq);
-        case 1:
-            return unrollFeedback<1u>(freq);
-        case 2:
-            return unrollFeedback<2u>(freq);
-        case 3:
-            return unrollFeedback<3u>(freq);
-        case 4:
-            return unrollFeedback<4u>(freq);
-        case 5:
-            return unrollFeedback<5u>(freq);
-        case 6:
-            return unrollFeedback<6u>(freq);
-        case 7:
-            return unrollFeedback<7u>(freq);
-        default:
-            return unrollFeedback<0u>(freq);
-        }
-    }
-
-    template<unsigned Feedback>
-    [[nodiscard]] float unrollFeedback(const float freq) const noexcept
-    {
-        if constexpr (!Feedback) {
-            return std::sin(freq);
-        } else {
-            return std::sin(freq + unrollFeedback<Feedback - 1>(freq));
+            processOperator<false, false, ModIdx>(nullptr, _cache.data(), processSize, 1.0f, phaseIndex, rootFrequency * _incrementRatios[ModIdx], key, _operators[ModIdx]);
+            processOperator<Accumulate, true, CarrierIdx>(_cache.data(), output, processSize, outputGain, phaseIndex, rootFrequency * _incrementRatios[CarrierIdx], key, _operators[CarrierIdx]);
+            dx7_05_impl<Accumulate, Index + 2>(output, processSize, outputGain, phaseIndex, rootFrequency, key);
         }
     }
 
-    [[nodiscard]] float getDetuneFrequency(const float rootFrequency, std::int32_t detune) const noexcept
+    [[nodiscard]] static double GetDetuneRatio(const std::int32_t detune) noexcept
     {
         if (!detune)
-            return rootFrequency;
-        const double detuneNorm = static_cast<double>(detune) / 120.0;
-        return rootFrequency * static_cast<float>(std::pow(2.0, detuneNorm));
+            return 1.0;
+        return std::pow(2.0, static_cast<double>(detune) / 120.0);
     }
 
 };
@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include <Audio/Math.hpp>
 #include <Audio/Modifier.hpp>
 
@@ -69,7 +71,7 @@ namespace Audio::DSP::Filter
         ~FIRSpecs(void) noexcept = default;
 
         /** @brief Comparison operator */
-        [[nodiscard]] bool operator==(const FIRSpecs &other) {
+        [[nodiscard]] bool operator==(const FIRSpecs &other) const noexcept {
             return (
                 filterType == other.filterType &&
                 windowType == other.windowType &&
@@ -93,6 +95,30 @@ namespace Audio::DSP::Filter
         Core::TinyVector<float> cutoffs;
     };
 
+    /** @brief Count the silent input samples of a FIR filter to know when its output is silent too */
+    class SilenceTracker
+    {
+    public:
+        /** @brief Feed the silent state of an input block, 'historySize' is the number of past input samples read by the filter
+         *  @return true if the block and the whole filter history are silent, the block can be skipped */
+        [[nodiscard]] bool feed(const bool silent, const std::size_t blockSize, const std::size_t historySize) noexcept
+        {
+            if (!silent) {
+                _silentSize = 0u;
+                return false;
+            }
+            const bool flushed = _silentSize >= historySize;
+            _silentSize = std::min(_silentSize + blockSize, historySize);
+            return flushed;
+        }
+
+        /** @brief Forget the silent samples, the filter history must be processed again */
+        void reset(void) noexcept { _silentSize = 0u; }
+
+    private:
+        std::size_t _silentSize { 0u };
+    };
+
     /** @brief Get filter order */
     template<unsigned ProcessSize>
     [[nodiscard]] static std::uint32_t GetFilterOrder(const float factor);
@@ -0,0 +1,104 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: Background design of FIR filters
+ */
+
+#include <algorithm>
+
+#include "FilterDesigner.hpp"
+
+using namespace Audio::DSP::Filter;
+
+Designer Designer::_Instance {};
+
+Designer::Designer(void)
+{
+    _requests.reserve(CacheCapacity);
+    _running = true;
+    _thread = std::thread([this] { run(); });
+}
+
+Designer::~Designer(void) noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_running)
+            return;
+        _running = false;
+    }
+    _requested.notify_one();
+    _thread.join();
+}
+
+bool Designer::Request(const DesignSlotPtr &slot) noexcept
+{
+    std::unique_lock<std::mutex> lock(_Instance._mutex, std::try_to_lock);
+
+    if (!lock.owns_lock() || !_Instance._running)
+        return false;
+    if (_Instance._requests.size() == _Instance._requests.capacity())
+        return false;
+    slot->state.store(DesignSlot::State::Requested, std::memory_order_release);
+    _Instance._requests.push_back(slot);
+    lock.unlock();
+    _Instance._requested.notify_one();
+    return true;
+}
+
+void Designer::Design(const FIRSpecs &specs, Core::TinyVector<float> &coefficients)
+{
+    {
+        std::lock_guard<std::mutex> lock(_Instance._cacheMutex);
+        auto &cache = _Instance._cache;
+        const auto it = std::find_if(cache.begin(), cache.end(), [&specs](const Entry &entry) { return entry.specs == specs; });
+        if (it != cache.end()) {
+            coefficients = it->coefficients;
+            std::rotate(it, it + 1, cache.end());
+            return;
+        }
+    }
+    coefficients.resize(specs.filterSize);
+    GenerateFilter<true>(specs, coefficients.data());
+    std::lock_guard<std::mutex> lock(_Instance._cacheMutex);
+    auto &cache = _Instance._cache;
+    if (cache.size() == CacheCapacity)
+        cache.erase(cache.begin());
+    cache.push_back(Entry { specs, coefficients });
+}
+
+void Designer::Flush(void)
+{
+    std::unique_lock<std::mutex> lock(_Instance._mutex);
+
+    _Instance._flushed.wait(lock, [] { return _Instance._requests.empty() && !_Instance._designing; });
+}
+
+std::size_t Designer::CachedCount(void) noexcept
+{
+    std::lock_guard<std::mutex> lock(_Instance._cacheMutex);
+
+    return _Instance._cache.size();
+}
+
+void Designer::run(void)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (true) {
+        _requested.wait(lock, [this] { return !_requests.empty() || !_running; });
+        if (!_running)
+            return;
+        auto slot = std::move(_requests.front());
+        _requests.erase(_requests.begin());
+        _designing = true;
+        lock.unlock();
+        Design(slot->specs, slot->coefficients);
+        slot->onDesigned();
+        slot->state.store(DesignSlot::State::Ready, std::memory_order_release);
+        slot.reset();
+        lock.lock();
+        _designing = false;
+        if (_requests.empty())
+            _flushed.notify_all();
+    }
+}
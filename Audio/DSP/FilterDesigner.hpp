@@ -0,0 +1,101 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: Background design of FIR filters
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <Core/Vector.hpp>
+
+#include "Filter.hpp"
+
+namespace Audio::DSP::Filter
+{
+    class Designer;
+
+    /** @brief Exchange area of a filter design between the audio thread and the designer
+     *  The state tells which side owns the specs and the coefficients */
+    struct DesignSlot
+    {
+        enum class State : std::uint8_t
+        {
+            Idle = 0u,  // Owned by the filter, no design is running
+            Requested,  // Owned by the designer
+            Ready       // Owned by the filter, the coefficients match the specs
+        };
+
+        std::atomic<State> state { State::Idle };
+        FIRSpecs specs {};
+        Core::TinyVector<float> coefficients {};
+
+        /** @brief Virtual destructor */
+        virtual ~DesignSlot(void) noexcept = default;
+
+        /** @brief Called on the designer thread once the coefficients are designed, to prepare what the filter will use them with */
+        virtual void onDesigned(void) {}
+    };
+
+    /** @brief Shared handle to a slot, a request keeps its slot alive after the filter destruction */
+    using DesignSlotPtr = std::shared_ptr<DesignSlot>;
+}
+
+/** @brief Process-wide designer of FIR filters
+ *  Designs are made on a background thread so the audio thread never evaluates windowed-sinc coefficients,
+ *  the most recent ones are kept in a LRU cache */
+class Audio::DSP::Filter::Designer
+{
+public:
+    /** @brief Maximum number of designs kept in cache */
+    static constexpr std::size_t CacheCapacity = 64u;
+
+    /** @brief Constructor, starts the designer thread and reserves the request queue so requests never allocate */
+    Designer(void);
+
+    /** @brief Destructor, stops the designer thread */
+    ~Designer(void) noexcept;
+
+    /** @brief Design the filter of the specs of an idle slot on the background thread
+     *  Never blocks nor allocates, returns false if the request must be retried later */
+    [[nodiscard]] static bool Request(const DesignSlotPtr &slot) noexcept;
+
+    /** @brief Design a filter on the calling thread, using the cache if possible */
+    static void Design(const FIRSpecs &specs, Core::TinyVector<float> &coefficients);
+
+    /** @brief Wait until every pending request is designed (for testing) */
+    static void Flush(void);
+
+    /** @brief Get the number of cached designs */
+    [[nodiscard]] static std::size_t CachedCount(void) noexcept;
+
+private:
+    /** @brief A cached design */
+    struct Entry
+    {
+        FIRSpecs specs {};
+        Core::TinyVector<float> coefficients {};
+    };
+
+    std::mutex _mutex {};
+    std::condition_variable _requested {};
+    std::condition_variable _flushed {};
+    std::vector<DesignSlotPtr> _requests {};
+    std::thread _thread {};
+    bool _running { false };
+    bool _designing { false };
+
+    std::mutex _cacheMutex {};
+    /** @brief Cached designs, from the least to the most recently used */
+    std::vector<Entry> _cache {};
+
+    static Designer _Instance;
+
+    /** @brief Designer thread loop */
+    void run(void);
+};
@@ -5,26 +5,49 @@
 
 #pragma once
 
+#include <algorithm>
+#include <type_traits>
+
 #include <Core/Utils.hpp>
 
 #include <Audio/Buffer.hpp>
 
+#include "Dispatch.hpp"
+
 namespace Audio::DSP
 {
     /** @brief Merge a list of buffer into a separated one.
      *  If normalize is true, all input buffers will be normalize to the number of input.
-        Otherwise the inputs are simply summed. */
+        Otherwise the inputs are simply summed.
+     *  Inputs known to be silent are skipped and the output silent state is updated */
     template<typename Type>
     void Merge(const BufferViews inputs, BufferView output, const DB ratio, const bool normalize = false) noexcept;
 
     template<typename Type>
     void Merge(const BufferView input, BufferView output, const DB ratio, const bool normalize = false) noexcept;
 
+    /** @brief Accumulate a single channel of 'output.channelSampleCount()' samples into every channel of the output */
+    template<typename Type>
+    void MergeToChannels(const Type *input, BufferView output) noexcept;
+
     template<typename Unit, std::size_t BufferSize, typename ...Args>
     void Merge(Unit * const output, Args &&...args) noexcept;
 
     namespace Internal
     {
+        /** @brief Number of inputs summed at once by a merge kernel */
+        constexpr std::size_t MergeGroupSize = 4u;
+
+        /** @brief Byte size of the output tiles, small enough to stay in L1 while every input group is summed */
+        constexpr std::size_t MergeTileByteSize = 4096u;
+
+        /** @brief Sum a group of inputs into the output in a single pass
+         *  If 'accumulate' is true the group is added to the output, if 'scale' is true the sum is multiplied by the ratio
+         *  Float samples use the kernel of the instruction set selected at runtime */
+        template<typename Type>
+        void MergeGroup(const Type * const *inputs, const std::size_t inputCount, Type *output, const std::size_t size,
+                const DB ratio, const bool accumulate, const bool scale) noexcept;
+
         template<typename Unit, std::size_t BufferSize, std::size_t Index, std::size_t InputCount, typename Tuple>
         std::enable_if_t<std::is_convertible_v<std::tuple_element_t<Index, Tuple>, Unit * const>, void>
             MergeUnroll(Unit * const output, const Tuple &tuple) noexcept;
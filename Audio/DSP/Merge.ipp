@@ -13,22 +13,36 @@ void Audio::DSP::Merge(const BufferViews inputs, BufferView output, const DB rat
 
     if (!inputSize || !outputSize)
         return;
-    Type *to = output.data<Type>();
-    // Copy first input
-    const Type *from = inputs[0].data<Type>();
-    for (auto k = 0u; k < outputSize; ++k) {
-        to[k] = from[k];
+    // Silent inputs are skipped, the output is simply cleared if none is left
+    auto first = 0u;
+    while (first < inputSize && inputs[first].isSilent())
+        ++first;
+    if (first == inputSize) {
+        output.clear();
+        return;
     }
-    // Merge other inputs
-    for (auto i = 1u; i < inputSize; ++i) {
-        const Type *from = inputs[i].data<Type>();
-        for (auto k = 0u; k < outputSize; ++k) {
-            to[k] += from[k];
+    auto last = inputSize - 1u;
+    while (inputs[last].isSilent())
+        --last;
+    Type *to = output.data<Type>();
+    constexpr std::size_t TileSize = Internal::MergeTileByteSize / sizeof(Type);
+    // Each tile of the output is written once per group of inputs while it stays in cache, the ratio is fused in the last group
+    for (std::size_t tile = 0u; tile < outputSize; tile += TileSize) {
+        const auto tileSize = std::min(TileSize, outputSize - tile);
+        const Type *group[Internal::MergeGroupSize];
+        auto index = first;
+        bool accumulate = false;
+        while (index <= last) {
+            std::size_t count = 0u;
+            for (; index <= last && count < Internal::MergeGroupSize; ++index) {
+                if (!inputs[index].isSilent())
+                    group[count++] = inputs[index].data<Type>() + tile;
+            }
+            Internal::MergeGroup<Type>(group, count, to + tile, tileSize, ratio, accumulate, index > last);
+            accumulate = true;
         }
     }
-    for (auto k = 0u; k < outputSize; ++k) {
-        to[k] *= ratio;
-    }
+    output.setSilent(false);
 }
 
 template<typename Type>
@@ -42,10 +56,41 @@ void Audio::DSP::Merge(const BufferView input, BufferView output, const DB ratio
         return;
     const auto realSize = std::min(inputSize, outputSize);
 
-    const Type *in = input.data<Type>();
     Type *out = output.data<Type>();
-    for (auto i = 0u; i < realSize; ++i) {
-        out[i] = in[i] * ratio;
+    if (input.isSilent()) {
+        std::memset(out, 0, realSize * sizeof(Type));
+        output.setSilent(output.isSilent() || realSize == outputSize);
+        return;
+    }
+    const Type *in = input.data<Type>();
+    Internal::MergeGroup<Type>(&in, 1u, out, realSize, ratio, false, true);
+    output.setSilent(false);
+}
+
+template<typename Type>
+void Audio::DSP::MergeToChannels(const Type *input, BufferView output) noexcept
+{
+    const auto channelSize = output.channelSampleCount();
+
+    for (auto channel = 0u; channel < output.channelCount(); ++channel) {
+        Internal::MergeGroup<Type>(&input, 1u, output.data<Type>(static_cast<Channel>(channel)), channelSize, 1.0f, true, false);
+    }
+    output.setSilent(false);
+}
+
+template<typename Type>
+void Audio::DSP::Internal::MergeGroup(const Type * const *inputs, const std::size_t inputCount, Type *output, const std::size_t size,
+        const DB ratio, const bool accumulate, const bool scale) noexcept
+{
+    if constexpr (std::is_same_v<Type, float>) {
+        Simd::Kernels().mergeGroup(inputs, inputCount, output, size, ratio, accumulate, scale);
+    } else {
+        for (auto i = 0u; i < size; ++i) {
+            Type sample = accumulate ? output[i] : inputs[0][i];
+            for (auto k = accumulate ? 0u : 1u; k < inputCount; ++k)
+                sample += inputs[k][i];
+            output[i] = scale ? static_cast<Type>(sample * ratio) : sample;
+        }
     }
 }
 
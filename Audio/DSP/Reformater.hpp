@@ -22,6 +22,14 @@ namespace Audio::DSP::Reformater
 
     template<typename InType, typename OutType>
     void Reformat(const InType *input, OutType *output, const std::size_t inputSize) noexcept;
+
+    /** @brief Interleave 'frameCount' frames of planar channels, each channel starting 'channelStride' samples after the previous one */
+    template<typename Type>
+    void Interleave(const Type *input, Type *output, const std::size_t frameCount, const std::size_t channelCount, const std::size_t channelStride) noexcept;
+
+    /** @brief Split 'frameCount' interleaved frames into planar channels, each channel starting 'channelStride' samples after the previous one */
+    template<typename Type>
+    void Deinterleave(const Type *input, Type *output, const std::size_t frameCount, const std::size_t channelCount, const std::size_t channelStride) noexcept;
 }
 
 #include "Reformater.ipp"
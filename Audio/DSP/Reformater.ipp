@@ -3,6 +3,8 @@
  * @ Description: Reformater implementation
  */
 
+#include <cstring>
+
 #include <Audio/Base.hpp>
 
 template<typename InType, typename OutType>
@@ -101,3 +103,33 @@ inline void Audio::DSP::Reformater::Internal::FromFloatingImpl(const InType *inp
         }
     }
 }
+
+template<typename Type>
+inline void Audio::DSP::Reformater::Interleave(const Type *input, Type *output, const std::size_t frameCount, const std::size_t channelCount, const std::size_t channelStride) noexcept
+{
+    if (channelCount == 1u) {
+        std::memcpy(output, input, frameCount * sizeof(Type));
+        return;
+    }
+    for (auto channel = 0u; channel < channelCount; ++channel) {
+        const Type *from = input + channel * channelStride;
+        Type *to = output + channel;
+        for (auto i = 0u; i < frameCount; ++i)
+            to[i * channelCount] = from[i];
+    }
+}
+
+template<typename Type>
+inline void Audio::DSP::Reformater::Deinterleave(const Type *input, Type *output, const std::size_t frameCount, const std::size_t channelCount, const std::size_t channelStride) noexcept
+{
+    if (channelCount == 1u) {
+        std::memcpy(output, input, frameCount * sizeof(Type));
+        return;
+    }
+    for (auto channel = 0u; channel < channelCount; ++channel) {
+        const Type *from = input + channel;
+        Type *to = output + channel * channelStride;
+        for (auto i = 0u; i < frameCount; ++i)
+            to[i] = from[i * channelCount];
+    }
+}
@@ -5,7 +5,10 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <numeric>
+#include <vector>
 
 #include <Core/Vector.hpp>
 
@@ -19,10 +22,26 @@ namespace Audio::DSP
     class Resampler;
 }
 
+/** @brief Rational resampler based on polyphase filter banks
+ *  Each output sample is a single dot product between the last inputs and one phase of the low-pass prototype filter */
 template<typename Type>
 class Audio::DSP::Resampler
 {
 public:
+    /** @brief Low-pass prototype filter split into 'interpolation' phases of 'phaseSize' taps
+     *  Phases are stored one after the other with reversed taps and scaled by the interpolation factor */
+    struct FilterBank
+    {
+        std::uint32_t interpolation { 0u };
+        std::uint32_t decimation { 0u };
+        std::uint32_t processSize { 0u };
+        std::uint32_t phaseSize { 0u };
+        Core::TinyVector<Type> coefficients {};
+    };
+
+    /** @brief Shared handle to a filter bank */
+    using FilterBankPtr = std::shared_ptr<const FilterBank>;
+
     /** @brief Interpolation factor of 1 semitone */
     static constexpr std::size_t InterpolationSemitoneFactor = 185; //7450u;  --> 5 iterations of ratio 3
 
@@ -39,6 +58,10 @@ public:
     /** @brief Get the output buffer size for a resample octave call */
     [[nodiscard]] static std::size_t GetResampleOctaveBufferSize(const std::size_t inputSize, const int nOctave) noexcept;
 
+    /** @brief Get the filter bank of a resampling ratio, it is designed on first use then shared by every resampler
+     *  The prototype filter has 'max(interpolation, decimation) * processSize' taps */
+    [[nodiscard]] static FilterBankPtr GetFilterBank(const std::uint32_t interpolation, const std::uint32_t decimation, const std::uint32_t processSize);
+
 
     /** @brief Resample the inputBuffer into outputBuffer, outputBuffer size must fit the semitone, call GetResamplingSizeSemitone to get the outputBuffer size */
     template<bool Accumulate, unsigned ProcessSize>
@@ -53,10 +76,18 @@ public:
     void resampleSampleRate(const Type *inputBuffer, Type *outputBuffer, const std::size_t inputSize, const SampleRate inSampleRate, const SampleRate outSampleRate, const std::size_t inputOffset = 0u) noexcept;
 
 private:
-    Core::TinyVector<Type> _filterCache;
-    Core::TinyVector<Type> _interpolationCache;
-    Core::TinyVector<Type> _produceCache;
+    /** @brief Last used filter bank, avoids a cache lookup while the ratio doesn't change */
+    FilterBankPtr _bank {};
+
+    static inline std::mutex _BanksMutex {};
+    static inline std::vector<FilterBankPtr> _Banks {};
+
+    /** @brief Get the filter bank of a ratio, starting from the last used one */
+    [[nodiscard]] const FilterBank &filterBank(const std::uint32_t interpolation, const std::uint32_t decimation, const std::uint32_t processSize);
 
+    /** @brief Resample 'inputSize' samples from 'inputOffset', samples before the input begin are considered as silence */
+    template<bool Accumulate>
+    void resamplePolyphase(const Type *inputBuffer, Type *outputBuffer, const std::size_t inputSize, const std::size_t inputOffset, const FilterBank &bank) noexcept;
 };
 
 #include "Resampler.ipp"
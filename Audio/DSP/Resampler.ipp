@@ -3,8 +3,6 @@
  * @ Description: Resampler
  */
 
-#include <iostream>
-
 template<typename Type>
 inline std::size_t Audio::DSP::Resampler<Type>::GetResampleSemitoneBufferSize(const std::size_t inputSize, const bool upScale) noexcept
 {
@@ -33,222 +31,124 @@ inline std::size_t Audio::DSP::Resampler<Type>::GetResampleSampleRateBufferSize(
 }
 
 template<typename Type>
-template<bool Accumulate, unsigned ProcessSize>
-inline void Audio::DSP::Resampler<Type>::resampleSemitone(const Type *inputBuffer, Type *outputBuffer, const std::size_t inputSize, const SampleRate sampleRate, const bool upScale, const std::size_t inputOffset) noexcept
+inline typename Audio::DSP::Resampler<Type>::FilterBankPtr Audio::DSP::Resampler<Type>::GetFilterBank(const std::uint32_t interpolation, const std::uint32_t decimation, const std::uint32_t processSize)
 {
-    const std::uint32_t iFactor = upScale ? Resampler::InterpolationSemitoneFactor : Resampler::DecimationSemitoneFactor;
-    const std::uint32_t dFactor = upScale ? Resampler::DecimationSemitoneFactor : Resampler::InterpolationSemitoneFactor;
-    const std::uint32_t factor = std::max(iFactor, dFactor);
-    const auto factorScale = static_cast<float>(iFactor);
+    std::lock_guard<std::mutex> lock(_BanksMutex);
+
+    for (const auto &bank : _Banks) {
+        if (bank->interpolation == interpolation && bank->decimation == decimation && bank->processSize == processSize)
+            return bank;
+    }
+    const auto factor = std::max(interpolation, decimation);
+    // Only the cutoff relative to the sample rate matters, it is the Nyquist frequency of the lowest rate
     const Filter::FIRSpecs filterSpecs(
         Filter::BasicType::LowPass,
         Filter::WindowType::Hanning,
-        static_cast<std::uint32_t>(factor * ProcessSize),
-        static_cast<float>(sampleRate),
-        static_cast<float>(sampleRate) / 2.0f / static_cast<float>(factor),
+        factor * processSize,
+        2.0f * static_cast<float>(factor),
+        1.0f,
         0.0f,
         1.0f
     );
-
-    // std::cout << "Resample: " << inputSize << ", " << upScale << std::endl;
-
-    _filterCache.resize(filterSpecs.filterSize);
-    Filter::GenerateFilter(filterSpecs, _filterCache.data());
-
-    auto trackIdx = 0ul;
-    auto outIdx = 0ul;
-    auto operationCount = 1ul;
-    for (auto i = inputOffset; i < ProcessSize ; ++i) {
-        for (auto j = 0ul; j < iFactor; ++j) {
-            if (trackIdx % dFactor) {
-                ++trackIdx;
-                continue;
-            }
-            Type sample {};
-            for (auto k = 0ul; k < operationCount; ++k) {
-                sample += inputBuffer[i - k] * _filterCache[static_cast<std::uint32_t>(j + k * iFactor)];
-            }
-            if constexpr (Accumulate)
-                outputBuffer[outIdx] += sample * factorScale;
-            else
-                outputBuffer[outIdx] = sample * factorScale;
-            ++outIdx;
-            ++trackIdx;
+    Core::TinyVector<float> prototype(filterSpecs.filterSize);
+    Filter::GenerateFilter(filterSpecs, prototype.data());
+
+    auto bank = std::make_shared<FilterBank>();
+    bank->interpolation = interpolation;
+    bank->decimation = decimation;
+    bank->processSize = processSize;
+    bank->phaseSize = (filterSpecs.filterSize + interpolation - 1u) / interpolation;
+    bank->coefficients.resize(interpolation * bank->phaseSize);
+    // Tap 'k' of phase 'p' is the prototype tap 'p + k * interpolation', missing taps are zero
+    for (auto phase = 0u; phase < interpolation; ++phase) {
+        auto *coefficients = bank->coefficients.data() + phase * bank->phaseSize;
+        for (auto k = 0u; k < bank->phaseSize; ++k) {
+            const auto tap = phase + k * interpolation;
+            coefficients[bank->phaseSize - 1u - k] = tap < filterSpecs.filterSize ?
+                static_cast<Type>(prototype[tap] * static_cast<float>(interpolation)) : Type {};
         }
-        ++operationCount;
     }
-    const auto end = inputOffset + inputSize;
-    for (auto i = inputOffset > ProcessSize ? inputOffset : ProcessSize; i < end; ++i) {
-        // const auto inputIdx = i - ProcessSize;
-        for (auto j = 0ul; j < iFactor; ++j) {
-            if (trackIdx % dFactor) {
-                ++trackIdx;
-                continue;
-            }
-            Type sample {};
-            for (auto k = 0ul; k < ProcessSize; ++k)
-                sample += inputBuffer[i - k] * _filterCache[static_cast<std::uint32_t>(j + k * iFactor)];
-            if constexpr (Accumulate)
-                outputBuffer[outIdx] += sample * factorScale;
-            else
-                outputBuffer[outIdx] = sample * factorScale;
-            ++outIdx;
-            ++trackIdx;
+    return _Banks.emplace_back(std::move(bank));
+}
+
+template<typename Type>
+inline const typename Audio::DSP::Resampler<Type>::FilterBank &Audio::DSP::Resampler<Type>::filterBank(const std::uint32_t interpolation, const std::uint32_t decimation, const std::uint32_t processSize)
+{
+    if (!_bank || _bank->interpolation != interpolation || _bank->decimation != decimation || _bank->processSize != processSize)
+        _bank = GetFilterBank(interpolation, decimation, processSize);
+    return *_bank;
+}
+
+template<typename Type>
+template<bool Accumulate>
+inline void Audio::DSP::Resampler<Type>::resamplePolyphase(const Type *inputBuffer, Type *outputBuffer, const std::size_t inputSize, const std::size_t inputOffset, const FilterBank &bank) noexcept
+{
+    const auto outputSize = (inputSize * bank.interpolation) / bank.decimation;
+    const auto phaseSize = bank.phaseSize;
+    // Last input sample and phase of the current output in the upsampled signal
+    auto inputIdx = inputOffset;
+    auto phase = 0ul;
+
+    for (auto outIdx = 0ul; outIdx < outputSize; ++outIdx) {
+        const Type *coefficients = bank.coefficients.data() + phase * phaseSize;
+        Type sample {};
+        if (inputIdx + 1ul >= phaseSize) {
+            const Type *input = inputBuffer + inputIdx + 1ul - phaseSize;
+            for (auto k = 0ul; k < phaseSize; ++k)
+                sample += input[k] * coefficients[k];
+        } else {
+            const auto zeroPad = phaseSize - 1ul - inputIdx;
+            for (auto k = zeroPad; k < phaseSize; ++k)
+                sample += inputBuffer[k - zeroPad] * coefficients[k];
         }
+        if constexpr (Accumulate)
+            outputBuffer[outIdx] += sample;
+        else
+            outputBuffer[outIdx] = sample;
+        phase += bank.decimation;
+        inputIdx += phase / bank.interpolation;
+        phase %= bank.interpolation;
     }
 }
 
 template<typename Type>
 template<bool Accumulate, unsigned ProcessSize>
-inline void Audio::DSP::Resampler<Type>::resampleOctave(const Type *inputBuffer, Type *outputBuffer, const std::size_t inputSize, const SampleRate sampleRate, const int nOctave, const std::size_t inputOffset) noexcept
+inline void Audio::DSP::Resampler<Type>::resampleSemitone(const Type *inputBuffer, Type *outputBuffer, const std::size_t inputSize, const SampleRate, const bool upScale, const std::size_t inputOffset) noexcept
 {
-    const std::uint32_t factor = static_cast<std::uint32_t>(std::pow(2, std::abs(nOctave)));
-    const auto factorScale = static_cast<float>(nOctave > 0 ? 1 : factor);
-    const Filter::FIRSpecs filterSpecs(
-        Filter::BasicType::LowPass,
-        Filter::WindowType::Hanning,
-        static_cast<std::uint32_t>(factor * ProcessSize),
-        static_cast<float>(sampleRate),
-        static_cast<float>(sampleRate) / 2.0f / static_cast<float>(factor),
-        0.0f,
-        1.0f
-    );
+    const std::uint32_t iFactor = upScale ? Resampler::InterpolationSemitoneFactor : Resampler::DecimationSemitoneFactor;
+    const std::uint32_t dFactor = upScale ? Resampler::DecimationSemitoneFactor : Resampler::InterpolationSemitoneFactor;
+
+    resamplePolyphase<Accumulate>(inputBuffer, outputBuffer, inputSize, inputOffset, filterBank(iFactor, dFactor, ProcessSize));
+}
 
-    _filterCache.resize(filterSpecs.filterSize);
-    Filter::GenerateFilter(filterSpecs, _filterCache.data());
+template<typename Type>
+template<bool Accumulate, unsigned ProcessSize>
+inline void Audio::DSP::Resampler<Type>::resampleOctave(const Type *inputBuffer, Type *outputBuffer, const std::size_t inputSize, const SampleRate, const int nOctave, const std::size_t inputOffset) noexcept
+{
+    const std::uint32_t factor = 1u << static_cast<std::uint32_t>(std::abs(nOctave));
 
     if (nOctave == 0) {
-        std::memcpy(outputBuffer, inputBuffer + inputOffset, inputSize * sizeof(Type));
+        if constexpr (Accumulate) {
+            for (auto i = 0ul; i < inputSize; ++i)
+                outputBuffer[i] += inputBuffer[inputOffset + i];
+        } else
+            std::memcpy(outputBuffer, inputBuffer + inputOffset, inputSize * sizeof(Type));
     } else if (nOctave < 0) {
         // Only filter + interpolation
-        auto outIdx = 0ul;
-        auto operationCount = 1ul;
-        for (auto i = inputOffset; i < ProcessSize; ++i) {
-            const auto inputIdx = i - (operationCount - 1);
-            for (auto j = 0ul; j < factor; ++j) {
-                Type sample {};
-                for (auto k = 0ul; k < operationCount; ++k)
-                    sample += inputBuffer[inputIdx + k] * _filterCache[static_cast<std::uint32_t>(j + k * factor)];
-                if constexpr (Accumulate)
-                    outputBuffer[outIdx] += sample * factorScale;
-                else
-                    outputBuffer[outIdx] = sample * factorScale;
-                ++outIdx;
-            }
-            ++operationCount;
-        }
-        const auto end = inputOffset + inputSize;
-        for (auto i = inputOffset ? inputOffset : ProcessSize; i < end; ++i) {
-            const auto inputIdx = i - ProcessSize;
-            for (auto j = 0ul; j < factor; ++j) {
-                Type sample {};
-                for (auto k = 0ul; k < ProcessSize; ++k)
-                    sample += inputBuffer[inputIdx + k] * _filterCache[static_cast<std::uint32_t>(j + k * factor)];
-                if constexpr (Accumulate)
-                    outputBuffer[outIdx] += sample * factorScale;
-                else
-                    outputBuffer[outIdx] = sample * factorScale;
-                ++outIdx;
-            }
-        }
+        resamplePolyphase<Accumulate>(inputBuffer, outputBuffer, inputSize, inputOffset, filterBank(factor, 1u, ProcessSize));
     } else {
         // Only filter + decimation
-        const auto filterMinusOne = filterSpecs.filterSize - 1;
-        std::uint32_t zeroPads = filterMinusOne;
-        auto outIdx = 0ul;
-        auto i = inputOffset;
-        for (; i < filterSpecs.filterSize; i += factor) {
-            const auto count = filterSpecs.filterSize - zeroPads;
-            Type sample {};
-            std::uint32_t k = zeroPads;
-            for (auto j = 0u; j < count; ++j, ++k)
-                sample += inputBuffer[j] * _filterCache[k];
-            if constexpr (Accumulate)
-                outputBuffer[outIdx] += sample * factorScale;
-            else
-                outputBuffer[outIdx] = sample * factorScale;
-            zeroPads -= static_cast<std::uint32_t>(factor);
-            ++outIdx;
-        }
-        const auto end = inputOffset + inputSize;
-        for (; i < end; i += factor) {
-            const auto iMinusFilterMinusOne = i - filterMinusOne;
-            Type sample {};
-            for (auto j = 0u; j < filterSpecs.filterSize; ++j)
-                sample += inputBuffer[iMinusFilterMinusOne + j] * _filterCache[j];
-            if constexpr (Accumulate)
-                outputBuffer[outIdx] += sample * factorScale;
-            else
-                outputBuffer[outIdx] = sample * factorScale;
-            ++outIdx;
-        }
+        resamplePolyphase<Accumulate>(inputBuffer, outputBuffer, inputSize, inputOffset, filterBank(1u, factor, ProcessSize));
     }
 }
 
-
 template<typename Type>
 template<bool Accumulate, unsigned ProcessSize>
 inline void Audio::DSP::Resampler<Type>::resampleSampleRate(const Type *inputBuffer, Type *outputBuffer, const std::size_t inputSize, const SampleRate inSampleRate, const SampleRate outSampleRate, const std::size_t inputOffset) noexcept
 {
     const auto gcd = std::gcd(inSampleRate, outSampleRate);
-    const std::uint32_t iFactor = inSampleRate / gcd;
-    const std::uint32_t dFactor = outSampleRate / gcd;
-    const std::uint32_t factor = std::max(iFactor, dFactor);
-    const auto factorScale = static_cast<float>(iFactor);
-    const Filter::FIRSpecs filterSpecs(
-        Filter::BasicType::LowPass,
-        Filter::WindowType::Hanning,
-        static_cast<std::uint32_t>(factor * ProcessSize),
-        static_cast<float>(inSampleRate),
-        static_cast<float>(inSampleRate) / 2.0f / static_cast<float>(factor),
-        0.0f,
-        1.0f
-    );
+    const std::uint32_t iFactor = outSampleRate / gcd;
+    const std::uint32_t dFactor = inSampleRate / gcd;
 
-    // std::cout << "Resample: " << inputSize << ", " << upScale << std::endl;
-
-    _filterCache.resize(filterSpecs.filterSize);
-    Filter::GenerateFilter(filterSpecs, _filterCache.data());
-
-    auto trackIdx = 0ul;
-    auto outIdx = 0ul;
-    auto operationCount = 1ul;
-    for (auto i = inputOffset; i < ProcessSize ; ++i) {
-        for (auto j = 0ul; j < iFactor; ++j) {
-            if (trackIdx % dFactor) {
-                ++trackIdx;
-                continue;
-            }
-            Type sample {};
-            for (auto k = 0ul; k < operationCount; ++k) {
-                sample += inputBuffer[i - k] * _filterCache[static_cast<std::uint32_t>(j + k * iFactor)];
-            }
-            if constexpr (Accumulate)
-                outputBuffer[outIdx] += sample * factorScale;
-            else
-                outputBuffer[outIdx] = sample * factorScale;
-            ++outIdx;
-            ++trackIdx;
-        }
-        ++operationCount;
-    }
-    const auto end = inputOffset + inputSize;
-    for (auto i = inputOffset > ProcessSize ? inputOffset : ProcessSize; i < end; ++i) {
-        // const auto inputIdx = i - ProcessSize;
-        for (auto j = 0ul; j < iFactor; ++j) {
-            if (trackIdx % dFactor) {
-                ++trackIdx;
-                continue;
-            }
-            Type sample {};
-            for (auto k = 0ul; k < ProcessSize; ++k)
-                sample += inputBuffer[i - k] * _filterCache[static_cast<std::uint32_t>(j + k * iFactor)];
-            if constexpr (Accumulate)
-                outputBuffer[outIdx] += sample * factorScale;
-            else
-                outputBuffer[outIdx] = sample * factorScale;
-            ++outIdx;
-            ++trackIdx;
-        }
-    }
+    resamplePolyphase<Accumulate>(inputBuffer, outputBuffer, inputSize, inputOffset, filterBank(iFactor, dFactor, ProcessSize));
 }
@@ -0,0 +1,182 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: Thin wrappers over the vector instruction set selected at compile time
+ *  Every translation unit compiled with other instruction set flags gets its own inline namespace,
+ *  so kernels compiled for a wider instruction set never leak into the code of another one
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX512F__) || defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+# include <arm_neon.h>
+#endif
+
+#if defined(__AVX512F__)
+# define AUDIO_SIMD_TARGET TargetAVX512
+#elif defined(__AVX2__)
+# define AUDIO_SIMD_TARGET TargetAVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# define AUDIO_SIMD_TARGET TargetSSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+# define AUDIO_SIMD_TARGET TargetNEON
+#else
+# define AUDIO_SIMD_TARGET TargetScalar
+#endif
+
+namespace Audio::DSP::Simd
+{
+    /** @brief Vector instruction sets */
+    enum class InstructionSet : std::uint8_t {
+        Scalar = 0u,
+        SSE2,
+        AVX2,
+        AVX512,
+        NEON
+    };
+
+    /** @brief Widest lane count of every instruction set, data laid out for a lane count works for every narrower one */
+    constexpr std::size_t MaxWidth = 16u;
+
+    /** @brief Check if a pointer is aligned on a given byte boundary */
+    [[nodiscard]] inline bool IsAligned(const void *data, const std::size_t alignment) noexcept
+        { return !(reinterpret_cast<std::uintptr_t>(data) & (alignment - 1u)); }
+
+    inline namespace AUDIO_SIMD_TARGET
+    {
+        /** @brief Float lanes of a register, 'Width' is 1 when no instruction set is available
+         *  'Shift' moves every lane up by one and inserts 'first' in the lowest lane, 'Last' extracts the highest lane
+         *  'Round' rounds to the nearest integer, values must fit in a 32 bits integer */
+        template<InstructionSet Set>
+        struct FloatLanes;
+
+        template<>
+        struct FloatLanes<InstructionSet::Scalar>
+        {
+            using Register = float;
+            static constexpr std::size_t Width = 1u;
+
+            [[nodiscard]] static Register Load(const float *data) noexcept { return *data; }
+            [[nodiscard]] static Register LoadUnaligned(const float *data) noexcept { return *data; }
+            static void Store(float *data, const Register value) noexcept { *data = value; }
+            static void StoreUnaligned(float *data, const Register value) noexcept { *data = value; }
+            [[nodiscard]] static Register Set(const float value) noexcept { return value; }
+            [[nodiscard]] static Register Add(const Register lhs, const Register rhs) noexcept { return lhs + rhs; }
+            [[nodiscard]] static Register Sub(const Register lhs, const Register rhs) noexcept { return lhs - rhs; }
+            [[nodiscard]] static Register Mul(const Register lhs, const Register rhs) noexcept { return lhs * rhs; }
+            [[nodiscard]] static Register Round(const Register value) noexcept { return std::nearbyint(value); }
+            [[nodiscard]] static Register Shift(const Register, const float first) noexcept { return first; }
+            [[nodiscard]] static float Last(const Register value) noexcept { return value; }
+        };
+
+#if defined(__AVX512F__)
+        template<>
+        struct FloatLanes<InstructionSet::AVX512>
+        {
+            using Register = __m512;
+            static constexpr std::size_t Width = 16u;
+
+            [[nodiscard]] static Register Load(const float *data) noexcept { return _mm512_load_ps(data); }
+            [[nodiscard]] static Register LoadUnaligned(const float *data) noexcept { return _mm512_loadu_ps(data); }
+            static void Store(float *data, const Register value) noexcept { _mm512_store_ps(data, value); }
+            static void StoreUnaligned(float *data, const Register value) noexcept { _mm512_storeu_ps(data, value); }
+            [[nodiscard]] static Register Set(const float value) noexcept { return _mm512_set1_ps(value); }
+            [[nodiscard]] static Register Add(const Register lhs, const Register rhs) noexcept { return _mm512_add_ps(lhs, rhs); }
+            [[nodiscard]] static Register Sub(const Register lhs, const Register rhs) noexcept { return _mm512_sub_ps(lhs, rhs); }
+            [[nodiscard]] static Register Mul(const Register lhs, const Register rhs) noexcept { return _mm512_mul_ps(lhs, rhs); }
+            [[nodiscard]] static Register Round(const Register value) noexcept { return _mm512_roundscale_ps(value, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+            [[nodiscard]] static Register Shift(const Register value, const float first) noexcept
+                { return _mm512_mask_blend_ps(1u, _mm512_permutexvar_ps(_mm512_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14), value), _mm512_set1_ps(first)); }
+            [[nodiscard]] static float Last(const Register value) noexcept { return _mm512_cvtss_f32(_mm512_permutexvar_ps(_mm512_set1_epi32(15), value)); }
+        };
+#endif
+
+#if defined(__AVX2__)
+        template<>
+        struct FloatLanes<InstructionSet::AVX2>
+        {
+            using Register = __m256;
+            static constexpr std::size_t Width = 8u;
+
+            [[nodiscard]] static Register Load(const float *data) noexcept { return _mm256_load_ps(data); }
+            [[nodiscard]] static Register LoadUnaligned(const float *data) noexcept { return _mm256_loadu_ps(data); }
+            static void Store(float *data, const Register value) noexcept { _mm256_store_ps(data, value); }
+            static void StoreUnaligned(float *data, const Register value) noexcept { _mm256_storeu_ps(data, value); }
+            [[nodiscard]] static Register Set(const float value) noexcept { return _mm256_set1_ps(value); }
+            [[nodiscard]] static Register Add(const Register lhs, const Register rhs) noexcept { return _mm256_add_ps(lhs, rhs); }
+            [[nodiscard]] static Register Sub(const Register lhs, const Register rhs) noexcept { return _mm256_sub_ps(lhs, rhs); }
+            [[nodiscard]] static Register Mul(const Register lhs, const Register rhs) noexcept { return _mm256_mul_ps(lhs, rhs); }
+            [[nodiscard]] static Register Round(const Register value) noexcept { return _mm256_round_ps(value, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+            [[nodiscard]] static Register Shift(const Register value, const float first) noexcept
+                { return _mm256_blend_ps(_mm256_permutevar8x32_ps(value, _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6)), _mm256_set1_ps(first), 1); }
+            [[nodiscard]] static float Last(const Register value) noexcept { return _mm256_cvtss_f32(_mm256_permutevar8x32_ps(value, _mm256_set1_epi32(7))); }
+        };
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        template<>
+        struct FloatLanes<InstructionSet::SSE2>
+        {
+            using Register = __m128;
+            static constexpr std::size_t Width = 4u;
+
+            [[nodiscard]] static Register Load(const float *data) noexcept { return _mm_load_ps(data); }
+            [[nodiscard]] static Register LoadUnaligned(const float *data) noexcept { return _mm_loadu_ps(data); }
+            static void Store(float *data, const Register value) noexcept { _mm_store_ps(data, value); }
+            static void StoreUnaligned(float *data, const Register value) noexcept { _mm_storeu_ps(data, value); }
+            [[nodiscard]] static Register Set(const float value) noexcept { return _mm_set1_ps(value); }
+            [[nodiscard]] static Register Add(const Register lhs, const Register rhs) noexcept { return _mm_add_ps(lhs, rhs); }
+            [[nodiscard]] static Register Sub(const Register lhs, const Register rhs) noexcept { return _mm_sub_ps(lhs, rhs); }
+            [[nodiscard]] static Register Mul(const Register lhs, const Register rhs) noexcept { return _mm_mul_ps(lhs, rhs); }
+            [[nodiscard]] static Register Round(const Register value) noexcept { return _mm_cvtepi32_ps(_mm_cvtps_epi32(value)); }
+            [[nodiscard]] static Register Shift(const Register value, const float first) noexcept
+                { return _mm_move_ss(_mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(value), 4)), _mm_set_ss(first)); }
+            [[nodiscard]] static float Last(const Register value) noexcept { return _mm_cvtss_f32(_mm_shuffle_ps(value, value, _MM_SHUFFLE(3, 3, 3, 3))); }
+        };
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+        template<>
+        struct FloatLanes<InstructionSet::NEON>
+        {
+            using Register = float32x4_t;
+            static constexpr std::size_t Width = 4u;
+
+            [[nodiscard]] static Register Load(const float *data) noexcept { return vld1q_f32(data); }
+            [[nodiscard]] static Register LoadUnaligned(const float *data) noexcept { return vld1q_f32(data); }
+            static void Store(float *data, const Register value) noexcept { vst1q_f32(data, value); }
+            static void StoreUnaligned(float *data, const Register value) noexcept { vst1q_f32(data, value); }
+            [[nodiscard]] static Register Set(const float value) noexcept { return vdupq_n_f32(value); }
+            [[nodiscard]] static Register Add(const Register lhs, const Register rhs) noexcept { return vaddq_f32(lhs, rhs); }
+            [[nodiscard]] static Register Sub(const Register lhs, const Register rhs) noexcept { return vsubq_f32(lhs, rhs); }
+            [[nodiscard]] static Register Mul(const Register lhs, const Register rhs) noexcept { return vmulq_f32(lhs, rhs); }
+            [[nodiscard]] static Register Round(const Register value) noexcept
+                { return vcvtq_f32_s32(vcvtq_s32_f32(vaddq_f32(value, vbslq_f32(vdupq_n_u32(0x80000000u), value, vdupq_n_f32(0.5f))))); }
+            [[nodiscard]] static Register Shift(const Register value, const float first) noexcept { return vextq_f32(vdupq_n_f32(first), value, 3); }
+            [[nodiscard]] static float Last(const Register value) noexcept { return vgetq_lane_f32(value, 3); }
+        };
+#endif
+
+        /** @brief Widest instruction set enabled at compile time */
+        constexpr InstructionSet NativeInstructionSet =
+#if defined(__AVX512F__)
+            InstructionSet::AVX512;
+#elif defined(__AVX2__)
+            InstructionSet::AVX2;
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+            InstructionSet::SSE2;
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+            InstructionSet::NEON;
+#else
+            InstructionSet::Scalar;
+#endif
+
+        /** @brief Float lanes of the native instruction set */
+        using NativeFloatLanes = FloatLanes<NativeInstructionSet>;
+    }
+}
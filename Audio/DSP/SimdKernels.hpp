@@ -0,0 +1,323 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: DSP kernels written once over the float lanes of an instruction set
+ *  Only the kernel translation units include this file, each one with its own instruction set flags
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "Simd.hpp"
+
+namespace Audio::DSP::Simd
+{
+    inline namespace AUDIO_SIMD_TARGET
+    {
+        /** @brief Sum a group of inputs into the output in a single pass
+         *  If 'accumulate' is true the group is added to the output, if 'scale' is true the sum is multiplied by the ratio */
+        template<typename Lanes, bool Aligned>
+        void MergeGroupKernel(const float * const *inputs, const std::size_t inputCount, float *output, const std::size_t size,
+                const float ratio, const bool accumulate, const bool scale) noexcept;
+
+        /** @brief Select the aligned or unaligned merge kernel */
+        template<typename Lanes>
+        void MergeGroup(const float * const *inputs, const std::size_t inputCount, float *output, const std::size_t size,
+                const float ratio, const bool accumulate, const bool scale) noexcept;
+
+        /** @brief Compute 'outputSize' dot products of a FIR filter over a contiguous history: output[i] = gain * sum(samples[i + k] * coefficients[k])
+         *  Several outputs are computed per iteration, each tap is broadcasted and the taps are summed in order so every instruction set gives the same result as long as products and sums are not contracted (-ffp-contract=off) */
+        template<typename Lanes>
+        void Convolve(const float *samples, const float *coefficients, const std::size_t filterSize, float *output, const std::size_t outputSize,
+                const float gain) noexcept;
+
+        /** @brief Filter a block through a serial cascade of biquad sections
+         *  Sections are laid out as 'stride' b0, b1, b2, -a1, -a2 coefficients followed by 'stride' s1, s2 registers.
+         *  Each lane runs one section on the output of its lower lane one sample earlier, the pipeline is filled and drained within the block */
+        template<typename Lanes>
+        void BiquadCascade(const float *coefficients, float *registers, const std::size_t stride, const std::size_t sectionCount,
+                const float *input, float *output, const std::size_t size) noexcept;
+
+        /** @brief Filter one block per filter through a bank of independent biquad cascades, each lane runs one filter
+         *  Section 's' of filter 'f' has its coefficient 'c' at '(s * 5 + c) * stride + f' and its register 'r' at '(s * 2 + r) * stride + f' */
+        template<typename Lanes>
+        void BiquadBank(const float *coefficients, float *registers, const std::size_t stride, const std::size_t sectionCount,
+                const float * const *inputs, float * const *outputs, const std::size_t filterCount, const std::size_t size) noexcept;
+
+        /** @brief Multiply a block by a gain buffer and a constant gain: output[i] = input[i] * gains[i] * gain
+         *  If 'accumulate' is true the result is added to the output */
+        template<typename Lanes>
+        void MultiplyGains(const float *input, const float *gains, float *output, const std::size_t size,
+                const float gain, const bool accumulate) noexcept;
+
+        /** @brief Evaluate sin(2 * pi * turns) for turns in [-0.5, 0.5], the polynomial error is below -130 dB */
+        template<typename Lanes>
+        [[nodiscard]] typename Lanes::Register SinePolynomial(const typename Lanes::Register turns) noexcept;
+
+        /** @brief Render a phase modulated sine: output[i] = gains[i] * sin(2 * pi * (phase + i * increment + modulation[i] * modulationScale))
+         *  Phases are in turns, 'gains' and 'modulation' may be null. If 'accumulate' is true the sine is added to the output
+         *  The modulation may be read from the output buffer itself */
+        template<typename Lanes>
+        void ModulatedSine(float *output, const float *gains, const float *modulation, const float modulationScale,
+                const double phase, const double increment, const std::size_t size, const bool accumulate) noexcept;
+    }
+}
+
+template<typename Lanes, bool Aligned>
+inline void Audio::DSP::Simd::AUDIO_SIMD_TARGET::MergeGroupKernel(const float * const *inputs, const std::size_t inputCount, float *output, const std::size_t size,
+        const float ratio, const bool accumulate, const bool scale) noexcept
+{
+    constexpr auto Load = [](const float *data) {
+        if constexpr (Aligned)
+            return Lanes::Load(data);
+        else
+            return Lanes::LoadUnaligned(data);
+    };
+    constexpr auto Store = [](float *data, const typename Lanes::Register value) {
+        if constexpr (Aligned)
+            Lanes::Store(data, value);
+        else
+            Lanes::StoreUnaligned(data, value);
+    };
+    const auto ratioLanes = Lanes::Set(ratio);
+    const auto vectorSize = size - size % Lanes::Width;
+    std::size_t i = 0u;
+
+    for (; i < vectorSize; i += Lanes::Width) {
+        auto sample = accumulate ? Load(output + i) : Load(inputs[0] + i);
+        for (auto k = accumulate ? 0u : 1u; k < inputCount; ++k)
+            sample = Lanes::Add(sample, Load(inputs[k] + i));
+        Store(output + i, scale ? Lanes::Mul(sample, ratioLanes) : sample);
+    }
+    for (; i < size; ++i) {
+        float sample = accumulate ? output[i] : inputs[0][i];
+        for (auto k = accumulate ? 0u : 1u; k < inputCount; ++k)
+            sample += inputs[k][i];
+        output[i] = scale ? sample * ratio : sample;
+    }
+}
+
+template<typename Lanes>
+inline void Audio::DSP::Simd::AUDIO_SIMD_TARGET::MergeGroup(const float * const *inputs, const std::size_t inputCount, float *output, const std::size_t size,
+        const float ratio, const bool accumulate, const bool scale) noexcept
+{
+    // Buffers are cacheline aligned, aligned accesses are used unless a view points inside a buffer
+    constexpr auto Alignment = sizeof(typename Lanes::Register);
+    bool aligned = IsAligned(output, Alignment);
+
+    for (auto k = 0u; k < inputCount; ++k)
+        aligned &= IsAligned(inputs[k], Alignment);
+    if (aligned)
+        MergeGroupKernel<Lanes, true>(inputs, inputCount, output, size, ratio, accumulate, scale);
+    else
+        MergeGroupKernel<Lanes, false>(inputs, inputCount, output, size, ratio, accumulate, scale);
+}
+
+template<typename Lanes>
+inline void Audio::DSP::Simd::AUDIO_SIMD_TARGET::Convolve(const float *samples, const float *coefficients, const std::size_t filterSize, float *output, const std::size_t outputSize,
+        const float gain) noexcept
+{
+    constexpr auto Width = Lanes::Width;
+    constexpr auto Unroll = 4u;
+    const auto gainLanes = Lanes::Set(gain);
+    std::size_t i = 0u;
+
+    // Independent accumulators hide the latency of the additions
+    for (; i + Unroll * Width <= outputSize; i += Unroll * Width) {
+        typename Lanes::Register sums[Unroll];
+        for (auto u = 0u; u < Unroll; ++u)
+            sums[u] = Lanes::Set(0.0f);
+        for (auto k = 0u; k < filterSize; ++k) {
+            const auto tap = Lanes::Set(coefficients[k]);
+            for (auto u = 0u; u < Unroll; ++u)
+                sums[u] = Lanes::Add(sums[u], Lanes::Mul(Lanes::LoadUnaligned(samples + i + u * Width + k), tap));
+        }
+        for (auto u = 0u; u < Unroll; ++u)
+            Lanes::StoreUnaligned(output + i + u * Width, Lanes::Mul(sums[u], gainLanes));
+    }
+    for (; i + Width <= outputSize; i += Width) {
+        auto sum = Lanes::Set(0.0f);
+        for (auto k = 0u; k < filterSize; ++k)
+            sum = Lanes::Add(sum, Lanes::Mul(Lanes::LoadUnaligned(samples + i + k), Lanes::Set(coefficients[k])));
+        Lanes::StoreUnaligned(output + i, Lanes::Mul(sum, gainLanes));
+    }
+    for (; i < outputSize; ++i) {
+        float sum = 0.0f;
+        for (auto k = 0u; k < filterSize; ++k)
+            sum += samples[i + k] * coefficients[k];
+        output[i] = sum * gain;
+    }
+}
+
+template<typename Lanes>
+inline void Audio::DSP::Simd::AUDIO_SIMD_TARGET::BiquadCascade(const float *coefficients, float *registers, const std::size_t stride, const std::size_t sectionCount,
+        const float *input, float *output, const std::size_t size) noexcept
+{
+    constexpr auto Width = Lanes::Width;
+
+    // Sections are processed by groups of 'Width', sections past the count are identities
+    for (std::size_t group = 0u; group < sectionCount; group += Width, input = output) {
+        const float * const b0 = coefficients + group;
+        const float * const b1 = b0 + stride;
+        const float * const b2 = b1 + stride;
+        const float * const a1 = b2 + stride;
+        const float * const a2 = a1 + stride;
+        float * const s1 = registers + group;
+        float * const s2 = s1 + stride;
+        float previous[Width] {};
+        // Lanes which are not filled yet or already drained keep their registers
+        const auto step = [&](const std::size_t t) {
+            for (auto k = Width; k-- > 0u;) {
+                if (t < k || t - k >= size)
+                    continue;
+                const float x = k ? previous[k - 1u] : input[t];
+                const float y = b0[k] * x + s1[k];
+                s1[k] = b1[k] * x + a1[k] * y + s2[k];
+                s2[k] = b2[k] * x + a2[k] * y;
+                previous[k] = y;
+                if (k == Width - 1u)
+                    output[t - k] = y;
+            }
+        };
+        std::size_t t = 0u;
+
+        for (; t < Width - 1u; ++t)
+            step(t);
+        if (t < size) {
+            const auto b0Lanes = Lanes::LoadUnaligned(b0), b1Lanes = Lanes::LoadUnaligned(b1), b2Lanes = Lanes::LoadUnaligned(b2);
+            const auto a1Lanes = Lanes::LoadUnaligned(a1), a2Lanes = Lanes::LoadUnaligned(a2);
+            auto s1Lanes = Lanes::LoadUnaligned(s1), s2Lanes = Lanes::LoadUnaligned(s2);
+            auto y = Lanes::LoadUnaligned(previous);
+            for (; t < size; ++t) {
+                const auto x = Lanes::Shift(y, input[t]);
+                y = Lanes::Add(Lanes::Mul(b0Lanes, x), s1Lanes);
+                s1Lanes = Lanes::Add(Lanes::Add(Lanes::Mul(b1Lanes, x), Lanes::Mul(a1Lanes, y)), s2Lanes);
+                s2Lanes = Lanes::Add(Lanes::Mul(b2Lanes, x), Lanes::Mul(a2Lanes, y));
+                output[t - (Width - 1u)] = Lanes::Last(y);
+            }
+            Lanes::StoreUnaligned(s1, s1Lanes);
+            Lanes::StoreUnaligned(s2, s2Lanes);
+            Lanes::StoreUnaligned(previous, y);
+        }
+        for (; t < size + Width - 1u; ++t)
+            step(t);
+    }
+}
+
+template<typename Lanes>
+inline void Audio::DSP::Simd::AUDIO_SIMD_TARGET::BiquadBank(const float *coefficients, float *registers, const std::size_t stride, const std::size_t sectionCount,
+        const float * const *inputs, float * const *outputs, const std::size_t filterCount, const std::size_t size) noexcept
+{
+    constexpr auto Width = Lanes::Width;
+    constexpr std::size_t ChunkSize = 64u;
+    // Samples of a group of filters are interleaved so a register holds one sample of each filter
+    alignas(64) float chunk[ChunkSize * Width];
+
+    for (std::size_t group = 0u; group < filterCount; group += Width) {
+        const auto laneCount = std::min(Width, filterCount - group);
+        for (std::size_t begin = 0u; begin < size; begin += ChunkSize) {
+            const auto count = std::min(ChunkSize, size - begin);
+            for (std::size_t k = 0u; k < Width; ++k) {
+                const float * const input = k < laneCount ? inputs[group + k] + begin : nullptr;
+                for (std::size_t i = 0u; i < count; ++i)
+                    chunk[i * Width + k] = input ? input[i] : 0.0f;
+            }
+            for (std::size_t section = 0u; section < sectionCount; ++section) {
+                const float * const b0 = coefficients + section * 5u * stride + group;
+                float * const s1 = registers + section * 2u * stride + group;
+                const auto b0Lanes = Lanes::LoadUnaligned(b0), b1Lanes = Lanes::LoadUnaligned(b0 + stride), b2Lanes = Lanes::LoadUnaligned(b0 + 2u * stride);
+                const auto a1Lanes = Lanes::LoadUnaligned(b0 + 3u * stride), a2Lanes = Lanes::LoadUnaligned(b0 + 4u * stride);
+                auto s1Lanes = Lanes::LoadUnaligned(s1), s2Lanes = Lanes::LoadUnaligned(s1 + stride);
+                for (std::size_t i = 0u; i < count; ++i) {
+                    const auto x = Lanes::Load(chunk + i * Width);
+                    const auto y = Lanes::Add(Lanes::Mul(b0Lanes, x), s1Lanes);
+                    s1Lanes = Lanes::Add(Lanes::Add(Lanes::Mul(b1Lanes, x), Lanes::Mul(a1Lanes, y)), s2Lanes);
+                    s2Lanes = Lanes::Add(Lanes::Mul(b2Lanes, x), Lanes::Mul(a2Lanes, y));
+                    Lanes::Store(chunk + i * Width, y);
+                }
+                Lanes::StoreUnaligned(s1, s1Lanes);
+                Lanes::StoreUnaligned(s1 + stride, s2Lanes);
+            }
+            for (std::size_t k = 0u; k < laneCount; ++k) {
+                float * const output = outputs[group + k] + begin;
+                for (std::size_t i = 0u; i < count; ++i)
+                    output[i] = chunk[i * Width + k];
+            }
+        }
+    }
+}
+
+template<typename Lanes>
+inline void Audio::DSP::Simd::AUDIO_SIMD_TARGET::MultiplyGains(const float *input, const float *gains, float *output, const std::size_t size,
+        const float gain, const bool accumulate) noexcept
+{
+    constexpr auto Width = Lanes::Width;
+    const auto gainLanes = Lanes::Set(gain);
+    std::size_t i = 0u;
+
+    for (; i + Width <= size; i += Width) {
+        auto sample = Lanes::Mul(Lanes::Mul(Lanes::LoadUnaligned(input + i), Lanes::LoadUnaligned(gains + i)), gainLanes);
+        if (accumulate)
+            sample = Lanes::Add(Lanes::LoadUnaligned(output + i), sample);
+        Lanes::StoreUnaligned(output + i, sample);
+    }
+    for (; i < size; ++i) {
+        const auto sample = input[i] * gains[i] * gain;
+        output[i] = accumulate ? output[i] + sample : sample;
+    }
+}
+
+template<typename Lanes>
+inline typename Lanes::Register Audio::DSP::Simd::AUDIO_SIMD_TARGET::SinePolynomial(const typename Lanes::Register turns) noexcept
+{
+    // sin(2 * pi * u) = u * (0.25 - u^2) * P(u^2), the factored roots keep the error flat up to the half turn
+    const auto squared = Lanes::Mul(turns, turns);
+    auto polynomial = Lanes::Set(12.2359295f);
+    polynomial = Lanes::Add(Lanes::Mul(polynomial, squared), Lanes::Set(-38.1241798f));
+    polynomial = Lanes::Add(Lanes::Mul(polynomial, squared), Lanes::Set(67.0440140f));
+    polynomial = Lanes::Add(Lanes::Mul(polynomial, squared), Lanes::Set(-64.8346863f));
+    polynomial = Lanes::Add(Lanes::Mul(polynomial, squared), Lanes::Set(25.1327305f));
+    return Lanes::Mul(Lanes::Mul(turns, Lanes::Sub(Lanes::Set(0.25f), squared)), polynomial);
+}
+
+template<typename Lanes>
+inline void Audio::DSP::Simd::AUDIO_SIMD_TARGET::ModulatedSine(float *output, const float *gains, const float *modulation, const float modulationScale,
+        const double phase, const double increment, const std::size_t size, const bool accumulate) noexcept
+{
+    using ScalarLanes = FloatLanes<InstructionSet::Scalar>;
+    constexpr auto Width = Lanes::Width;
+    float ramp[Width];
+
+    for (auto k = 0u; k < Width; ++k)
+        ramp[k] = static_cast<float>(static_cast<double>(k) * increment);
+    const auto rampLanes = Lanes::LoadUnaligned(ramp);
+    const auto scaleLanes = Lanes::Set(modulationScale);
+    std::size_t i = 0u;
+
+    // The phase of each vector is wrapped in double precision, lanes only add a fraction of a block to it
+    const auto getPhase = [phase, increment](const std::size_t index) {
+        const auto value = phase + static_cast<double>(index) * increment;
+        return static_cast<float>(value - std::floor(value));
+    };
+    for (; i + Width <= size; i += Width) {
+        auto turns = Lanes::Add(Lanes::Set(getPhase(i)), rampLanes);
+        if (modulation)
+            turns = Lanes::Add(turns, Lanes::Mul(Lanes::LoadUnaligned(modulation + i), scaleLanes));
+        auto sample = SinePolynomial<Lanes>(Lanes::Sub(turns, Lanes::Round(turns)));
+        if (gains)
+            sample = Lanes::Mul(sample, Lanes::LoadUnaligned(gains + i));
+        if (accumulate)
+            sample = Lanes::Add(Lanes::LoadUnaligned(output + i), sample);
+        Lanes::StoreUnaligned(output + i, sample);
+    }
+    for (; i < size; ++i) {
+        auto turns = getPhase(i);
+        if (modulation)
+            turns += modulation[i] * modulationScale;
+        auto sample = SinePolynomial<ScalarLanes>(turns - ScalarLanes::Round(turns));
+        if (gains)
+            sample *= gains[i];
+        output[i] = accumulate ? output[i] + sample : sample;
+    }
+}
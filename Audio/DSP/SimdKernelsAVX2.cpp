@@ -0,0 +1,28 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: DSP kernels compiled for the AVX2 instruction set
+ */
+
+#include "SimdKernels.hpp"
+#include "Dispatch.hpp"
+
+using namespace Audio::DSP::Simd;
+
+const KernelTable *Internal::GetAVX2Kernels(void) noexcept
+{
+#if defined(__AVX2__)
+    static const KernelTable Table {
+        InstructionSet::AVX2,
+        &MergeGroup<FloatLanes<InstructionSet::AVX2>>,
+        &Convolve<FloatLanes<InstructionSet::AVX2>>,
+        &BiquadCascade<FloatLanes<InstructionSet::AVX2>>,
+        &BiquadBank<FloatLanes<InstructionSet::AVX2>>,
+        &MultiplyGains<FloatLanes<InstructionSet::AVX2>>,
+        &ModulatedSine<FloatLanes<InstructionSet::AVX2>>
+    };
+
+    return &Table;
+#else
+    return nullptr;
+#endif
+}
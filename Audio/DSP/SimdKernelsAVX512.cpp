@@ -0,0 +1,28 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: DSP kernels compiled for the AVX512 instruction set
+ */
+
+#include "SimdKernels.hpp"
+#include "Dispatch.hpp"
+
+using namespace Audio::DSP::Simd;
+
+const KernelTable *Internal::GetAVX512Kernels(void) noexcept
+{
+#if defined(__AVX512F__)
+    static const KernelTable Table {
+        InstructionSet::AVX512,
+        &MergeGroup<FloatLanes<InstructionSet::AVX512>>,
+        &Convolve<FloatLanes<InstructionSet::AVX512>>,
+        &BiquadCascade<FloatLanes<InstructionSet::AVX512>>,
+        &BiquadBank<FloatLanes<InstructionSet::AVX512>>,
+        &MultiplyGains<FloatLanes<InstructionSet::AVX512>>,
+        &ModulatedSine<FloatLanes<InstructionSet::AVX512>>
+    };
+
+    return &Table;
+#else
+    return nullptr;
+#endif
+}
@@ -0,0 +1,28 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: DSP kernels compiled for the NEON instruction set
+ */
+
+#include "SimdKernels.hpp"
+#include "Dispatch.hpp"
+
+using namespace Audio::DSP::Simd;
+
+const KernelTable *Internal::GetNEONKernels(void) noexcept
+{
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    static const KernelTable Table {
+        InstructionSet::NEON,
+        &MergeGroup<FloatLanes<InstructionSet::NEON>>,
+        &Convolve<FloatLanes<InstructionSet::NEON>>,
+        &BiquadCascade<FloatLanes<InstructionSet::NEON>>,
+        &BiquadBank<FloatLanes<InstructionSet::NEON>>,
+        &MultiplyGains<FloatLanes<InstructionSet::NEON>>,
+        &ModulatedSine<FloatLanes<InstructionSet::NEON>>
+    };
+
+    return &Table;
+#else
+    return nullptr;
+#endif
+}
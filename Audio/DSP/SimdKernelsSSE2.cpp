@@ -0,0 +1,28 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: DSP kernels compiled for the SSE2 instruction set
+ */
+
+#include "SimdKernels.hpp"
+#include "Dispatch.hpp"
+
+using namespace Audio::DSP::Simd;
+
+const KernelTable *Internal::GetSSE2Kernels(void) noexcept
+{
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    static const KernelTable Table {
+        InstructionSet::SSE2,
+        &MergeGroup<FloatLanes<InstructionSet::SSE2>>,
+        &Convolve<FloatLanes<InstructionSet::SSE2>>,
+        &BiquadCascade<FloatLanes<InstructionSet::SSE2>>,
+        &BiquadBank<FloatLanes<InstructionSet::SSE2>>,
+        &MultiplyGains<FloatLanes<InstructionSet::SSE2>>,
+        &ModulatedSine<FloatLanes<InstructionSet::SSE2>>
+    };
+
+    return &Table;
+#else
+    return nullptr;
+#endif
+}
@@ -0,0 +1,24 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: DSP kernels compiled for the Scalar instruction set
+ */
+
+#include "SimdKernels.hpp"
+#include "Dispatch.hpp"
+
+using namespace Audio::DSP::Simd;
+
+const KernelTable *Internal::GetScalarKernels(void) noexcept
+{
+    static const KernelTable Table {
+        InstructionSet::Scalar,
+        &MergeGroup<FloatLanes<InstructionSet::Scalar>>,
+        &Convolve<FloatLanes<InstructionSet::Scalar>>,
+        &BiquadCascade<FloatLanes<InstructionSet::Scalar>>,
+        &BiquadBank<FloatLanes<InstructionSet::Scalar>>,
+        &MultiplyGains<FloatLanes<InstructionSet::Scalar>>,
+        &ModulatedSine<FloatLanes<InstructionSet::Scalar>>
+    };
+
+    return &Table;
+}
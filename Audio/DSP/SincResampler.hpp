@@ -0,0 +1,100 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: Arbitrary ratio resampler
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <Core/Vector.hpp>
+
+#include <Audio/Base.hpp>
+#include <Audio/Math.hpp>
+
+namespace Audio::DSP
+{
+    template<typename Type>
+    class SincResampler;
+}
+
+/** @brief Resampler reading a source at any ratio through a windowed-sinc table
+ *  The table holds one wing of the kernel with 'PhaseCount' sub-phases per sample, kernel values between two phases are linearly interpolated.
+ *  The read position is kept between calls so a source can be played block by block while the ratio changes */
+template<typename Type>
+class Audio::DSP::SincResampler
+{
+public:
+    /** @brief Number of table entries per input sample */
+    static constexpr std::uint32_t PhaseCount = 256u;
+
+    /** @brief Trade between cost and aliasing */
+    enum class Quality : std::uint8_t
+    {
+        Low = 0u,
+        Medium,
+        High
+    };
+
+    /** @brief Number of qualities */
+    static constexpr std::uint32_t QualityCount = static_cast<std::uint32_t>(Quality::High) + 1u;
+
+    /** @brief Windowed-sinc kernel of 'tapCount' taps, from its center to its last zero crossing */
+    struct SincTable
+    {
+        std::uint32_t tapCount { 0u };
+        Core::TinyVector<float> coefficients {};
+        /** @brief Difference between an entry and the next one */
+        Core::TinyVector<float> deltas {};
+    };
+
+    /** @brief Shared handle to a table */
+    using SincTablePtr = std::shared_ptr<const SincTable>;
+
+    /** @brief Get the tap count of a quality */
+    [[nodiscard]] static constexpr std::uint32_t GetTapCount(const Quality quality) noexcept
+        { return 8u << static_cast<std::uint32_t>(quality); }
+
+    /** @brief Get the table of a tap count, it is generated on first use then shared by every resampler */
+    [[nodiscard]] static SincTablePtr GetSincTable(const std::uint32_t tapCount);
+
+    /** @brief Default constructor, uses the medium quality */
+    SincResampler(void) : SincResampler(Quality::Medium) {}
+
+    /** @brief Quality constructor */
+    SincResampler(const Quality quality) { setQuality(quality); }
+
+    /** @brief Get the tap count at unit ratio */
+    [[nodiscard]] std::uint32_t tapCount(void) const noexcept { return _table->tapCount; }
+
+    /** @brief Set the tap count, which must be even */
+    void setTapCount(const std::uint32_t tapCount);
+
+    /** @brief Set the tap count of a quality */
+    void setQuality(const Quality quality) { setTapCount(GetTapCount(quality)); }
+
+    /** @brief Use a table obtained beforehand, unlike the setters it never locks nor generates a table */
+    void setTable(const SincTablePtr &table) noexcept { _table = table; }
+
+    /** @brief Get the read position in the source */
+    [[nodiscard]] double position(void) const noexcept { return _position; }
+
+    /** @brief Set the read position in the source */
+    void setPosition(const double position) noexcept { _position = position; }
+
+    /** @brief Produce up to 'outputSize' samples from a source of 'inputSize' samples, reading 'ratio' source samples per output sample
+     *  Samples outside of the source are silence. Returns the number of samples produced, less than 'outputSize' if the source end is reached */
+    template<bool Accumulate>
+    [[nodiscard]] std::uint32_t process(const Type *input, const std::size_t inputSize, Type *output, const std::uint32_t outputSize, const double ratio) noexcept;
+
+private:
+    SincTablePtr _table {};
+    double _position { 0.0 };
+
+    static inline std::mutex _TablesMutex {};
+    static inline std::vector<SincTablePtr> _Tables {};
+};
+
+#include "SincResampler.ipp"
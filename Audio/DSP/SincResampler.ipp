@@ -0,0 +1,76 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: Arbitrary ratio resampler implementation
+ */
+
+template<typename Type>
+inline typename Audio::DSP::SincResampler<Type>::SincTablePtr Audio::DSP::SincResampler<Type>::GetSincTable(const std::uint32_t tapCount)
+{
+    std::lock_guard<std::mutex> lock(_TablesMutex);
+
+    for (const auto &table : _Tables) {
+        if (table->tapCount == tapCount)
+            return table;
+    }
+    const auto wingSize = tapCount / 2u * PhaseCount;
+    auto table = std::make_shared<SincTable>();
+    table->tapCount = tapCount;
+    table->coefficients.resize(wingSize + 1u);
+    table->deltas.resize(wingSize + 1u);
+    // Blackman window, its side lobes are low enough for short kernels
+    for (auto i = 0u; i <= wingSize; ++i) {
+        const auto x = static_cast<double>(i) / static_cast<double>(wingSize);
+        const auto window = 0.42 + 0.5 * std::cos(M_PI * x) + 0.08 * std::cos(2.0 * M_PI * x);
+        table->coefficients[i] = static_cast<float>(Utils::sinc<true>(static_cast<double>(i) / PhaseCount) * window);
+    }
+    for (auto i = 0u; i < wingSize; ++i)
+        table->deltas[i] = table->coefficients[i + 1u] - table->coefficients[i];
+    table->deltas[wingSize] = -table->coefficients[wingSize];
+    return _Tables.emplace_back(std::move(table));
+}
+
+template<typename Type>
+inline void Audio::DSP::SincResampler<Type>::setTapCount(const std::uint32_t tapCount)
+{
+    if (!_table || _table->tapCount != tapCount)
+        _table = GetSincTable(tapCount);
+}
+
+template<typename Type>
+template<bool Accumulate>
+inline std::uint32_t Audio::DSP::SincResampler<Type>::process(const Type *input, const std::size_t inputSize, Type *output, const std::uint32_t outputSize, const double ratio) noexcept
+{
+    const auto &table = *_table;
+    const auto wingEnd = static_cast<double>(table.tapCount / 2u * PhaseCount);
+    // Reading faster than the source lowers the kernel cutoff under the output Nyquist frequency, which widens the kernel
+    const auto scale = ratio > 1.0 ? 1.0 / ratio : 1.0;
+    const auto step = scale * PhaseCount;
+    const auto size = static_cast<double>(inputSize);
+    auto i = 0u;
+
+    for (; i < outputSize && _position < size; ++i) {
+        const auto index = static_cast<std::int64_t>(_position);
+        const auto fraction = _position - static_cast<double>(index);
+        Type sample {};
+        // Left wing, from the sample at the read position to the past ones
+        auto phase = fraction * step;
+        for (auto j = index; phase < wingEnd && j >= 0; phase += step, --j) {
+            const auto entry = static_cast<std::uint32_t>(phase);
+            const auto coefficient = table.coefficients[entry] + static_cast<float>(phase - entry) * table.deltas[entry];
+            sample += input[j] * static_cast<Type>(coefficient);
+        }
+        // Right wing, from the next sample to the future ones
+        phase = (1.0 - fraction) * step;
+        for (auto j = index + 1; phase < wingEnd && j < static_cast<std::int64_t>(inputSize); phase += step, ++j) {
+            const auto entry = static_cast<std::uint32_t>(phase);
+            const auto coefficient = table.coefficients[entry] + static_cast<float>(phase - entry) * table.deltas[entry];
+            sample += input[j] * static_cast<Type>(coefficient);
+        }
+        if constexpr (Accumulate)
+            output[i] += sample * static_cast<Type>(scale);
+        else
+            output[i] = sample * static_cast<Type>(scale);
+        _position += ratio;
+    }
+    return i;
+}
@@ -0,0 +1,115 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: Band-limited wavetable oscillator and noise generator
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <Core/Vector.hpp>
+
+#include <Audio/Base.hpp>
+
+namespace Audio::DSP
+{
+    class Wavetable;
+    class NoiseGenerator;
+}
+
+/** @brief Oscillator reading a mip-mapped band-limited table with a phase accumulator
+ *  Each level holds half the harmonics of the previous one, a note reads the richest level whose harmonics stay under the Nyquist frequency.
+ *  The phase is a 32 bits fixed point number wrapping once per period, so the phase of any sample index is exact */
+class Audio::DSP::Wavetable
+{
+public:
+    /** @brief Number of samples of a level */
+    static constexpr std::uint32_t TableBits = 11u;
+    static constexpr std::uint32_t TableSize = 1u << TableBits;
+
+    /** @brief Number of levels, the first one holds 'TableSize / 2' harmonics and the last one the fundamental only */
+    static constexpr std::uint32_t LevelCount = TableBits;
+
+    /** @brief Phase of a quarter period */
+    static constexpr std::uint32_t QuarterPhase = 1u << 30u;
+
+    /** @brief Waveforms with a table */
+    enum class Waveform : std::uint8_t
+    {
+        Sine = 0u,
+        Square,
+        Triangle,
+        Saw
+    };
+
+    /** @brief Levels of a waveform, each one of 'TableSize + 1' samples, the last sample repeats the first one */
+    struct Table
+    {
+        Waveform waveform { Waveform::Sine };
+        std::uint32_t levelCount { 0u };
+        Core::TinyVector<float> samples {};
+    };
+
+    /** @brief Shared handle to a table */
+    using TablePtr = std::shared_ptr<const Table>;
+
+    /** @brief Get the table of a waveform, it is generated on first use then shared by every oscillator */
+    [[nodiscard]] static TablePtr GetTable(const Waveform waveform);
+
+    /** @brief Get the phase increment of a frequency */
+    [[nodiscard]] static std::uint32_t GetPhaseIncrement(const float frequency, const SampleRate sampleRate) noexcept;
+
+    /** @brief Get the richest level without harmonics above the Nyquist frequency */
+    [[nodiscard]] static std::uint32_t GetLevel(const float frequency, const SampleRate sampleRate) noexcept;
+
+    /** @brief Default constructor, uses the sine waveform */
+    Wavetable(void) : Wavetable(Waveform::Sine) {}
+
+    /** @brief Waveform constructor */
+    Wavetable(const Waveform waveform) { setWaveform(waveform); }
+
+    /** @brief Get the waveform */
+    [[nodiscard]] Waveform waveform(void) const noexcept { return _table->waveform; }
+
+    /** @brief Set the waveform */
+    void setWaveform(const Waveform waveform);
+
+    /** @brief Generate 'size' samples of a frequency starting at 'phase', returns the phase of the next sample
+     *  A sample only depends on its index so the loop is vectorized */
+    template<bool Accumulate>
+    std::uint32_t generate(float *output, const std::size_t size, const std::uint32_t phase, const float frequency, const SampleRate sampleRate,
+            const float gain = 1.0f) const noexcept;
+
+private:
+    TablePtr _table {};
+
+    static inline std::mutex _TablesMutex {};
+    static inline std::vector<TablePtr> _Tables {};
+};
+
+/** @brief White noise from independent xorshift generators, one per lane, so consecutive samples are computed in parallel
+ *  Each instance owns its state, voices never share an atomic */
+class Audio::DSP::NoiseGenerator
+{
+public:
+    /** @brief Number of interleaved generators */
+    static constexpr std::size_t LaneCount = 8u;
+
+    /** @brief Seed constructor */
+    NoiseGenerator(const std::uint32_t seed = 1234567890u) noexcept { setSeed(seed); }
+
+    /** @brief Restart the sequence from a seed */
+    void setSeed(const std::uint32_t seed) noexcept;
+
+    /** @brief Generate 'size' samples between -1 and 1 */
+    template<bool Accumulate>
+    void generate(float *output, const std::size_t size, const float gain = 1.0f) noexcept;
+
+private:
+    std::array<std::uint32_t, LaneCount> _states {};
+};
+
+#include "Wavetable.ipp"
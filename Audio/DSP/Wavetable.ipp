@@ -0,0 +1,149 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: Band-limited wavetable oscillator and noise generator implementation
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+inline Audio::DSP::Wavetable::TablePtr Audio::DSP::Wavetable::GetTable(const Waveform waveform)
+{
+    std::lock_guard<std::mutex> lock(_TablesMutex);
+
+    for (const auto &table : _Tables) {
+        if (table->waveform == waveform)
+            return table;
+    }
+    auto table = std::make_shared<Table>();
+    table->waveform = waveform;
+    // A sine has no harmonic to remove
+    table->levelCount = waveform == Waveform::Sine ? 1u : LevelCount;
+    table->samples.resize(table->levelCount * (TableSize + 1u));
+    std::vector<double> sine(TableSize), level(TableSize);
+    for (auto i = 0u; i < TableSize; ++i)
+        sine[i] = std::sin(2.0 * M_PI * static_cast<double>(i) / TableSize);
+    // Fourier series, the harmonic 'h' of sample 'i' reads the sine at '(h * i) % TableSize'
+    const auto addHarmonic = [&sine, &level](const std::uint32_t harmonic, const double amplitude, const std::uint32_t phase) {
+        for (auto i = 0u; i < TableSize; ++i)
+            level[i] += amplitude * sine[(harmonic * i + phase) % TableSize];
+    };
+    for (auto l = 0u; l < table->levelCount; ++l) {
+        const auto harmonicCount = waveform == Waveform::Sine ? 1u : (TableSize / 2u) >> l;
+        std::fill(level.begin(), level.end(), 0.0);
+        for (auto h = 1u; h <= harmonicCount; ++h) {
+            const auto harmonic = static_cast<double>(h);
+            switch (waveform) {
+            case Waveform::Sine:
+                addHarmonic(h, 1.0, 0u);
+                break;
+            case Waveform::Square:
+                if (h % 2u)
+                    addHarmonic(h, 4.0 / (M_PI * harmonic), 0u);
+                break;
+            case Waveform::Triangle:
+                // Cosine series, the triangle peaks at the period start
+                if (h % 2u)
+                    addHarmonic(h, 8.0 / (M_PI * M_PI * harmonic * harmonic), TableSize / 4u);
+                break;
+            case Waveform::Saw:
+                // Rising from -1 to 1
+                addHarmonic(h, -2.0 / (M_PI * harmonic), 0u);
+                break;
+            }
+        }
+        auto * const samples = table->samples.data() + l * (TableSize + 1u);
+        for (auto i = 0u; i < TableSize; ++i)
+            samples[i] = static_cast<float>(level[i]);
+        samples[TableSize] = samples[0];
+    }
+    return _Tables.emplace_back(std::move(table));
+}
+
+inline std::uint32_t Audio::DSP::Wavetable::GetPhaseIncrement(const float frequency, const SampleRate sampleRate) noexcept
+{
+    return static_cast<std::uint32_t>(static_cast<std::uint64_t>(
+        static_cast<double>(frequency) / static_cast<double>(sampleRate) * 4294967296.0 + 0.5
+    ));
+}
+
+inline std::uint32_t Audio::DSP::Wavetable::GetLevel(const float frequency, const SampleRate sampleRate) noexcept
+{
+    const auto harmonicCount = static_cast<std::uint32_t>(static_cast<float>(sampleRate) * 0.5f / frequency);
+    auto level = 0u;
+
+    while (level < LevelCount - 1u && ((TableSize / 2u) >> level) > harmonicCount)
+        ++level;
+    return level;
+}
+
+inline void Audio::DSP::Wavetable::setWaveform(const Waveform waveform)
+{
+    if (!_table || _table->waveform != waveform)
+        _table = GetTable(waveform);
+}
+
+template<bool Accumulate>
+inline std::uint32_t Audio::DSP::Wavetable::generate(float *output, const std::size_t size, const std::uint32_t phase, const float frequency, const SampleRate sampleRate,
+        const float gain) const noexcept
+{
+    constexpr auto FractionBits = 32u - TableBits;
+    constexpr auto FractionMask = (1u << FractionBits) - 1u;
+    constexpr auto FractionScale = 1.0f / static_cast<float>(1u << FractionBits);
+    const auto &table = *_table;
+    const auto level = std::min(GetLevel(frequency, sampleRate), table.levelCount - 1u);
+    const float * const samples = table.samples.data() + level * (TableSize + 1u);
+    const auto increment = GetPhaseIncrement(frequency, sampleRate);
+
+    for (std::size_t i = 0u; i < size; ++i) {
+        const auto current = phase + static_cast<std::uint32_t>(i) * increment;
+        const auto index = current >> FractionBits;
+        const auto fraction = static_cast<float>(static_cast<std::int32_t>(current & FractionMask)) * FractionScale;
+        const auto sample = (samples[index] + (samples[index + 1u] - samples[index]) * fraction) * gain;
+        if constexpr (Accumulate)
+            output[i] += sample;
+        else
+            output[i] = sample;
+    }
+    return phase + static_cast<std::uint32_t>(size) * increment;
+}
+
+inline void Audio::DSP::NoiseGenerator::setSeed(const std::uint32_t seed) noexcept
+{
+    // Lanes are decorrelated through a hash of the seed, a xorshift state must not be zero
+    for (auto lane = 0u; lane < LaneCount; ++lane) {
+        auto state = seed + lane * 0x9E3779B9u;
+        state = (state ^ (state >> 16u)) * 0x85EBCA6Bu;
+        state = (state ^ (state >> 13u)) * 0xC2B2AE35u;
+        state ^= state >> 16u;
+        _states[lane] = state ? state : 0x6D2B79F5u;
+    }
+}
+
+template<bool Accumulate>
+inline void Audio::DSP::NoiseGenerator::generate(float *output, const std::size_t size, const float gain) noexcept
+{
+    const auto scale = gain / 2147483648.0f;
+    std::size_t i = 0u;
+
+    for (; i < size; i += LaneCount) {
+        const auto count = std::min(LaneCount, size - i);
+        std::uint32_t states[LaneCount];
+        for (auto lane = 0u; lane < LaneCount; ++lane) {
+            auto state = _states[lane];
+            state ^= state << 13u;
+            state ^= state >> 17u;
+            state ^= state << 5u;
+            states[lane] = state;
+        }
+        // Samples of the lanes past the end of a partial block are dropped
+        for (auto lane = 0u; lane < count; ++lane) {
+            const auto sample = static_cast<float>(static_cast<std::int32_t>(states[lane])) * scale;
+            if constexpr (Accumulate)
+                output[i + lane] += sample;
+            else
+                output[i + lane] = sample;
+        }
+        std::copy(std::begin(states), std::end(states), _states.begin());
+    }
+}
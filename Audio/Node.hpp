@@ -99,8 +99,26 @@ public:
 
 
     /** @brief Get a reference to the node cache */
-    [[nodiscard]] Buffer &cache(void) noexcept { return _cache; }
-    [[nodiscard]] const Buffer &cache(void) const noexcept { return _cache; }
+    [[nodiscard]] Buffer &cache(void) noexcept { return _cacheBinding ? *_cacheBinding : _cache; }
+    [[nodiscard]] const Buffer &cache(void) const noexcept { return _cacheBinding ? *_cacheBinding : _cache; }
+
+    /** @brief Check if the node output is bound to a shared cache */
+    [[nodiscard]] bool isCacheShared(void) const noexcept { return _cacheBinding; }
+
+    /** @brief Bind the node output to a shared cache, releasing its own one
+     *  A null cache restores an own cache using the specs of the shared one */
+    void bindCache(Buffer * const cache);
+
+    /** @brief Get the caches in which children accumulate their output */
+    [[nodiscard]] Core::TinyVector<Buffer> &laneCaches(void) noexcept { return _laneCaches; }
+    [[nodiscard]] const Core::TinyVector<Buffer> &laneCaches(void) const noexcept { return _laneCaches; }
+
+    /** @brief Allocate 'count' lane caches using the specs of the node cache */
+    void prepareLaneCaches(const std::size_t count);
+
+    /** @brief Check if the node is a leaf that can accumulate its output directly into a lane cache of its parent */
+    [[nodiscard]] bool canAccumulateIntoParent(void) const noexcept
+        { return _parent && _children.empty() && (static_cast<std::size_t>(_flags) & static_cast<std::size_t>(IPlugin::Flags::AccumulateOutput)); }
 
     /** @brief Prepare the internal cache for a given audio output specifications
      *  Note that this function will recusrively call itself for every sub-children */
@@ -122,6 +140,8 @@ private:
     IPlugin::Flags      _flags {}; // 2
     Color               _color {}; // 4
     Core::FlatString    _name {}; // 8
+    Core::TinyVector<Buffer> _laneCaches {}; // 8
+    Buffer              *_cacheBinding { nullptr }; // 8
     // Gain _gain;
 };
 
@@ -14,21 +14,53 @@ inline void Audio::Node::setPlugin(PluginPtr &&plugin)
 
 inline void Audio::Node::prepareCache(const AudioSpecs &specs)
 {
-    {
+    // Shared caches are prepared by the scheduler
+    if (!_cacheBinding) {
         const auto newSize = GetFormatByteLength(specs.format) * specs.processBlockSize;
         _cache.resize(newSize, specs.sampleRate, specs.channelArrangement, specs.format);
     }
 
+    prepareLaneCaches(_laneCaches.size());
     for (auto &child : _children) {
         child->prepareCache(specs);
     }
     _plugin->updateAudioSpecs(specs);
 }
 
+inline void Audio::Node::prepareLaneCaches(const std::size_t count)
+{
+    if (_laneCaches.size() != count)
+        _laneCaches.resize(count);
+    // Lanes are allocated once the node cache is prepared
+    const auto &cache = this->cache();
+    if (!cache)
+        return;
+    for (auto &lane : _laneCaches) {
+        lane.resize(cache.channelByteSize(), cache.sampleRate(), cache.channelArrangement(), cache.format());
+        lane.clear();
+    }
+}
+
+inline void Audio::Node::bindCache(Buffer * const cache)
+{
+    if (cache == _cacheBinding)
+        return;
+    if (!cache && *_cacheBinding)
+        _cache.resize(_cacheBinding->channelByteSize(), _cacheBinding->sampleRate(), _cacheBinding->channelArrangement(), _cacheBinding->format());
+    _cacheBinding = cache;
+    if (_cacheBinding)
+        _cache.release();
+}
+
 inline void Audio::Node::onAudioGenerationStarted(const BeatRange &range) noexcept
 {
     // We process plugins from bottom to top
-    _cache.clear();
+    if (auto &cache = this->cache(); cache)
+        cache.clear();
+    for (auto &lane : _laneCaches) {
+        if (lane)
+            lane.clear();
+    }
     plugin()->onAudioGenerationStarted(range);
     for (auto &child : _children) {
         child->onAudioGenerationStarted(range);
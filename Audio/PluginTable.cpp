@@ -52,6 +52,8 @@ void Audio::PluginTable::decrementRefCount(IPlugin *plugin) noexcept_ndebug
 #include <Audio/Plugins/BandFilter.hpp>
 #include <Audio/Plugins/SigmaFilter.hpp>
 #include <Audio/Plugins/GammaEqualizer.hpp>
+#include <Audio/Plugins/GraphicEqualizer.hpp>
+#include <Audio/Plugins/ParametricEqualizer.hpp>
 #include <Audio/Plugins/SimpleDelay.hpp>
 #include <Audio/Plugins/Arpeggiator.hpp>
 #include <Audio/Plugins/Chords.hpp>
@@ -69,6 +71,8 @@ Audio::PluginTable::PluginTable(void)
     registerFactory<Audio::BasicFilter>();
     registerFactory<Audio::SimpleDelay>();
     registerFactory<Audio::GammaEqualizer>();
+    registerFactory<Audio::GraphicEqualizer>();
+    registerFactory<Audio::ParametricEqualizer>();
     // registerFactory<Audio::LambdaFilter>();
     // registerFactory<Audio::SigmaFilter>();
 }
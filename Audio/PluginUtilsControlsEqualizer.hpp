@@ -29,6 +29,65 @@
         ) \
     )
 
+#define CONTROL_EQUALIZER_BAND_Q_DEFAULT_RANGE() CONTROL_RANGE_STEP(0.1, 10.0, 0.01)
+
+#define REGISTER_CONTROL_EQUALIZER_BAND_FREQUENCY(Name, Value, Range, Description) \
+    REGISTER_CONTROL_FLOATING( \
+        Name, Value, Range, \
+        TR_TABLE( \
+            TR(English, "Frequency " Description), \
+            TR(French, "Fréquence " Description) \
+        ), \
+        TR_TABLE( \
+            TR(English, "Center frequency of band " Description), \
+            TR(French, "Fréquence centrale de la bande " Description) \
+        ), \
+        TR_TABLE( \
+            TR(English, "Freq") \
+        ), \
+        TR_TABLE( \
+            TR(English, "hertz") \
+        ) \
+    )
+
+#define REGISTER_CONTROL_EQUALIZER_BAND_GAIN(Name, Value, Range, Description) \
+    REGISTER_CONTROL_FLOATING( \
+        Name, Value, Range, \
+        TR_TABLE( \
+            TR(English, "Gain " Description), \
+            TR(French, "Gain " Description) \
+        ), \
+        TR_TABLE( \
+            TR(English, "Gain of band " Description), \
+            TR(French, "Gain de la bande " Description) \
+        ), \
+        TR_TABLE( \
+            TR(English, "Gain") \
+        ), \
+        TR_TABLE( \
+            TR(English, "decibels") \
+        ) \
+    )
+
+#define REGISTER_CONTROL_EQUALIZER_BAND_Q(Name, Value, Range, Description) \
+    REGISTER_CONTROL_FLOATING( \
+        Name, Value, Range, \
+        TR_TABLE( \
+            TR(English, "Q " Description), \
+            TR(French, "Q " Description) \
+        ), \
+        TR_TABLE( \
+            TR(English, "Quality factor of band " Description ", higher is narrower"), \
+            TR(French, "Facteur de qualité de la bande " Description ", plus haut est plus étroit") \
+        ), \
+        TR_TABLE( \
+            TR(English, "Q") \
+        ), \
+        TR_TABLE( \
+            TR(English, "") \
+        ) \
+    )
+
 #define FOR_EACH_EQUALIZER_BAND(N, what, Name, Range)    _FOR_EACH_EQUALIZER_BAND_##N(what, Name, Range)
 #define _FOR_EACH_EQUALIZER_BAND_0(what)
 #define _FOR_EACH_EQUALIZER_BAND_1(what, Name, Range)    what(Name##_0, CONTROL_EQUALIZER_BAND_DEFAULT_VALUE(), Range)
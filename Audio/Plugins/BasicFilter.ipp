@@ -15,7 +15,7 @@ inline void Audio::BasicFilter::onAudioGenerationStarted(const BeatRange &range)
         DSP::Filter::FIRSpecs(
             static_cast<DSP::Filter::BasicType>(filterType()),
             DSP::Filter::WindowType::Hanning,
-            33ul,
+            FilterOrder,
             static_cast<float>(audioSpecs().sampleRate),
             static_cast<float>(cutoffFrequency()),
             0.0f,
@@ -24,13 +24,22 @@ inline void Audio::BasicFilter::onAudioGenerationStarted(const BeatRange &range)
     );
     _cache.resize(GetFormatByteLength(audioSpecs().format) * audioSpecs().processBlockSize, audioSpecs().sampleRate, audioSpecs().channelArrangement, audioSpecs().format);
     _cache.clear();
+    _silence.reset();
 }
 
 inline void Audio::BasicFilter::receiveAudio(BufferView output)
 {
     float *out = output.data<float>();
     if (static_cast<bool>(byBass())) {
-        std::memcpy(out, _cache.data<float>(), output.size<std::uint8_t>());
+        if (_cache.isSilent())
+            output.markSilent();
+        else
+            std::memcpy(out, _cache.data<float>(), output.size<std::uint8_t>());
+        return;
+    }
+    // The output is already cleared, nothing is left to filter once the filter history is silent
+    if (_silence.feed(_cache.isSilent(), audioSpecs().processBlockSize, FilterOrder + 1u)) {
+        output.markSilent();
         return;
     }
 
@@ -41,14 +50,18 @@ inline void Audio::BasicFilter::receiveAudio(BufferView output)
         DSP::Filter::FIRSpecs(
             static_cast<DSP::Filter::BasicType>(filterType()),
             DSP::Filter::WindowType::Default,
-            33ul,
+            FilterOrder,
             static_cast<float>(audioSpecs().sampleRate),
             static_cast<float>(cutoffFrequency()),
             0.0f,
             1.0f
         )
     );
-    _filter.filter(_cache.data<float>(), audioSpecs().processBlockSize, out, outGain);
+    // Channels are planar, each one is filtered with its own history
+    for (auto channel = 0u; channel < output.channelCount(); ++channel) {
+        const auto target = static_cast<Channel>(channel);
+        _filter.filter(_cache.data<float>(target), audioSpecs().processBlockSize, output.data<float>(target), outGain, target);
+    }
 }
 
 inline void Audio::BasicFilter::sendAudio(const BufferViews &inputs)
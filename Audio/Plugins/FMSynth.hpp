@@ -8,6 +8,7 @@
 #include <Core/FlatVector.hpp>
 
 #include <Audio/PluginUtilsControlsFM.hpp>
+#include <Audio/UtilsMidi.hpp>
 // #include <Audio/Volume.hpp>
 // #include <Audio/Modifier.hpp>
 
@@ -32,7 +33,7 @@ class Audio::FMX final : public Audio::IPlugin
             TR(French, "FMX allow to generate audio waveforms and play them as notes")
         ),
         /* Plugin flags */
-        FLAGS(AudioOutput, NoteInput),
+        FLAGS(AudioOutput, NoteInput, AccumulateOutput),
         /* Plugin tags */
         TAGS(Synth),
         /* Control list */
@@ -71,6 +72,8 @@ public:
 public:
 private:
     FMManager<DSP::EnvelopeType::ADSR, 6u> _fmManager {};
+    /** @brief Mono cache of the voices, spread to every channel of a multi-channel output */
+    Buffer _voiceCache {};
 };
 
 #include "FMSynth.ipp"
@@ -5,10 +5,13 @@
 
 #include <iomanip>
 
+#include <Audio/DSP/Merge.hpp>
+
 inline void Audio::FMX::onAudioGenerationStarted(const BeatRange &range)
 {
     UNUSED(range);
     _fmManager.reset();
+    _voiceCache.resize(GetFormatByteLength(audioSpecs().format) * audioSpecs().processBlockSize, audioSpecs().sampleRate, ChannelArrangement::Mono, audioSpecs().format);
 }
 
 inline void Audio::FMX::onAudioParametersChanged(void)
@@ -33,17 +36,88 @@ inline void Audio::FMX::sendNotes(const NoteEvents &notes, const BeatRange &rang
 
 inline void Audio::FMX::receiveAudio(BufferView output)
 {
+    // Nothing is accumulated without active notes
+    if (!_fmManager.getAllActiveNoteSize()) {
+        output.markSilent();
+        return;
+    }
+
     const DB outGain = ConvertDecibelToRatio(static_cast<float>(outputVolume()) + DefaultVoiceGain);
-    const auto outSize = static_cast<std::uint32_t>(output.size<float>());
-    float *out = reinterpret_cast<float *>(output.byteData());
+    // Voices are mono, they are rendered once and spread to every channel of a multi-channel output
+    const bool spread = output.channelCount() > 1u;
+    const auto outSize = static_cast<std::uint32_t>(output.channelSampleCount());
+    float *out = spread ? _voiceCache.data<float>() : output.data<float>();
+    if (spread)
+        std::memset(out, 0, outSize * sizeof(float));
     // const bool noRelease = !enveloppeRelease();
     const bool noRelease = false;
 
-
-
+    // Operators only depend on the controls, they are shared by every note of the block
+    _fmManager.prepareSchema({
+        DSP::FM::Internal::Operator {
+            static_cast<float>(opAratio()),
+            static_cast<float>(opAattack()),
+            static_cast<float>(opAdecay()),
+            static_cast<float>(opAsustain()),
+            static_cast<float>(opArelease()),
+            static_cast<float>(opAvolume() * opAvolumeRatio()),
+            static_cast<std::int32_t>(opAdetune()),
+            static_cast<std::uint32_t>(opAfeedback())
+        },
+        DSP::FM::Internal::Operator {
+            static_cast<float>(opBratio()),
+            static_cast<float>(opBattack()),
+            static_cast<float>(opBdecay()),
+            static_cast<float>(opBsustain()),
+            static_cast<float>(opBrelease()),
+            static_cast<float>(opBvolume() * opBvolumeRatio()),
+            static_cast<std::int32_t>(opBdetune()),
+            static_cast<std::uint32_t>(opBfeedback())
+        },
+        DSP::FM::Internal::Operator {
+            static_cast<float>(opCratio()),
+            static_cast<float>(opCattack()),
+            static_cast<float>(opCdecay()),
+            static_cast<float>(opCsustain()),
+            static_cast<float>(opCrelease()),
+            static_cast<float>(opCvolume() * opCvolumeRatio()),
+            static_cast<std::int32_t>(opCdetune()),
+            static_cast<std::uint32_t>(opCfeedback())
+        },
+        DSP::FM::Internal::Operator {
+            static_cast<float>(opDratio()),
+            static_cast<float>(opDattack()),
+            static_cast<float>(opDdecay()),
+            static_cast<float>(opDsustain()),
+            static_cast<float>(opDrelease()),
+            static_cast<float>(opDvolume() * opDvolumeRatio()),
+            static_cast<std::int32_t>(opDdetune()),
+            static_cast<std::uint32_t>(opDfeedback())
+        },
+        DSP::FM::Internal::Operator {
+            static_cast<float>(opEratio()),
+            static_cast<float>(opEattack()),
+            static_cast<float>(opEdecay()),
+            static_cast<float>(opEsustain()),
+            static_cast<float>(opErelease()),
+            static_cast<float>(opEvolume() * opEvolumeRatio()),
+            static_cast<std::int32_t>(opEdetune()),
+            static_cast<std::uint32_t>(opEfeedback())
+        },
+        DSP::FM::Internal::Operator {
+            static_cast<float>(opFratio()),
+            static_cast<float>(opFattack()),
+            static_cast<float>(opFdecay()),
+            static_cast<float>(opFsustain()),
+            static_cast<float>(opFrelease()),
+            static_cast<float>(opFvolume() * opFvolumeRatio()),
+            static_cast<std::int32_t>(opFdetune()),
+            static_cast<std::uint32_t>(opFfeedback())
+        }
+    });
     _fmManager.processNotes(
         [this, outGain, outSize, out, noRelease](const Key key, const bool trigger, const std::uint32_t readIndex, const NoteModifiers &modifiers) -> std::pair<std::uint32_t, std::uint32_t> {
-            const float rootFrequency = std::pow(2.f, static_cast<float>(static_cast<int>(key) - RootKey) / KeysPerOctave) * RootKeyFrequency;
+            const float rootFrequency = Midi::NoteConverter::KeyToFrequency(key);
             auto realOut = out;
             auto realOutSize = outSize;
             if (modifiers.sampleOffset) {
@@ -58,71 +132,12 @@ inline void Audio::FMX::receiveAudio(BufferView output)
             UNUSED(rootFrequency);
             UNUSED(modifiers);
 
-            _fmManager.processSchema<true>(realOut, realOutSize, outGain, readIndex, key, rootFrequency, {
-               DSP::FM::Internal::Operator {
-                   static_cast<float>(opAratio()),
-                   static_cast<float>(opAattack()),
-                   static_cast<float>(opAdecay()),
-                   static_cast<float>(opAsustain()),
-                   static_cast<float>(opArelease()),
-                   static_cast<float>(opAvolume() * opAvolumeRatio()),
-                   static_cast<std::int32_t>(opAdetune()),
-                   static_cast<std::uint32_t>(opAfeedback())
-               },
-               DSP::FM::Internal::Operator {
-                   static_cast<float>(opBratio()),
-                   static_cast<float>(opBattack()),
-                   static_cast<float>(opBdecay()),
-                   static_cast<float>(opBsustain()),
-                   static_cast<float>(opBrelease()),
-                   static_cast<float>(opBvolume() * opBvolumeRatio()),
-                   static_cast<std::int32_t>(opBdetune()),
-                   static_cast<std::uint32_t>(opBfeedback())
-               },
-               DSP::FM::Internal::Operator {
-                   static_cast<float>(opCratio()),
-                   static_cast<float>(opCattack()),
-                   static_cast<float>(opCdecay()),
-                   static_cast<float>(opCsustain()),
-                   static_cast<float>(opCrelease()),
-                   static_cast<float>(opCvolume() * opCvolumeRatio()),
-                   static_cast<std::int32_t>(opCdetune()),
-                   static_cast<std::uint32_t>(opCfeedback())
-               },
-               DSP::FM::Internal::Operator {
-                   static_cast<float>(opDratio()),
-                   static_cast<float>(opDattack()),
-                   static_cast<float>(opDdecay()),
-                   static_cast<float>(opDsustain()),
-                   static_cast<float>(opDrelease()),
-                   static_cast<float>(opDvolume() * opDvolumeRatio()),
-                   static_cast<std::int32_t>(opDdetune()),
-                   static_cast<std::uint32_t>(opDfeedback())
-               },
-               DSP::FM::Internal::Operator {
-                   static_cast<float>(opEratio()),
-                   static_cast<float>(opEattack()),
-                   static_cast<float>(opEdecay()),
-                   static_cast<float>(opEsustain()),
-                   static_cast<float>(opErelease()),
-                   static_cast<float>(opEvolume() * opEvolumeRatio()),
-                   static_cast<std::int32_t>(opEdetune()),
-                   static_cast<std::uint32_t>(opEfeedback())
-               },
-               DSP::FM::Internal::Operator {
-                   static_cast<float>(opFratio()),
-                   static_cast<float>(opFattack()),
-                   static_cast<float>(opFdecay()),
-                   static_cast<float>(opFsustain()),
-                   static_cast<float>(opFrelease()),
-                   static_cast<float>(opFvolume() * opFvolumeRatio()),
-                   static_cast<std::int32_t>(opFdetune()),
-                   static_cast<std::uint32_t>(opFfeedback())
-               }
-            });
+            _fmManager.processSchema<true>(realOut, realOutSize, outGain, readIndex, key, rootFrequency);
             return std::make_pair(realOutSize, 0u);
         }
     );
+    if (spread)
+        DSP::MergeToChannels<float>(out, output);
 
     // std::cout << std::endl;
     // std::cout << _fmManager.getActiveNoteSize() << std::endl;
@@ -60,8 +60,12 @@ public:
     virtual void onAudioGenerationStarted(const BeatRange &range);
 
 private:
+    /** @brief Order of the filter */
+    static constexpr std::uint32_t FilterOrder = 123u;
+
     DSP::FIR::BandFilter<10u, float> _filter;
     Buffer _cache;
+    DSP::Filter::SilenceTracker _silence {};
 };
 
 #include "GammaEqualizer.ipp"
@@ -15,11 +15,12 @@ inline void Audio::GammaEqualizer::onAudioGenerationStarted(const BeatRange &ran
     _filter.init(
         DSP::Filter::WindowType::Hanning,
         static_cast<float>(audioSpecs().sampleRate),
-        123u
+        FilterOrder
     );
     // std::cout << "onAudioGenerationStarted !!" << std::endl;
     _cache.resize(GetFormatByteLength(audioSpecs().format) * audioSpecs().processBlockSize, audioSpecs().sampleRate, audioSpecs().channelArrangement, audioSpecs().format);
     _cache.clear();
+    _silence.reset();
 }
 
 inline void Audio::GammaEqualizer::receiveAudio(BufferView output)
@@ -27,11 +28,19 @@ inline void Audio::GammaEqualizer::receiveAudio(BufferView output)
     // std::cout << ">> receiveAudio" << std::endl;
     float *out = output.data<float>();
     if (static_cast<bool>(byBass())) {
-        std::memcpy(out, _cache.data<float>(), output.size<std::uint8_t>());
+        if (_cache.isSilent())
+            output.markSilent();
+        else
+            std::memcpy(out, _cache.data<float>(), output.size<std::uint8_t>());
+        return;
+    }
+    // The output is already cleared, nothing is left to filter once the filter history is silent
+    if (_silence.feed(_cache.isSilent(), audioSpecs().processBlockSize, FilterOrder + 1u)) {
+        output.markSilent();
         return;
     }
 
-    _filter.filter(_cache.data<float>(), audioSpecs().processBlockSize, out, {
+    const float gains[] {
         ConvertDecibelToRatio(static_cast<float>(frequenyBands_9() + outputVolume())),
         ConvertDecibelToRatio(static_cast<float>(frequenyBands_8() + outputVolume())),
         ConvertDecibelToRatio(static_cast<float>(frequenyBands_7() + outputVolume())),
@@ -42,7 +51,12 @@ inline void Audio::GammaEqualizer::receiveAudio(BufferView output)
         ConvertDecibelToRatio(static_cast<float>(frequenyBands_2() + outputVolume())),
         ConvertDecibelToRatio(static_cast<float>(frequenyBands_1() + outputVolume())),
         ConvertDecibelToRatio(static_cast<float>(frequenyBands_0() + outputVolume()))
-    });
+    };
+    // Channels are planar, each one is filtered with its own history
+    for (auto channel = 0u; channel < output.channelCount(); ++channel) {
+        const auto target = static_cast<Channel>(channel);
+        _filter.filter(_cache.data<float>(target), audioSpecs().processBlockSize, output.data<float>(target), gains, target);
+    }
     // std::cout << "receiveAudio !!" << std::endl;
     // std::memcpy(out, _cache.data<float>(), audioSpecs().processBlockSize * GetFormatByteLength(audioSpecs().format));
 }
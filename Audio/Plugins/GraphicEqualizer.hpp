@@ -0,0 +1,82 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: Graphic equalizer plugin using a cascade of biquad peak sections
+ */
+
+#pragma once
+
+#include <Audio/PluginUtilsControlsVolume.hpp>
+#include <Audio/PluginUtilsControlsFilter.hpp>
+#include <Audio/PluginUtilsControlsEqualizer.hpp>
+#include <Audio/DSP/Biquad.hpp>
+
+namespace Audio
+{
+    class GraphicEqualizer;
+}
+
+/** @brief Ten octave bands, unlike GammaEqualizer the phase is not linear but a sample costs 50 multiplications instead of 1230 */
+class Audio::GraphicEqualizer final : public Audio::IPlugin
+{
+public:
+    static constexpr std::uint32_t BandCount = 10;
+
+    REGISTER_PLUGIN(
+        TR_TABLE(
+            TR(English, "Graphic equalizer"),
+            TR(French, "Equaliseur graphique")
+        ),
+        TR_TABLE(
+            TR(English, "Graphic equalizer allow to boost or cut ten octave bands of an audio signal"),
+            TR(French, "L'équaliseur graphique permet d'amplifier ou d'atténuer dix octaves de l'audio")
+        ),
+        FLAGS(AudioInput, AudioOutput),
+        TAGS(EQ),
+        REGISTER_CONTROL_INPUT_GAIN(
+            inputGain, 0.0,
+            CONTROL_DEFAULT_INPUT_GAIN_RANGE()
+        ),
+        REGISTER_CONTROL_OUTPUT_VOLUME(
+            outputVolume, 0.0,
+            CONTROL_DEFAULT_OUTPUT_VOLUME_RANGE()
+        ),
+        REGISTER_CONTROL_EFFECT_BYPASS(
+            byBass
+        ),
+        REGISTER_CONTROL_EQUALIZER_BANDS(
+            frequencyBands,
+            10, // ::BandCount
+            CONTROL_EQUALIZER_BAND_DEFAULT_RANGE()
+        )
+    )
+
+public:
+    /** @brief Plugin constructor */
+    GraphicEqualizer(const IPluginFactory *factory) noexcept : IPlugin(factory) {}
+
+    virtual void sendAudio(const BufferViews &inputs);
+    virtual void receiveAudio(BufferView output);
+
+    virtual void onAudioGenerationStarted(const BeatRange &range);
+
+    /** @brief Get the center frequency of a band */
+    [[nodiscard]] static float GetBandFrequency(const std::uint32_t band) noexcept
+        { return RootFrequency * static_cast<float>(1u << band); }
+
+private:
+    /** @brief Center frequency of the lowest band */
+    static constexpr float RootFrequency = 31.25f;
+    /** @brief Bandwidth of a band in octaves */
+    static constexpr float BandWidth = 1.0f;
+
+    DSP::Biquad::Cascade _filter {};
+    Buffer _cache;
+    /** @brief Gains of the current coefficients */
+    std::array<float, BandCount> _gains {};
+    DSP::Filter::SilenceTracker _silence {};
+
+    /** @brief Generate the coefficients of the bands whose gain changed */
+    void updateCoefficients(const bool force) noexcept;
+};
+
+#include "GraphicEqualizer.ipp"
@@ -0,0 +1,87 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: Graphic equalizer implementation
+ */
+
+#include <Audio/DSP/Merge.hpp>
+
+inline void Audio::GraphicEqualizer::onAudioGenerationStarted(const BeatRange &range)
+{
+    UNUSED(range);
+    _filter.setSectionCount(BandCount);
+    updateCoefficients(true);
+    _cache.resize(GetFormatByteLength(audioSpecs().format) * audioSpecs().processBlockSize, audioSpecs().sampleRate, audioSpecs().channelArrangement, audioSpecs().format);
+    _cache.clear();
+    _silence.reset();
+}
+
+inline void Audio::GraphicEqualizer::updateCoefficients(const bool force) noexcept
+{
+    // Controls are registered from the highest band to the lowest one
+    const float gains[] {
+        static_cast<float>(frequencyBands_9()),
+        static_cast<float>(frequencyBands_8()),
+        static_cast<float>(frequencyBands_7()),
+        static_cast<float>(frequencyBands_6()),
+        static_cast<float>(frequencyBands_5()),
+        static_cast<float>(frequencyBands_4()),
+        static_cast<float>(frequencyBands_3()),
+        static_cast<float>(frequencyBands_2()),
+        static_cast<float>(frequencyBands_1()),
+        static_cast<float>(frequencyBands_0())
+    };
+    const auto sampleRate = static_cast<float>(audioSpecs().sampleRate);
+
+    for (auto band = 0u; band < BandCount; ++band) {
+        if (!force && gains[band] == _gains[band])
+            continue;
+        _gains[band] = gains[band];
+        _filter.setupCoefficients(band, DSP::Biquad::GenerateCoefficients(
+            DSP::Biquad::Internal::Specs {
+                DSP::Filter::AdvancedType::Peak,
+                sampleRate,
+                { std::min(GetBandFrequency(band), sampleRate * 0.45f), 0.0f },
+                gains[band],
+                BandWidth,
+                true
+            }
+        ));
+    }
+}
+
+inline void Audio::GraphicEqualizer::receiveAudio(BufferView output)
+{
+    float *out = output.data<float>();
+    if (static_cast<bool>(byBass())) {
+        if (_cache.isSilent())
+            output.markSilent();
+        else
+            std::memcpy(out, _cache.data<float>(), output.size<std::uint8_t>());
+        return;
+    }
+    // The output is already cleared, the tail of the bands is considered flushed after one second of silence
+    if (_silence.feed(_cache.isSilent(), audioSpecs().processBlockSize, audioSpecs().sampleRate)) {
+        _filter.resetRegisters();
+        output.markSilent();
+        return;
+    }
+
+    const DB outGain = ConvertDecibelToRatio(static_cast<float>(outputVolume()));
+
+    updateCoefficients(false);
+    // Channels are planar, each one is filtered with its own registers
+    for (auto channel = 0u; channel < output.channelCount(); ++channel) {
+        const auto target = static_cast<Channel>(channel);
+        _filter.filterBlock(_cache.data<float>(target), audioSpecs().processBlockSize, output.data<float>(target), outGain, target);
+    }
+}
+
+inline void Audio::GraphicEqualizer::sendAudio(const BufferViews &inputs)
+{
+    if (!inputs.size())
+        return;
+    const DB inGain = ConvertDecibelToRatio(static_cast<float>(
+        static_cast<bool>(byBass()) ? inputGain() + outputVolume() : inputGain()
+    ));
+    DSP::Merge<float>(inputs, _cache, inGain, true);
+}
@@ -118,8 +118,12 @@ public:
     virtual void onAudioGenerationStarted(const BeatRange &range);
 
 private:
+    /** @brief Order of the filter */
+    static constexpr std::uint32_t FilterOrder = 33u;
+
     DSP::FIR::BasicFilter<float> _filter;
     Buffer _cache;
+    DSP::Filter::SilenceTracker _silence {};
 };
 
 #include "LambdaFilter.ipp"
@@ -137,21 +137,35 @@ public:
             const SampleRate sampleRate) noexcept
     { return _enveloppe.getGain(key, index, delay, attack, hold, decay, sustain, release, sampleRate); }
 
+    /** @brief Render 'size' enveloppe gains of given key starting at 'index' */
+    inline void getEnvelopeGains(
+            const Key key, const std::uint32_t index, float *gains, const std::uint32_t size,
+            const float delay, const float attack,
+            const float hold, const float decay,
+            const float sustain, const float release,
+            const SampleRate sampleRate) noexcept
+    { _enveloppe.getGains(key, index, gains, size, delay, attack, hold, decay, sustain, release, sampleRate); }
+
     [[nodiscard]] const DSP::EnvelopeBase<Envelope> &enveloppe(void) const noexcept { return _enveloppe; }
     [[nodiscard]] DSP::EnvelopeBase<Envelope> &enveloppe(void) noexcept { return _enveloppe; }
 
     [[nodiscard]] const DSP::FM::Schema<OperatorCount> &schema(void) const noexcept { return _schema; }
     [[nodiscard]] DSP::FM::Schema<OperatorCount> &schema(void) noexcept { return _schema; }
 
+    /** @brief Prepare the operators of the block, once before processing every note */
+    void prepareSchema(const DSP::FM::Internal::OperatorArray<OperatorCount> &operators) noexcept
+    {
+        updateLongestEnvOperatorIndex(operators);
+        _schema.prepareOperators(operators);
+    }
+
     template<bool Accumulate>
     void processSchema(
             float *output, const std::uint32_t processSize, const float outGain,
-            const std::uint32_t phaseIndex, const Key key, const float rootFrequency,
-            const DSP::FM::Internal::OperatorArray<OperatorCount> &operators
+            const std::uint32_t phaseIndex, const Key key, const float rootFrequency
     ) noexcept
     {
-        updateLongestEnvOperatorIndex(operators);
-        _schema.template process<Accumulate>(output, processSize, outGain, phaseIndex, key, rootFrequency, operators);
+        _schema.template process<Accumulate>(output, processSize, outGain, phaseIndex, key, rootFrequency);
     }
 
 private:
@@ -118,6 +118,9 @@ public:
     /** @brief Set the read index of given key */
     void setReadIndex(const Key key, const std::uint32_t index) noexcept { _cache.readIndexes[key] = key; }
 
+    /** @brief Get the note and poly pressure modifiers of given key */
+    [[nodiscard]] const NoteCache &noteCache(const Key key) const noexcept { return _cache.modifiers[key]; }
+
     /** @brief Reset the read index of given key */
     void resetReadIndex(const Key key) noexcept { _cache.readIndexes[key] = 0u; }
 
@@ -132,6 +135,17 @@ public:
         return _enveloppe.template getGain<0u>(key, index, delay, attack, hold, decay, sustain, release, sampleRate);
     }
 
+    /** @brief Render 'size' enveloppe gains of given key starting at 'index' */
+    inline void getEnvelopeGains(
+            const Key key, const std::uint32_t index, float *gains, const std::uint32_t size,
+            const float delay, const float attack,
+            const float hold, const float decay,
+            const float sustain, const float release,
+            const SampleRate sampleRate) noexcept
+    {
+        _enveloppe.template getGains<0u>(key, index, gains, size, delay, attack, hold, decay, sustain, release, sampleRate);
+    }
+
     [[nodiscard]] const DSP::EnvelopeBase<Envelope> &enveloppe(void) const noexcept { return _enveloppe; }
     [[nodiscard]] DSP::EnvelopeBase<Envelope> &enveloppe(void) noexcept { return _enveloppe; }
 
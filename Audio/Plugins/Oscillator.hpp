@@ -11,6 +11,9 @@
 #include <Audio/PluginUtilsControlsEnvelope.hpp>
 #include <Audio/Volume.hpp>
 #include <Audio/Modifier.hpp>
+#include <Audio/UtilsMidi.hpp>
+#include <Audio/DSP/Wavetable.hpp>
+#include <Audio/DSP/Dispatch.hpp>
 
 #include "Managers/NoteManager.hpp"
 
@@ -33,7 +36,7 @@ class Audio::Oscillator final : public Audio::IPlugin
             TR(French, "Le Oscillateur permet de générer des formes d'ondes audio et de les jouer comme des notes")
         ),
         /* Plugin flags */
-        FLAGS(AudioOutput, NoteInput),
+        FLAGS(AudioOutput, NoteInput, AccumulateOutput),
         /* Plugin tags */
         TAGS(Synth),
         /* Control list */
@@ -107,7 +110,6 @@ class Audio::Oscillator final : public Audio::IPlugin
     {
         enum class Waveform : std::uint8_t {
             Sine, Cosine, Square,
-            // Not working !
             Triangle, Saw,
             Noise,
             // Not use this, but fun xD
@@ -141,6 +143,21 @@ private:
     NoteManager<DSP::EnvelopeType::ADSR> _noteManager {};
     Osc _oscillator;
     Volume<float> _volumeHandler;
+    /** @brief Mono cache of the voices, spread to every channel of a multi-channel output */
+    Buffer _voiceCache {};
+    /** @brief Cache of a voice before its envelope is applied */
+    Core::TinyVector<float> _waveCache {};
+    /** @brief Envelope gains of the voice being generated */
+    Core::TinyVector<float> _gainCache {};
+    /** @brief Band-limited tables of the sine, square, triangle and saw waveforms, loaded at construction */
+    std::array<DSP::Wavetable, 4u> _wavetables {
+        DSP::Wavetable(DSP::Wavetable::Waveform::Sine),
+        DSP::Wavetable(DSP::Wavetable::Waveform::Square),
+        DSP::Wavetable(DSP::Wavetable::Waveform::Triangle),
+        DSP::Wavetable(DSP::Wavetable::Waveform::Saw)
+    };
+    /** @brief Noise of the instance, seeded from its address so two oscillators never play the same noise */
+    DSP::NoiseGenerator _noise { static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(this)) };
 
     float getEnvelopeGain(const Key key, const std::uint32_t index) noexcept
     {
@@ -154,37 +171,26 @@ private:
         audioSpecs().sampleRate);
     }
 
+    void getEnvelopeGains(const Key key, const std::uint32_t index, float *gains, const std::uint32_t size) noexcept
+    {
+        _noteManager.getEnvelopeGains(key, index, gains, size,
+                0.0f,
+                static_cast<float>(enveloppeAttack()),
+                0.0f,
+                static_cast<float>(enveloppeDecay()),
+                static_cast<float>(enveloppeSustain()),
+                static_cast<float>(enveloppeRelease()),
+        audioSpecs().sampleRate);
+    }
+
+    /** @brief Generate a voice then apply its envelope, the waveform is read from a band-limited table at the phase of the note index */
     template<bool Accumulate = true, typename Type>
     void generateWaveform(const Osc::Waveform waveform, Type *output, const std::size_t outputSize,
             const float frequency, const SampleRate sampleRate, const std::uint32_t phaseOffset, const Key key, const DB gain) noexcept;
 
-    template<bool Accumulate, typename Type>
-    void generateSine(Type *output, const std::size_t outputSize,
-            const float frequency, const SampleRate sampleRate, const std::uint32_t phaseOffset, const Key key, const DB gain) noexcept;
-
-    template<bool Accumulate, typename Type>
-    void generateCosine(Type *output, const std::size_t outputSize,
-            const float frequency, const SampleRate sampleRate, const std::uint32_t phaseOffset, const Key key, const DB gain) noexcept;
-
-    template<bool Accumulate, typename Type>
-    void generateSquare(Type *output, const std::size_t outputSize,
-            const float frequency, const SampleRate sampleRate, const std::uint32_t phaseOffset, const Key key, const DB gain) noexcept;
-
-    template<bool Accumulate, typename Type>
-    void generateTriangle(Type *output, const std::size_t outputSize,
-            const float frequency, const SampleRate sampleRate, const std::uint32_t phaseOffset, const Key key, const DB gain) noexcept;
-
-    template<bool Accumulate, typename Type>
-    void generateSaw(Type *output, const std::size_t outputSize,
-            const float frequency, const SampleRate sampleRate, const std::uint32_t phaseOffset, const Key key, const DB gain) noexcept;
-
     template<bool Accumulate, typename Type>
     void generateError(Type *output, const std::size_t outputSize,
             const float frequency, const SampleRate sampleRate, const std::uint32_t phaseOffset, const Key key, const DB gain) noexcept;
-
-    template<bool Accumulate, typename Type>
-    void generateNoise(Type *output, const std::size_t outputSize,
-            const float frequency, const SampleRate sampleRate, const std::uint32_t phaseOffset, const Key key, const DB gain) noexcept;
 };
 
 #include "Oscillator.ipp"
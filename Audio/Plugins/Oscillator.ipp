@@ -5,10 +5,15 @@
 
 #include <iomanip>
 
+#include <Audio/DSP/Merge.hpp>
+
 inline void Audio::Oscillator::onAudioGenerationStarted(const BeatRange &range)
 {
     UNUSED(range);
     _noteManager.reset();
+    _waveCache.resize(audioSpecs().processBlockSize);
+    _gainCache.resize(audioSpecs().processBlockSize);
+    _voiceCache.resize(GetFormatByteLength(audioSpecs().format) * audioSpecs().processBlockSize, audioSpecs().sampleRate, ChannelArrangement::Mono, audioSpecs().format);
 }
 
 inline void Audio::Oscillator::onAudioParametersChanged(void)
@@ -31,26 +36,37 @@ inline void Audio::Oscillator::sendNotes(const NoteEvents &notes, const BeatRang
 
 inline void Audio::Oscillator::receiveAudio(BufferView output)
 {
+    // Nothing is accumulated without active notes
+    if (!_noteManager.getAllActiveNoteSize()) {
+        output.markSilent();
+        return;
+    }
+
     const DB outGain = ConvertDecibelToRatio(static_cast<float>(outputVolume()) + DefaultVoiceGain);
-    const auto outSize = static_cast<std::uint32_t>(output.size<float>());
-    float *out = reinterpret_cast<float *>(output.byteData());
+    // Voices are mono, they are rendered once and spread to every channel of a multi-channel output
+    const bool spread = output.channelCount() > 1u;
+    const auto outSize = static_cast<std::uint32_t>(output.channelSampleCount());
+    float *out = spread ? _voiceCache.data<float>() : output.data<float>();
+    if (spread)
+        std::memset(out, 0, outSize * sizeof(float));
     // const bool noRelease = (enveloppeRelease() <= EnvelopeMinTimeStep);
     // const bool noRelease = !enveloppeRelease();
 
     _noteManager.processNotes(
         [this, outGain, outSize, out](const Key key, const std::uint32_t readIndex, const NoteModifiers &modifiers) -> std::pair<std::uint32_t, std::uint32_t> {
-            const float frequency = std::pow(2.f, static_cast<float>(static_cast<int>(key) - RootKey) / KeysPerOctave) * RootKeyFrequency;
+            const float frequency = Midi::NoteConverter::KeyToFrequency(key);
             auto realOut = out;
             auto realOutSize = outSize;
             if (modifiers.sampleOffset && !readIndex) {
                 realOut += modifiers.sampleOffset;
                 realOutSize -= modifiers.sampleOffset;
             }
-            UNUSED(modifiers);
             generateWaveform<true>(static_cast<Osc::Waveform>(waveform()), realOut, realOutSize, frequency, audioSpecs().sampleRate, readIndex, key, outGain);
             return std::make_pair(realOutSize, 0u);
         }
     );
+    if (spread)
+        DSP::MergeToChannels<float>(out, output);
 
     // std::cout << std::endl;
     // std::cout << _noteManager.getActiveNoteSize() << std::endl;
@@ -86,130 +102,48 @@ inline void Audio::Oscillator::generateWaveform(
         const float frequency, const SampleRate sampleRate, const std::uint32_t phaseOffset,
         const Key key, const DB gain) noexcept
 {
+    // The phase wraps with the 32 bits product, the phase of any note index is exact
+    const auto phase = phaseOffset * DSP::Wavetable::GetPhaseIncrement(frequency, sampleRate);
+    auto * const wave = _waveCache.data();
+
     switch (waveform) {
     case Osc::Waveform::Sine:
-        return generateSine<Accumulate>(output, outputSize, frequency, sampleRate, phaseOffset, key, gain);
+        _wavetables[0].generate<false>(wave, outputSize, phase, frequency, sampleRate);
+        break;
     case Osc::Waveform::Cosine:
-        return generateCosine<Accumulate>(output, outputSize, frequency, sampleRate, phaseOffset, key, gain);
+        _wavetables[0].generate<false>(wave, outputSize, phase + DSP::Wavetable::QuarterPhase, frequency, sampleRate);
+        break;
     case Osc::Waveform::Square:
-        return generateSquare<Accumulate>(output, outputSize, frequency, sampleRate, phaseOffset, key, gain);
+        _wavetables[1].generate<false>(wave, outputSize, phase, frequency, sampleRate);
+        break;
     case Osc::Waveform::Triangle:
-        return generateTriangle<Accumulate>(output, outputSize, frequency, sampleRate, phaseOffset, key, gain);
+        _wavetables[2].generate<false>(wave, outputSize, phase, frequency, sampleRate);
+        break;
     case Osc::Waveform::Saw:
-        return generateSaw<Accumulate>(output, outputSize, frequency, sampleRate, phaseOffset, key, gain);
+        _wavetables[3].generate<false>(wave, outputSize, phase, frequency, sampleRate);
+        break;
     case Osc::Waveform::Noise:
-        return generateNoise<Accumulate>(output, outputSize, frequency, sampleRate, phaseOffset, key, gain);
+        _noise.generate<false>(wave, outputSize);
+        break;
     case Osc::Waveform::Error:
         return generateError<Accumulate>(output, outputSize, frequency, sampleRate, phaseOffset, key, gain);
     default:
-        return generateSine<Accumulate>(output, outputSize, frequency, sampleRate, phaseOffset, key, gain);
-    }
-}
-
-template<bool Accumulate, typename Type>
-inline void Audio::Oscillator::generateSine(
-        Type *output, const std::size_t outputSize,
-        const float frequency, const SampleRate sampleRate, const std::uint32_t phaseOffset,
-        const Key key, const DB gain) noexcept
-{
-    const float frequencyNorm = 2.f * static_cast<float>(M_PI) * frequency / static_cast<float>(sampleRate);
-
-    float outGain = 1.f;
-    auto k = 0ul;
-    for (auto i = phaseOffset; k < outputSize; ++i, ++k) {
-        outGain = getEnvelopeGain(key, i) * gain;
-        if constexpr (Accumulate)
-            output[k] += static_cast<Type>(std::sin(static_cast<float>(i) * frequencyNorm) * outGain);
-        else
-            output[k] = static_cast<Type>(std::sin(static_cast<float>(i) * frequencyNorm) * outGain);
-    }
-
-
-    // Functor equivalent
-    // Modifier<Type>::ApplyIndexFunctor(output, outputSize, phaseOffset, [&, key, frequencyNorm, gain](const std::size_t index) -> Type {
-    //     return static_cast<Type>(
-    //         std::sin(static_cast<float>(index) * frequencyNorm) *
-    //         getEnvelopeGain(key, static_cast<std::uint32_t>(index)) * gain
-    //     );
-    // });
-
-    // (void)_noteManager.enveloppe().adsr<true>(key, phaseOffset, enveloppeAttack(), enveloppeDecay(), enveloppeSustain(), enveloppeRelease(), audioSpecs().sampleRate);
-}
-
-template<bool Accumulate, typename Type>
-inline void Audio::Oscillator::generateCosine(
-        Type *output, const std::size_t outputSize,
-        const float frequency, const SampleRate sampleRate, const std::uint32_t phaseOffset,
-        const Key key, const DB gain) noexcept
-{
-    const float frequencyNorm = 2.f * static_cast<float>(M_PI) * frequency / static_cast<float>(sampleRate);
-
-    float outGain = 1.f;
-    auto k = 0ul;
-    for (auto i = phaseOffset; k < outputSize; ++i, ++k) {
-        outGain = getEnvelopeGain(key, i) * gain;
-        if constexpr (Accumulate)
-            output[k] += static_cast<Type>(std::cos(static_cast<float>(i) * frequencyNorm) * outGain);
-        else
-            output[k] = static_cast<Type>(std::cos(static_cast<float>(i) * frequencyNorm) * outGain);
-    }
-
-}
-
-template<bool Accumulate, typename Type>
-inline void Audio::Oscillator::generateSquare(
-        Type *output, const std::size_t outputSize,
-        const float frequency, const SampleRate sampleRate, const std::uint32_t phaseOffset,
-        const Key key, const DB gain) noexcept
-{
-    const float frequencyNorm = 2.f * static_cast<float>(M_PI) * frequency / static_cast<float>(sampleRate);
-
-    float outGain = 1.f;
-    auto k = 0ul;
-    for (auto i = phaseOffset; k < outputSize; ++i, ++k) {
-        outGain = getEnvelopeGain(key, i) * gain;
-        if constexpr (Accumulate)
-            output[k] += std::sin(static_cast<float>(i) * frequencyNorm) > 0.f ? outGain : -outGain;
-        else
-            output[k] = std::sin(static_cast<float>(i) * frequencyNorm) > 0.f ? outGain : -outGain;
-    }
-}
-
-template<bool Accumulate, typename Type>
-inline void Audio::Oscillator::generateTriangle(
-        Type *output, const std::size_t outputSize,
-        const float frequency, const SampleRate sampleRate, const std::uint32_t phaseOffset,
-        const Key key, const DB gain) noexcept
-{
-    const float frequencyNorm = static_cast<float>(M_PI) * frequency / static_cast<float>(sampleRate);
-
-    float outGain = 1.f;
-    auto k = 0ul;
-    for (auto i = phaseOffset; k < outputSize; ++i, ++k) {
-        outGain = getEnvelopeGain(key, i) * gain;
-        if constexpr (Accumulate)
-            output[k] += (1.0f - std::acos(std::cos(2.0f * static_cast<float>(i) * frequencyNorm)) * static_cast<float>(M_2_PI)) * outGain;
-        else
-            output[k] = (1.0f - std::acos(std::cos(2.0f * static_cast<float>(i) * frequencyNorm)) * static_cast<float>(M_2_PI)) * outGain;
+        _wavetables[0].generate<false>(wave, outputSize, phase, frequency, sampleRate);
+        break;
     }
-}
-
-template<bool Accumulate, typename Type>
-inline void Audio::Oscillator::generateSaw(
-        Type *output, const std::size_t outputSize,
-        const float frequency, const SampleRate sampleRate, const std::uint32_t phaseOffset,
-        const Key key, const DB gain) noexcept
-{
-    const float frequencyNorm = static_cast<float>(M_PI) * frequency / static_cast<float>(sampleRate);
-
-    float outGain = 1.f;
-    auto k = 0ul;
-    for (auto i = phaseOffset; k < outputSize; ++i, ++k) {
-        outGain = getEnvelopeGain(key, i) * gain;
-        if constexpr (Accumulate)
-            output[k] += -std::atan(Utils::cot(static_cast<float>(i) * frequencyNorm)) * static_cast<float>(M_2_PI) * outGain;
-        else
-            output[k] = -std::atan(Utils::cot(static_cast<float>(i) * frequencyNorm)) * static_cast<float>(M_2_PI) * outGain;
+    // The envelope is rendered as a block then multiplied in with the voice
+    auto * const gains = _gainCache.data();
+    getEnvelopeGains(key, phaseOffset, gains, static_cast<std::uint32_t>(outputSize));
+    if constexpr (std::is_same_v<Type, float>) {
+        DSP::Simd::Kernels().multiplyGains(wave, gains, output, outputSize, static_cast<float>(gain), Accumulate);
+    } else {
+        for (auto k = 0ul; k < outputSize; ++k) {
+            const auto sample = static_cast<Type>(wave[k] * gains[k] * gain);
+            if constexpr (Accumulate)
+                output[k] += sample;
+            else
+                output[k] = sample;
+        }
     }
 }
 
@@ -232,31 +166,3 @@ inline void Audio::Oscillator::generateError(
             output[k] = -std::atan(Utils::cot(static_cast<float>(i) * frequencyNorm)) * static_cast<float>(M_2_PI) * outGain;
     }
 }
-
-template<bool Accumulate, typename Type>
-inline void Audio::Oscillator::generateNoise(
-        Type *output, const std::size_t outputSize,
-        const float frequency, const SampleRate sampleRate, const std::uint32_t phaseOffset,
-        const Key key, const DB gain) noexcept
-{
-    UNUSED(frequency);
-    UNUSED(sampleRate);
-
-    float outGain = 1.f;
-    auto k = 0ul;
-    for (auto i = phaseOffset; k < outputSize; ++i, ++k) {
-        outGain = getEnvelopeGain(key, i) * gain;
-        if constexpr (Accumulate)
-            output[k] += static_cast<Type>(static_cast<int>(Utils::fastRand()) - std::numeric_limits<int>::max()) / static_cast<Type>(std::numeric_limits<int>::max()) * outGain;
-        else
-            output[k] = static_cast<Type>(static_cast<int>(Utils::fastRand()) - std::numeric_limits<int>::max()) / static_cast<Type>(std::numeric_limits<int>::max()) * outGain;
-    }
-    // auto rnd = Utils::fastRand();
-    // auto rnd1 = static_cast<int>(Utils::fastRand());
-    // auto rnd2 = static_cast<Type>(static_cast<int>(Utils::fastRand()) - std::numeric_limits<int>::max());
-    // auto rnd3 = static_cast<Type>(static_cast<int>(Utils::fastRand()) - std::numeric_limits<int>::max()) / static_cast<Type>(std::numeric_limits<int>::max());
-    // UNUSED(rnd);
-    // UNUSED(rnd1);
-    // UNUSED(rnd2);
-    // UNUSED(rnd3);
-}
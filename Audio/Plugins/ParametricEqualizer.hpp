@@ -0,0 +1,83 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: Parametric equalizer plugin using a cascade of biquad shelf and peak sections
+ */
+
+#pragma once
+
+#include <Audio/PluginUtilsControlsVolume.hpp>
+#include <Audio/PluginUtilsControlsFilter.hpp>
+#include <Audio/PluginUtilsControlsEqualizer.hpp>
+#include <Audio/DSP/Biquad.hpp>
+
+namespace Audio
+{
+    class ParametricEqualizer;
+}
+
+/** @brief A low shelf, two peaks and a high shelf, each band has its own frequency, gain and quality factor */
+class Audio::ParametricEqualizer final : public Audio::IPlugin
+{
+public:
+    static constexpr std::uint32_t BandCount = 4;
+
+    REGISTER_PLUGIN(
+        TR_TABLE(
+            TR(English, "Parametric equalizer"),
+            TR(French, "Equaliseur paramétrique")
+        ),
+        TR_TABLE(
+            TR(English, "Parametric equalizer allow to shape an audio signal with two shelves and two peaks"),
+            TR(French, "L'équaliseur paramétrique permet de façonner l'audio avec deux plateaux et deux pics")
+        ),
+        FLAGS(AudioInput, AudioOutput),
+        TAGS(EQ),
+        REGISTER_CONTROL_INPUT_GAIN(
+            inputGain, 0.0,
+            CONTROL_DEFAULT_INPUT_GAIN_RANGE()
+        ),
+        REGISTER_CONTROL_OUTPUT_VOLUME(
+            outputVolume, 0.0,
+            CONTROL_DEFAULT_OUTPUT_VOLUME_RANGE()
+        ),
+        REGISTER_CONTROL_EFFECT_BYPASS(
+            byBass
+        ),
+        REGISTER_CONTROL_EQUALIZER_BAND_FREQUENCY(lowShelfFrequency, 100.0, CONTROL_FILTER_CUTOFF_DEFAULT_RANGE(), "low shelf"),
+        REGISTER_CONTROL_EQUALIZER_BAND_GAIN(lowShelfGain, 0.0, CONTROL_EQUALIZER_BAND_DEFAULT_RANGE(), "low shelf"),
+        REGISTER_CONTROL_EQUALIZER_BAND_Q(lowShelfQ, 0.707, CONTROL_EQUALIZER_BAND_Q_DEFAULT_RANGE(), "low shelf"),
+        REGISTER_CONTROL_EQUALIZER_BAND_FREQUENCY(lowPeakFrequency, 500.0, CONTROL_FILTER_CUTOFF_DEFAULT_RANGE(), "low peak"),
+        REGISTER_CONTROL_EQUALIZER_BAND_GAIN(lowPeakGain, 0.0, CONTROL_EQUALIZER_BAND_DEFAULT_RANGE(), "low peak"),
+        REGISTER_CONTROL_EQUALIZER_BAND_Q(lowPeakQ, 1.0, CONTROL_EQUALIZER_BAND_Q_DEFAULT_RANGE(), "low peak"),
+        REGISTER_CONTROL_EQUALIZER_BAND_FREQUENCY(highPeakFrequency, 3'000.0, CONTROL_FILTER_CUTOFF_DEFAULT_RANGE(), "high peak"),
+        REGISTER_CONTROL_EQUALIZER_BAND_GAIN(highPeakGain, 0.0, CONTROL_EQUALIZER_BAND_DEFAULT_RANGE(), "high peak"),
+        REGISTER_CONTROL_EQUALIZER_BAND_Q(highPeakQ, 1.0, CONTROL_EQUALIZER_BAND_Q_DEFAULT_RANGE(), "high peak"),
+        REGISTER_CONTROL_EQUALIZER_BAND_FREQUENCY(highShelfFrequency, 8'000.0, CONTROL_FILTER_CUTOFF_DEFAULT_RANGE(), "high shelf"),
+        REGISTER_CONTROL_EQUALIZER_BAND_GAIN(highShelfGain, 0.0, CONTROL_EQUALIZER_BAND_DEFAULT_RANGE(), "high shelf"),
+        REGISTER_CONTROL_EQUALIZER_BAND_Q(highShelfQ, 0.707, CONTROL_EQUALIZER_BAND_Q_DEFAULT_RANGE(), "high shelf")
+    )
+
+public:
+    /** @brief Plugin constructor */
+    ParametricEqualizer(const IPluginFactory *factory) noexcept : IPlugin(factory) {}
+
+    virtual void sendAudio(const BufferViews &inputs);
+    virtual void receiveAudio(BufferView output);
+
+    virtual void onAudioGenerationStarted(const BeatRange &range);
+
+private:
+    /** @brief Frequency, gain and quality factor of a band */
+    using BandParameters = std::array<float, 3u>;
+
+    DSP::Biquad::Cascade _filter {};
+    Buffer _cache;
+    /** @brief Parameters of the current coefficients */
+    std::array<BandParameters, BandCount> _bands {};
+    DSP::Filter::SilenceTracker _silence {};
+
+    /** @brief Generate the coefficients of the bands whose parameters changed */
+    void updateCoefficients(const bool force) noexcept;
+};
+
+#include "ParametricEqualizer.ipp"
@@ -0,0 +1,86 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: Parametric equalizer implementation
+ */
+
+#include <Audio/DSP/Merge.hpp>
+
+inline void Audio::ParametricEqualizer::onAudioGenerationStarted(const BeatRange &range)
+{
+    UNUSED(range);
+    _filter.setSectionCount(BandCount);
+    updateCoefficients(true);
+    _cache.resize(GetFormatByteLength(audioSpecs().format) * audioSpecs().processBlockSize, audioSpecs().sampleRate, audioSpecs().channelArrangement, audioSpecs().format);
+    _cache.clear();
+    _silence.reset();
+}
+
+inline void Audio::ParametricEqualizer::updateCoefficients(const bool force) noexcept
+{
+    constexpr DSP::Filter::AdvancedType Types[BandCount] {
+        DSP::Filter::AdvancedType::LowShelf,
+        DSP::Filter::AdvancedType::Peak,
+        DSP::Filter::AdvancedType::Peak,
+        DSP::Filter::AdvancedType::HighShelf
+    };
+    const BandParameters bands[BandCount] {
+        { static_cast<float>(lowShelfFrequency()), static_cast<float>(lowShelfGain()), static_cast<float>(lowShelfQ()) },
+        { static_cast<float>(lowPeakFrequency()), static_cast<float>(lowPeakGain()), static_cast<float>(lowPeakQ()) },
+        { static_cast<float>(highPeakFrequency()), static_cast<float>(highPeakGain()), static_cast<float>(highPeakQ()) },
+        { static_cast<float>(highShelfFrequency()), static_cast<float>(highShelfGain()), static_cast<float>(highShelfQ()) }
+    };
+    const auto sampleRate = static_cast<float>(audioSpecs().sampleRate);
+
+    for (auto band = 0u; band < BandCount; ++band) {
+        if (!force && bands[band] == _bands[band])
+            continue;
+        _bands[band] = bands[band];
+        _filter.setupCoefficients(band, DSP::Biquad::GenerateCoefficients(
+            DSP::Biquad::Internal::Specs {
+                Types[band],
+                sampleRate,
+                { std::min(bands[band][0], sampleRate * 0.45f), 0.0f },
+                bands[band][1],
+                bands[band][2],
+                false
+            }
+        ));
+    }
+}
+
+inline void Audio::ParametricEqualizer::receiveAudio(BufferView output)
+{
+    float *out = output.data<float>();
+    if (static_cast<bool>(byBass())) {
+        if (_cache.isSilent())
+            output.markSilent();
+        else
+            std::memcpy(out, _cache.data<float>(), output.size<std::uint8_t>());
+        return;
+    }
+    // The output is already cleared, the tail of the bands is considered flushed after one second of silence
+    if (_silence.feed(_cache.isSilent(), audioSpecs().processBlockSize, audioSpecs().sampleRate)) {
+        _filter.resetRegisters();
+        output.markSilent();
+        return;
+    }
+
+    const DB outGain = ConvertDecibelToRatio(static_cast<float>(outputVolume()));
+
+    updateCoefficients(false);
+    // Channels are planar, each one is filtered with its own registers
+    for (auto channel = 0u; channel < output.channelCount(); ++channel) {
+        const auto target = static_cast<Channel>(channel);
+        _filter.filterBlock(_cache.data<float>(target), audioSpecs().processBlockSize, output.data<float>(target), outGain, target);
+    }
+}
+
+inline void Audio::ParametricEqualizer::sendAudio(const BufferViews &inputs)
+{
+    if (!inputs.size())
+        return;
+    const DB inGain = ConvertDecibelToRatio(static_cast<float>(
+        static_cast<bool>(byBass()) ? inputGain() + outputVolume() : inputGain()
+    ));
+    DSP::Merge<float>(inputs, _cache, inGain, true);
+}
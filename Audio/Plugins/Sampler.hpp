@@ -9,9 +9,11 @@
 
 #include <Audio/PluginUtilsControlsVolume.hpp>
 #include <Audio/PluginUtilsControlsEnvelope.hpp>
-#include <Audio/BufferOctave.hpp>
+#include <Audio/SampleFile/SampleStore.hpp>
 #include "Managers/NoteManager.hpp"
 #include <Audio/DSP/FIR.hpp>
+#include <Audio/DSP/SincResampler.hpp>
+#include <Audio/DSP/Dispatch.hpp>
 
 namespace Audio
 {
@@ -45,12 +47,51 @@ class Audio::Sampler final : public Audio::IPlugin
         REGISTER_CONTROL_ENVELOPPE_AR(
             enveloppeAttack, 0.001, CONTROL_RANGE_STEP(0.0, 2.0, 0.001),
             enveloppeRelease, 0.001, CONTROL_RANGE_STEP(0.0, 2.0, 0.001)
+        ),
+        REGISTER_CONTROL_ENUM(
+            resamplingQuality,
+            CONTROL_ENUM_RANGE(
+                TR_TABLE(
+                    TR(English, "Low"),
+                    TR(French, "Basse")
+                ),
+                TR_TABLE(
+                    TR(English, "Medium"),
+                    TR(French, "Moyenne")
+                ),
+                TR_TABLE(
+                    TR(English, "High"),
+                    TR(French, "Haute")
+                )
+            ),
+            /* Control name */
+            TR_TABLE(
+                TR(English, "Resampling quality"),
+                TR(French, "Qualité du rééchantillonnage")
+            ),
+            /* Control's description */
+            TR_TABLE(
+                TR(English, "Quality of the pitch shift of octaves and tuned notes"),
+                TR(French, "Qualité du décalage de hauteur des octaves et des notes accordées")
+            ),
+            /* Control's short name */
+            TR_TABLE(
+                TR(English, "Quality")
+            ),
+            /* Control's unit */
+            TR_TABLE(
+                TR(English, "")
+            )
         )
     )
 
 public:
-    /** @brief Plugin constructor */
-    Sampler(const IPluginFactory *factory) noexcept : IPlugin(factory) {}
+    /** @brief Plugin constructor, generates the resampling tables of every quality out of the audio thread */
+    Sampler(const IPluginFactory *factory) noexcept : IPlugin(factory)
+    {
+        for (auto i = 0u; i < _sincTables.size(); ++i)
+            _sincTables[i] = DSP::SincResampler<float>::GetSincTable(DSP::SincResampler<float>::GetTapCount(static_cast<DSP::SincResampler<float>::Quality>(i)));
+    }
 
     virtual void receiveAudio(BufferView output);
 
@@ -72,19 +113,34 @@ public:
     template<typename Type>
     void loadSample(const std::string_view &path);
 
-    // [[nodiscard]] const OctaveBuffer &getBuffers(void) const noexcept { return _buffers; }
+    /** @brief Load a sample file with the type of the audio format */
+    void loadSample(const std::string_view &path);
+
+    /** @brief Get the shared octave of the loaded sample */
+    [[nodiscard]] const SharedOctave &octave(void) const noexcept { return _octave; }
 
 private:
-    // Cacheline 1 & 2
-    BufferOctave _buffers {};
-    // Cacheline 3 & 4
+    // Cacheline 1
+    /** @brief Octave of the loaded sample, shared with every sampler using the same file */
+    SharedOctave _octave {};
+    // Cacheline 2 & 3
     NoteManager<DSP::EnvelopeType::AR> _noteManager {};
 
     ExternalPaths _externalPaths;
-
-    float getEnvelopeGain(const Key key, const std::uint32_t index) noexcept
+    /** @brief Cache of a shifted voice channel before its envelope is applied */
+    Core::TinyVector<float> _shiftCache {};
+    /** @brief Envelope gains of the voice being generated */
+    Core::TinyVector<float> _gainCache {};
+    /** @brief Resampler of each key, keeps its read position in the octave buffer across blocks */
+    std::array<DSP::SincResampler<float>, KeyCount> _resamplers {};
+    /** @brief Resampling table of each quality */
+    std::array<DSP::SincResampler<float>::SincTablePtr, DSP::SincResampler<float>::QualityCount> _sincTables {};
+    /** @brief Quality used by the resamplers, their tables are only swapped when the control changes */
+    std::uint32_t _resamplingQuality { static_cast<std::uint32_t>(DSP::SincResampler<float>::Quality::Medium) };
+
+    void getEnvelopeGains(const Key key, const std::uint32_t index, float *gains, const std::uint32_t size) noexcept
     {
-        return _noteManager.getEnvelopeGain(key, index,
+        _noteManager.getEnvelopeGains(key, index, gains, size,
                 0.0f,
                 static_cast<float>(enveloppeAttack()),
                 0.0f,
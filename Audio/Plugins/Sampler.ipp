@@ -3,24 +3,21 @@
  * @ Description: Sampler implementation
  */
 
-#include <Audio/BufferOctave.hpp>
-#include <Audio/SampleFile/SampleManager.hpp>
 
 #include <Audio/DSP/FIR.hpp>
+#include <Audio/UtilsMidi.hpp>
 
 template<typename Type>
 inline void Audio::Sampler::loadSample(const std::string_view &path)
 {
-    SampleSpecs fileSpecs {};
     SampleSpecs desiredSpecs {
         audioSpecs().sampleRate,
         audioSpecs().channelArrangement,
         audioSpecs().format,
         0u
     };
-    _buffers[OctaveRootKey] = SampleManager<Type>::LoadSampleFile(std::string(path), desiredSpecs, fileSpecs);
-
-    GenerateOctave<Type>(_buffers[OctaveRootKey], _buffers);
+    // Samplers loading the same file share its octave
+    _octave = SampleStore::Acquire<Type>(std::string(path), desiredSpecs);
 
     // static DSP::FIRFilter<float> filter;
     // filter.setSpecs(DSP::Filter::FIRSpecs {
@@ -38,19 +35,38 @@ inline void Audio::Sampler::loadSample(const std::string_view &path)
     // SampleManager<float>::WriteSampleFile("filtered.wav", filtered);
 }
 
+inline void Audio::Sampler::loadSample(const std::string_view &path)
+{
+    switch (audioSpecs().format) {
+    case Format::Fixed8:
+        return loadSample<std::int8_t>(path);
+    case Format::Fixed16:
+        return loadSample<std::int16_t>(path);
+    case Format::Fixed32:
+        return loadSample<std::int32_t>(path);
+    default:
+        return loadSample<float>(path);
+    }
+}
+
 inline void Audio::Sampler::onAudioParametersChanged(void)
 {
-    for (auto &buffer : _buffers) {
-        const auto newSize = GetFormatByteLength(audioSpecs().format) * audioSpecs().processBlockSize;
-        buffer.resize(newSize, audioSpecs().sampleRate, audioSpecs().channelArrangement, audioSpecs().format);
+    if (_externalPaths.empty())
+        return;
+    // The octave is kept while its specs match, otherwise the store converts the new one from the file it already decoded
+    if (_octave) {
+        const auto &root = (*_octave)[OctaveRootKey];
+        if (root.sampleRate() == audioSpecs().sampleRate && root.channelArrangement() == audioSpecs().channelArrangement && root.format() == audioSpecs().format)
+            return;
     }
+    loadSample(_externalPaths[0]);
 }
 
 inline void Audio::Sampler::setExternalPaths(const ExternalPaths &paths)
 {
     _externalPaths = paths;
     if (!paths.empty()) {
-        loadSample<float>(paths[0]);
+        loadSample(paths[0]);
     }
 }
 
@@ -62,15 +78,26 @@ inline void Audio::Sampler::sendNotes(const NoteEvents &notes, const BeatRange &
 
 inline void Audio::Sampler::receiveAudio(BufferView output)
 {
-    if (_externalPaths.empty())
+    // Nothing is accumulated without samples or active notes
+    if (!_octave || !_noteManager.getAllActiveNoteSize()) {
+        output.markSilent();
         return;
+    }
 
     const DB outGain = ConvertDecibelToRatio(static_cast<float>(outputVolume()));
-    const std::uint32_t outSize = static_cast<std::uint32_t>(output.size<float>());
-    float * const out = reinterpret_cast<float *>(output.byteData());
+    const std::uint32_t outSize = static_cast<std::uint32_t>(output.channelSampleCount());
+    const std::size_t channelCount = output.channelCount();
+
+    // Resamplers switch to the prepared tables only when the control changes
+    const auto quality = std::min(static_cast<std::uint32_t>(resamplingQuality()), DSP::SincResampler<float>::QualityCount - 1u);
+    if (quality != _resamplingQuality) {
+        _resamplingQuality = quality;
+        for (auto &resampler : _resamplers)
+            resampler.setTable(_sincTables[quality]);
+    }
 
     _noteManager.processNotes(
-        [this, outGain, outSize, out](const Key key, const std::uint32_t readIndex, const NoteModifiers &modifiers) -> std::pair<std::uint32_t, std::uint32_t> {
+        [this, outGain, outSize, channelCount, &output, &buffers = *_octave](const Key key, const std::uint32_t readIndex, const NoteModifiers &modifiers) -> std::pair<std::uint32_t, std::uint32_t> {
             const std::int32_t realKeyIdx = static_cast<std::int32_t>(key) % KeysPerOctave;
             const std::int32_t realOctave = static_cast<std::int32_t>(key) / KeysPerOctave;
             std::int32_t bufferKeyIdx = realKeyIdx - OctaveRootKey + 1;
@@ -83,46 +110,59 @@ inline void Audio::Sampler::receiveAudio(BufferView output)
             } else
                 bufferOctave = realOctave - RootOctave;
 
-            auto * const sampleBuffer = _buffers[bufferKeyIdx].data<float>();
-            const auto sampleSize = static_cast<std::uint32_t>(_buffers[bufferKeyIdx].size<float>());
+            // Samples are loaded with the output channel arrangement, each channel is rendered from its own sample channel
+            const auto &sample = buffers[bufferKeyIdx];
+            const auto sampleChannelCount = sample.channelCount();
+            const auto sampleSize = static_cast<std::uint32_t>(sample.channelSampleCount());
+            const auto sampleChannel = [&sample, sampleChannelCount](const std::size_t channel) {
+                return sample.data<float>(static_cast<Channel>(std::min(channel, sampleChannelCount - 1u)));
+            };
             auto realOutSize = outSize;
-            auto realOut = out;
+            std::uint32_t outOffset = 0u;
 
             // Handle note end
             if (modifiers.sampleOffset && !readIndex) {
-                realOut += modifiers.sampleOffset;
+                outOffset = modifiers.sampleOffset;
                 realOutSize -= modifiers.sampleOffset;
             }
+            // Octaves and tunings are applied by the key resampler, starting from the nearest cached key
+            const auto &noteCache = _noteManager.noteCache(key);
+            const auto ratio = std::pow(2.0, bufferOctave)
+                    * Midi::NoteConverter::TuningToRatio(modifiers.tuning)
+                    * Midi::NoteConverter::TuningToRatio(noteCache.polyPressureModifiers.tuning);
+            auto &resampler = _resamplers[key];
+            if (!readIndex)
+                resampler.setPosition(0.0);
             // The key is already cached
-            if (!bufferOctave) {
+            if (ratio == 1.0 && resampler.position() == static_cast<double>(readIndex)) {
                 // Handle sample end
                 const auto samplesLeft = sampleSize - readIndex;
                 realOutSize = std::min(samplesLeft, realOutSize);
                 // Apply enveloppe
-                for (auto i = 0u, j = readIndex; i < realOutSize; ++i, ++j) {
-                    // realOut[i] += sampleBuffer[j] * outGain;
-                    realOut[i] += sampleBuffer[j] * getEnvelopeGain(key, j) * outGain;
+                getEnvelopeGains(key, readIndex, _gainCache.data(), realOutSize);
+                for (auto channel = 0u; channel < channelCount; ++channel) {
+                    DSP::Simd::Kernels().multiplyGains(sampleChannel(channel) + readIndex, _gainCache.data(),
+                            output.data<float>(static_cast<Channel>(channel)) + outOffset, realOutSize, outGain, true);
                 }
+                resampler.setPosition(static_cast<double>(readIndex + realOutSize));
                 return std::make_pair(realOutSize, sampleSize);
-            // The key need an octave shift
+            // The key need a pitch shift
             } else {
-                const auto bufferOctaveShift = std::pow(2.0, -bufferOctave);
-                const auto bufferOctaveReverseShift = std::pow(2.0, bufferOctave);
-                const std::uint32_t resampleSize = static_cast<std::uint32_t>(static_cast<float>(sampleSize) * bufferOctaveShift);
-                const std::uint32_t sampleOffset = static_cast<std::uint32_t>(static_cast<float>(readIndex) * bufferOctaveReverseShift);
-                // Handle sample end
-                const auto resamplesLeft = resampleSize - readIndex;
-                realOutSize = std::min(resamplesLeft, realOutSize);
-                const std::uint32_t sampleReadSize = static_cast<std::uint32_t>(static_cast<float>(realOutSize) * bufferOctaveReverseShift);
-                // Create resampled version of the base octave
-                DSP::Resampler<float>().resampleOctave<true, 8u>(sampleBuffer, realOut, sampleReadSize, audioSpecs().sampleRate, bufferOctave, sampleOffset);
-
-                /** @warning FIX PROBLEMS */
-                // Apply enveloppe
-                for (auto i = 0u, j = readIndex; i < realOutSize; ++i, ++j) {
-                    realOut[i] *= getEnvelopeGain(key, j) * outGain;
+                // Every channel is read from the same position, so each one produces the same sample count
+                const auto position = resampler.position();
+                for (auto channel = 0u; channel < channelCount; ++channel) {
+                    resampler.setPosition(position);
+                    const auto shiftSize = resampler.process<false>(sampleChannel(channel), sampleSize, _shiftCache.data(), realOutSize, ratio);
+                    // Apply enveloppe
+                    if (!channel)
+                        getEnvelopeGains(key, readIndex, _gainCache.data(), shiftSize);
+                    DSP::Simd::Kernels().multiplyGains(_shiftCache.data(), _gainCache.data(),
+                            output.data<float>(static_cast<Channel>(channel)) + outOffset, shiftSize, outGain, true);
+                    realOutSize = shiftSize;
                 }
-                return std::make_pair(realOutSize, resampleSize);
+                // The note ends once the whole sample is read, whatever the pitch changes were
+                const bool ended = resampler.position() >= static_cast<double>(sampleSize);
+                return std::make_pair(realOutSize, ended ? readIndex + realOutSize : 0u);
             }
         }
     );
@@ -131,4 +171,6 @@ inline void Audio::Sampler::receiveAudio(BufferView output)
 inline void Audio::Sampler::onAudioGenerationStarted(const BeatRange &)
 {
     _noteManager.reset();
+    _shiftCache.resize(audioSpecs().processBlockSize);
+    _gainCache.resize(audioSpecs().processBlockSize);
 }
@@ -27,12 +27,16 @@ inline void Audio::SigmaFilter::onAudioGenerationStarted(const BeatRange &)
 inline void Audio::SigmaFilter::receiveAudio(BufferView output)
 {
     const DB outGain = ConvertDecibelToRatio(static_cast<DB>(outputVolume()));
-    float *out = output.data<float>();
     output.clear();
     // Update filter cutoffs
     // _filter.setCutoffs(cutoffFrequencyFrom(), cutoffFrequencyTo());
 
-    _filter.filterBlock(_cache.data<float>(), audioSpecs().processBlockSize, out, outGain);
+    // Channels are planar, each one is filtered with its own registers
+    for (auto channel = 0u; channel < output.channelCount(); ++channel) {
+        const auto target = static_cast<Channel>(channel);
+        _filter.filterBlock(_cache.data<float>(target), audioSpecs().processBlockSize, output.data<float>(target), outGain, target);
+    }
+    output.setSilent(false);
 }
 
 inline void Audio::SigmaFilter::sendAudio(const BufferViews &inputs)
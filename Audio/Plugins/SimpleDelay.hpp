@@ -116,7 +116,7 @@ public:
     virtual void onAudioGenerationStarted(const BeatRange &range);
 
 private:
-    DSP::BasicDelay<float> _delay;
+    std::array<DSP::BasicDelay<float>, MaxChannelCount> _delays;
     Buffer _inputCache;
 };
 
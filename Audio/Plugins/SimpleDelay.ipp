@@ -11,7 +11,8 @@
 inline void Audio::SimpleDelay::onAudioGenerationStarted(const BeatRange &range)
 {
     UNUSED(range);
-    _delay.reset(audioSpecs(), 10.0f, static_cast<float>(delayTime()));
+    for (auto &delay : _delays)
+        delay.reset(audioSpecs(), 10.0f, static_cast<float>(delayTime()));
     _inputCache.resize(GetFormatByteLength(audioSpecs().format) * audioSpecs().processBlockSize, audioSpecs().sampleRate, audioSpecs().channelArrangement, audioSpecs().format);
     _inputCache.clear();
 }
@@ -19,18 +20,28 @@ inline void Audio::SimpleDelay::onAudioGenerationStarted(const BeatRange &range)
 inline void Audio::SimpleDelay::receiveAudio(BufferView output)
 {
     float *out = output.data<float>();
-    const auto outSize = output.size<float>();
+    const auto channelCount = output.channelCount();
+    const auto channelSize = output.channelSampleCount();
 
     output.clear();
     if (static_cast<bool>(byBass())) {
-        std::memcpy(out, _inputCache.data<float>(), output.size<std::uint8_t>());
+        if (_inputCache.isSilent())
+            output.markSilent();
+        else {
+            std::memcpy(out, _inputCache.data<float>(), output.size<std::uint8_t>());
+            output.setSilent(false);
+        }
         return;
     }
 
     /** @todo Maybe add this control to the process (_delay.receiveData) */
-    _delay.setDelayTime(static_cast<float>(audioSpecs().sampleRate), static_cast<float>(delayTime()));
-    // Mix input & delay output
-    _delay.receiveData(out, outSize, static_cast<float>(mixRate()));
+    // Mix input & delay output of each channel
+    for (auto channel = 0u; channel < channelCount; ++channel) {
+        auto &delay = _delays[channel];
+        delay.setDelayTime(static_cast<float>(audioSpecs().sampleRate), static_cast<float>(delayTime()));
+        delay.receiveData(output.data<float>(static_cast<Channel>(channel)), channelSize, static_cast<float>(mixRate()));
+    }
+    output.setSilent(false);
 
     // float dry { 1.0f };
     // float wet { 1.0f };
@@ -57,6 +68,8 @@ inline void Audio::SimpleDelay::sendAudio(const BufferViews &inputs)
     ));
     DSP::Merge<float>(inputs, _inputCache, inGain, true);
     if (!static_cast<bool>(byBass())) {
-        _delay.sendData(_inputCache.data<float>(), _inputCache.size<float>(), static_cast<float>(feedbackRate()));
+        const auto channelSize = _inputCache.channelSampleCount();
+        for (auto channel = 0u; channel < _inputCache.channelCount(); ++channel)
+            _delays[channel].sendData(_inputCache.data<float>(static_cast<Channel>(channel)), channelSize, static_cast<float>(feedbackRate()));
     }
 }
@@ -0,0 +1,121 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: PreviewCache
+ */
+
+#pragma once
+
+#include <Core/Vector.hpp>
+
+#include "Node.hpp"
+
+namespace Audio
+{
+    class PreviewCache;
+}
+
+/** @brief Content-addressed cache of rendered partition previews
+ *  A preview is identified by a hash of its notes, the state of the nodes it goes through and the audio specs.
+ *  Blocks are recorded while the preview is rendered, then replayed as long as the hash stays the same */
+class Audio::PreviewCache
+{
+public:
+    /** @brief Hash of a preview */
+    using Hash = std::size_t;
+
+    /** @brief List of recorded blocks */
+    using Blocks = Core::TinyVector<Buffer>;
+
+    /** @brief State of the cache during a preview */
+    enum class State : std::uint8_t {
+        Idle, Record, Replay
+    };
+
+    /** @brief A cached preview */
+    struct Entry
+    {
+        Hash hash { 0u };
+        std::uint32_t lastUse { 0u };
+        bool complete { false };
+        bool silentTail { false };
+        std::size_t blockCount { 0u }; // Number of recorded blocks
+        Blocks blocks {}; // Blocks reserved when the recording begins
+    };
+
+    /** @brief List of cached previews */
+    using Entries = Core::TinyVector<Entry>;
+
+    /** @brief Default maximum number of cached previews */
+    static constexpr std::size_t DefaultCapacity = 8u;
+
+    /** @brief Default maximum size of a single preview (in bytes) */
+    static constexpr std::size_t DefaultMaxEntryByteSize = 64ul * 1024ul * 1024ul;
+
+
+    /** @brief Compute the hash of a partition preview
+     *  The hash covers the partition notes, the partition node sub-tree, its parents up to the master (controls and automations) and the playback parameters */
+    [[nodiscard]] static Hash ComputeHash(const Node &partitionNode, const Partition &partition, const AudioSpecs &specs,
+            const BPM bpm, const BeatRange &startRange, const BeatRange &loopRange, const bool isLooping, const bool continued) noexcept;
+
+
+    /** @brief Get the current state */
+    [[nodiscard]] State state(void) const noexcept { return _state; }
+
+    /** @brief Get the number of cached previews */
+    [[nodiscard]] std::size_t size(void) const noexcept { return _entries.size(); }
+
+    /** @brief Get / Set the maximum number of cached previews */
+    [[nodiscard]] std::size_t capacity(void) const noexcept { return _capacity; }
+    void setCapacity(const std::size_t capacity);
+
+    /** @brief Get / Set the maximum size of a single preview (in bytes) */
+    [[nodiscard]] std::size_t maxEntryByteSize(void) const noexcept { return _maxEntryByteSize; }
+    void setMaxEntryByteSize(const std::size_t maxEntryByteSize) noexcept { _maxEntryByteSize = maxEntryByteSize; }
+
+
+    /** @brief Begin a preview
+     *  If a complete preview matches the hash, the cache switches to replay
+     *  Else if canRecord is true, a new preview is recorded (evicting the least recently used one if needed)
+     *  @param tailBeat Beat after which a silent block ends the recording
+     *  @param block Specs of the recorded blocks
+     *  @param blockCount Number of blocks reserved for the recording, a longer preview isn't cached
+     *  @return true if the preview will be replayed */
+    bool begin(const Hash hash, const Beat tailBeat, const bool canRecord, const BufferView &block, const std::size_t blockCount);
+
+    /** @brief Copy the next replayed block into output
+     *  @return false if the preview is exhausted and the rendering must resume */
+    [[nodiscard]] bool replay(Buffer &output) noexcept;
+
+    /** @brief Record a rendered block into the reserved ones, the recording is completed once a silent block is reached after the tail beat */
+    void record(const BufferView &input, const BeatRange &range);
+
+    /** @brief Mark the recorded preview as complete */
+    void complete(void) noexcept;
+
+    /** @brief Stop the current preview, an incomplete recording is discarded */
+    void stop(void) noexcept;
+
+    /** @brief Release every cached preview */
+    void clear(void) noexcept;
+
+private:
+    Entries _entries {};
+    std::size_t _capacity { DefaultCapacity };
+    std::size_t _maxEntryByteSize { DefaultMaxEntryByteSize };
+    std::size_t _entryIndex { 0u };
+    std::size_t _blockIndex { 0u };
+    std::uint32_t _useCount { 0u };
+    Beat _tailBeat { 0u };
+    State _state { State::Idle };
+
+    /** @brief Index returned by 'find' when no preview matches */
+    static constexpr std::size_t NotFound = ~static_cast<std::size_t>(0);
+
+    /** @brief Find the index of a complete preview by hash */
+    [[nodiscard]] std::size_t find(const Hash hash) const noexcept;
+
+    /** @brief Erase the least recently used preview */
+    void evict(void) noexcept;
+};
+
+#include "PreviewCache.ipp"
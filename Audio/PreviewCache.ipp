@@ -0,0 +1,208 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: PreviewCache implementation
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+namespace Audio::Internal
+{
+    /** @brief Combine a value into a hash */
+    template<typename Type>
+    inline void HashCombine(std::size_t &seed, const Type &value) noexcept
+    {
+        seed ^= std::hash<Type>{}(value) + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2);
+    }
+
+    /** @brief Combine a node state (automations, plugin, controls and external paths) into a hash */
+    inline void HashNodeState(std::size_t &seed, const Node &node) noexcept
+    {
+        HashCombine(seed, node.muted());
+        HashAutomations(seed, node);
+        auto * const plugin = const_cast<Node &>(node).plugin();
+        if (!plugin)
+            return;
+        HashCombine(seed, static_cast<const void *>(plugin->factory()));
+        const std::size_t controlCount = plugin->getMetaData().controls.size();
+        for (auto i = 0u; i < controlCount; ++i)
+            HashCombine(seed, static_cast<const IPlugin *>(plugin)->getControl(i));
+        if (static_cast<std::size_t>(plugin->getFlags()) & static_cast<std::size_t>(IPluginFactory::Flags::SingleExternalInput)) {
+            for (const auto &path : plugin->getExternalPaths())
+                HashCombine(seed, path);
+        }
+    }
+
+    /** @brief Combine the automations of a node into a hash */
+    inline void HashAutomations(std::size_t &seed, const Node &node) noexcept
+    {
+        const auto &automations = node.automations();
+
+        if (!automations.isSafe())
+            return;
+        for (const auto &automation : automations) {
+            if (!automation.isSafe())
+                continue;
+            HashCombine(seed, automation.headerCustomType().muted);
+            for (const auto &point : automation) {
+                HashCombine(seed, point.beat);
+                HashCombine(seed, static_cast<std::size_t>(point.type));
+                HashCombine(seed, point.curveRate);
+                HashCombine(seed, point.value);
+            }
+        }
+    }
+
+    /** @brief Combine a node sub-tree into a hash */
+    inline void HashNodeTree(std::size_t &seed, const Node &node) noexcept
+    {
+        HashNodeState(seed, node);
+        for (const auto &child : node.children())
+            HashNodeTree(seed, *child);
+    }
+}
+
+inline Audio::PreviewCache::Hash Audio::PreviewCache::ComputeHash(const Node &partitionNode, const Partition &partition, const AudioSpecs &specs,
+        const BPM bpm, const BeatRange &startRange, const BeatRange &loopRange, const bool isLooping, const bool continued) noexcept
+{
+    Hash seed = 0u;
+
+    for (const auto &note : partition) {
+        Internal::HashCombine(seed, note.range.from);
+        Internal::HashCombine(seed, note.range.to);
+        Internal::HashCombine(seed, note.key);
+        Internal::HashCombine(seed, note.velocity);
+        Internal::HashCombine(seed, note.tuning);
+    }
+    Internal::HashNodeTree(seed, partitionNode);
+    for (auto parent = partitionNode.parent(); parent; parent = parent->parent())
+        Internal::HashNodeState(seed, *parent);
+    Internal::HashCombine(seed, specs.sampleRate);
+    Internal::HashCombine(seed, static_cast<std::size_t>(specs.channelArrangement));
+    Internal::HashCombine(seed, static_cast<std::size_t>(specs.format));
+    Internal::HashCombine(seed, specs.processBlockSize);
+    Internal::HashCombine(seed, bpm);
+    Internal::HashCombine(seed, startRange.from);
+    Internal::HashCombine(seed, startRange.to);
+    Internal::HashCombine(seed, isLooping);
+    if (isLooping) {
+        Internal::HashCombine(seed, loopRange.from);
+        Internal::HashCombine(seed, loopRange.to);
+    }
+    Internal::HashCombine(seed, continued);
+    return seed;
+}
+
+inline void Audio::PreviewCache::setCapacity(const std::size_t capacity)
+{
+    stop();
+    _capacity = capacity;
+    while (_entries.size() > _capacity)
+        evict();
+}
+
+inline bool Audio::PreviewCache::begin(const Hash hash, const Beat tailBeat, const bool canRecord, const BufferView &block, const std::size_t blockCount)
+{
+    stop();
+    if (const auto index = find(hash); index != NotFound) {
+        _entries.at(index).lastUse = ++_useCount;
+        _entryIndex = index;
+        _blockIndex = 0u;
+        _state = State::Replay;
+        return true;
+    }
+    const auto reservedCount = std::min(blockCount, _maxEntryByteSize / std::max<std::size_t>(block.size<std::uint8_t>(), 1u));
+    if (!canRecord || !_capacity || !reservedCount)
+        return false;
+    while (_entries.size() >= _capacity)
+        evict();
+    _entries.push(Entry {
+        /* hash: */ hash,
+        /* lastUse: */ ++_useCount,
+        /* complete: */ false,
+        /* silentTail: */ false,
+        /* blockCount: */ 0u,
+        /* blocks: */ Blocks()
+    });
+    _entryIndex = _entries.size() - 1;
+    auto &blocks = _entries.at(_entryIndex).blocks;
+    blocks.resize(reservedCount);
+    for (auto &buffer : blocks)
+        buffer.resize(block.channelByteSize(), block.sampleRate(), block.channelArrangement(), block.format());
+    _tailBeat = tailBeat;
+    _state = State::Record;
+    return false;
+}
+
+inline bool Audio::PreviewCache::replay(Buffer &output) noexcept
+{
+    auto &entry = _entries.at(_entryIndex);
+
+    if (_blockIndex < entry.blockCount) {
+        const auto &block = entry.blocks.at(_blockIndex++);
+        std::memcpy(output.byteData(), block.byteData(), std::min(output.size<std::uint8_t>(), block.size<std::uint8_t>()));
+        output.setSilent(block.isSilent() && block.size<std::uint8_t>() >= output.size<std::uint8_t>());
+        return true;
+    } else if (entry.silentTail) {
+        output.clear();
+        return true;
+    }
+    return false;
+}
+
+inline void Audio::PreviewCache::record(const BufferView &input, const BeatRange &range)
+{
+    auto &entry = _entries.at(_entryIndex);
+
+    // The preview is longer than the reserved blocks
+    if (entry.blockCount == entry.blocks.size())
+        return stop();
+    entry.blocks.at(entry.blockCount++).copy(input);
+    if (range.from >= _tailBeat && input.isZero()) {
+        entry.silentTail = true;
+        complete();
+    }
+}
+
+inline void Audio::PreviewCache::complete(void) noexcept
+{
+    if (_state != State::Record)
+        return;
+    _entries.at(_entryIndex).complete = true;
+    _state = State::Idle;
+}
+
+inline void Audio::PreviewCache::stop(void) noexcept
+{
+    if (_state == State::Record && !_entries.at(_entryIndex).complete)
+        _entries.erase(_entries.begin() + _entryIndex);
+    _state = State::Idle;
+}
+
+inline void Audio::PreviewCache::clear(void) noexcept
+{
+    _state = State::Idle;
+    _entries.clear();
+}
+
+inline std::size_t Audio::PreviewCache::find(const Hash hash) const noexcept
+{
+    for (auto i = 0ul; i < _entries.size(); ++i) {
+        if (const auto &entry = _entries.at(i); entry.hash == hash && entry.complete)
+            return i;
+    }
+    return NotFound;
+}
+
+inline void Audio::PreviewCache::evict(void) noexcept
+{
+    if (_entries.empty())
+        return;
+    auto oldest = _entries.begin();
+    for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+        if (it->lastUse < oldest->lastUse)
+            oldest = it;
+    }
+    _entries.erase(oldest);
+}
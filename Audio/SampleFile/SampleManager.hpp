@@ -25,15 +25,23 @@ struct Audio::SampleManager
     static const constexpr std::tuple<
         const char *,
         Buffer(*)(const std::string &path, const SampleSpecs &desiredSpecs, SampleSpecs &fileSpecs, bool displaySpecs),
-        bool(*)(const std::string &path, const BufferView &inputBuffer)
+        bool(*)(const std::string &path, const BufferView &inputBuffer),
+        Buffer(*)(const std::string &path, SampleSpecs &fileSpecs)
     > SupportedExtension[] {
-        { SampleManagerWAV::Extension, &SampleManagerWAV::LoadFile, &SampleManagerWAV::WriteFile }
+        { SampleManagerWAV::Extension, &SampleManagerWAV::LoadFile, &SampleManagerWAV::WriteFile, &SampleManagerWAV::DecodeFile }
     };
 
     [[nodiscard]] static Buffer LoadSampleFile(const std::string &path, const SampleSpecs &desiredSpecs, SampleSpecs &fileSpecs, bool displaySpecs = false);
 
     [[nodiscard]] static Buffer LoadSampleFileExtension(const std::string &path, const std::string &ext, const SampleSpecs &desiredSpecs, SampleSpecs &fileSpecs, bool displaySpecs);
 
+    /** @brief Load a sample file without converting it, 'fileSpecs' receives its specs */
+    [[nodiscard]] static Buffer DecodeSampleFile(const std::string &path, SampleSpecs &fileSpecs);
+
+    /** @brief Convert a loaded sample to the desired specs */
+    [[nodiscard]] static Buffer ConvertSample(const Internal::BufferBase &sample, const SampleSpecs &desiredSpecs)
+        { return SampleManagerWAV::ConvertBuffer(sample, desiredSpecs); }
+
     [[nodiscard]] static bool WriteSampleFile(const std::string &path, const BufferView &sample);
 
     [[nodiscard]] static bool WriteSampleFileExtension(const std::string &path, const BufferView &sample, const std::string &ext);
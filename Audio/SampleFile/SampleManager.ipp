@@ -24,6 +24,17 @@ inline Audio::Buffer Audio::SampleManager<Type, Normalize>::LoadSampleFileExtens
     throw std::runtime_error("Audio::SampleManager::LoadSampleFileExtension: Extension file not supported: '" + ext + "'.");
 }
 
+template<typename Type, bool Normalize>
+inline Audio::Buffer Audio::SampleManager<Type, Normalize>::DecodeSampleFile(const std::string &path, SampleSpecs &fileSpecs)
+{
+    const auto ext = std::filesystem::path(path).extension().string();
+    for (const auto &extension : SupportedExtension) {
+        if (std::string(std::get<0>(extension)) == ext)
+            return std::get<3>(extension)(path, fileSpecs);
+    }
+    throw std::runtime_error("Audio::SampleManager::DecodeSampleFile: Extension file not supported: '" + ext + "'.");
+}
+
 template<typename Type, bool Normalize>
 inline bool Audio::SampleManager<Type, Normalize>::WriteSampleFile(const std::string &path,const BufferView &sample)
 {
@@ -13,52 +13,63 @@
 
 using namespace Audio;
 
+static Format GetFormatFromSDL(const SDL_AudioFormat sdlFormat) noexcept
+{
+    switch (sdlFormat) {
+    case AUDIO_F32:
+        return Format::Floating32;
+    case AUDIO_S32:
+        return Format::Fixed32;
+    case AUDIO_S16:
+        return Format::Fixed16;
+    case AUDIO_S8:
+        return Format::Fixed8;
+    default:
+        return Format::Floating32;
+    }
+}
+
+static SDL_AudioFormat GetSDLFormat(const Format format) noexcept
+{
+    switch (format) {
+    case Format::Unknown:
+        return 0;
+    case Format::Floating32:
+        return AUDIO_F32;
+    case Format::Fixed32:
+        return AUDIO_S32;
+    case Format::Fixed16:
+        return AUDIO_S16;
+    case Format::Fixed8:
+        return AUDIO_S8;
+    default:
+        return AUDIO_F32;
+    }
+}
+
 Buffer SampleManagerWAV::LoadFile(const std::string &path, const SampleSpecs &desiredSpecs, SampleSpecs &fileSpecs, bool displaySpecs)
 {
     UNUSED(displaySpecs);
-    UNUSED(desiredSpecs);
 
+    auto fileBuffer = DecodeFile(path, fileSpecs);
+
+    // Convert to desired specs !
+    if ((desiredSpecs.sampleRate != fileSpecs.sampleRate) || (desiredSpecs.format != fileSpecs.format) || (desiredSpecs.channelArrangement != fileSpecs.channelArrangement))
+        return ConvertBuffer(fileBuffer, desiredSpecs);
+    return fileBuffer;
+}
+
+Buffer SampleManagerWAV::DecodeFile(const std::string &path, SampleSpecs &fileSpecs)
+{
     SDL_AudioSpec sdlFileSpecs {};
     std::uint8_t *sdlBuffer { nullptr };
     std::uint32_t sdlBufferByteSize { 0u };
 
     if (!SDL_LoadWAV(path.c_str(), &sdlFileSpecs, &sdlBuffer, &sdlBufferByteSize)) {
         std::cout << SDL_GetError() << std::endl;
-        throw std::runtime_error("SampleManagerWAV::LoadFile: failed to load wave file: " + std::string(SDL_GetError()));
+        throw std::runtime_error("SampleManagerWAV::DecodeFile: failed to load wave file: " + std::string(SDL_GetError()));
     }
 
-    constexpr auto GetFormatFromSDL = [](const SDL_AudioFormat sdlFormat) -> Format {
-        switch (sdlFormat) {
-        case AUDIO_F32:
-            return Format::Floating32;
-        case AUDIO_S32:
-            return Format::Fixed32;
-        case AUDIO_S16:
-            return Format::Fixed16;
-        case AUDIO_S8:
-            return Format::Fixed8;
-        default:
-            return Format::Floating32;
-        }
-    };
-
-    constexpr auto GetSDLFormat = [](const Format format) -> SDL_AudioFormat {
-        switch (format) {
-        case Format::Unknown:
-            return 0;
-        case Format::Floating32:
-            return AUDIO_F32;
-        case Format::Fixed32:
-            return AUDIO_S32;
-        case Format::Fixed16:
-            return AUDIO_S16;
-        case Format::Fixed8:
-            return AUDIO_S8;
-        default:
-            return AUDIO_F32;
-        }
-    };
-
     std::size_t channelByteSize { static_cast<std::size_t>(sdlBufferByteSize) / static_cast<std::size_t>(sdlFileSpecs.channels) };
     Format format { GetFormatFromSDL(sdlFileSpecs.format) };
     ChannelArrangement channelArrangement { static_cast<ChannelArrangement>(sdlFileSpecs.channels) };
@@ -70,34 +81,68 @@ Buffer SampleManagerWAV::LoadFile(const std::string &path, const SampleSpecs &de
     fileSpecs.format = format;
     fileSpecs.channelByteSize = channelByteSize;
 
-    // Convert to desired specs !
-    if ((desiredSpecs.sampleRate != fileSpecs.sampleRate) || (desiredSpecs.format != fileSpecs.format) || (desiredSpecs.channelArrangement != fileSpecs.channelArrangement)) {
-        // Setup SDL converter
-        std::cout << "SampleManagerWAV::LoadFile: CONVERTING" << std::endl;
-        SDL_AudioCVT sdlConverter {};
-        if (SDL_BuildAudioCVT(
-            &sdlConverter,
-            sdlFileSpecs.format, sdlFileSpecs.channels, sdlFileSpecs.freq,
-            GetSDLFormat(desiredSpecs.format), static_cast<std::uint8_t>(desiredSpecs.channelArrangement), static_cast<int>(desiredSpecs.sampleRate)
-        ) == -1) {
-            std::cout << SDL_GetError() << std::endl;
-            throw std::runtime_error("SampleManagerWAV::LoadFile: failed to convert audio file with desired specs: " + std::string(SDL_GetError()));
-        }
-        /** @todo Hmm, maybe remove this SDL_assert with a 'real' assertion ! */
-        SDL_assert(sdlConverter.needed);
-        sdlConverter.len = sdlBufferByteSize;
-        sdlConverter.buf = static_cast<std::uint8_t *>(std::malloc(sdlBufferByteSize * sdlConverter.len_mult));
-        std::memcpy(sdlConverter.buf, sdlBuffer, sdlBufferByteSize);
-        // Convert the audio
+    ReadInterleaved(sdlBuffer, fileBuffer);
+    SDL_FreeWAV(sdlBuffer);
+    return fileBuffer;
+}
+
+Buffer SampleManagerWAV::ConvertBuffer(const Internal::BufferBase &input, const SampleSpecs &desiredSpecs)
+{
+    // Setup SDL converter
+    std::cout << "SampleManagerWAV::ConvertBuffer: CONVERTING" << std::endl;
+    SDL_AudioCVT sdlConverter {};
+    if (SDL_BuildAudioCVT(
+        &sdlConverter,
+        GetSDLFormat(input.format()), static_cast<std::uint8_t>(input.channelArrangement()), static_cast<int>(input.sampleRate()),
+        GetSDLFormat(desiredSpecs.format), static_cast<std::uint8_t>(desiredSpecs.channelArrangement), static_cast<int>(desiredSpecs.sampleRate)
+    ) == -1) {
+        std::cout << SDL_GetError() << std::endl;
+        throw std::runtime_error("SampleManagerWAV::ConvertBuffer: failed to convert audio buffer with desired specs: " + std::string(SDL_GetError()));
+    }
+    const auto byteSize = input.channelByteSize() * input.channelCount();
+    sdlConverter.len = static_cast<int>(byteSize);
+    sdlConverter.buf = static_cast<std::uint8_t *>(std::malloc(byteSize * static_cast<std::size_t>(sdlConverter.len_mult)));
+    // SDL converts interleaved frames while buffers are planar
+    WriteInterleaved(input, sdlConverter.buf);
+    // Convert the audio
+    if (sdlConverter.needed)
         SDL_ConvertAudio(&sdlConverter);
-        fileBuffer.resize(static_cast<std::size_t>(sdlConverter.len_cvt) / static_cast<std::size_t>(desiredSpecs.channelArrangement), desiredSpecs.sampleRate, desiredSpecs.channelArrangement, desiredSpecs.format);
-        std::memcpy(fileBuffer.data<std::uint8_t>(), sdlConverter.buf, sdlConverter.len_cvt);
-    } else {
-        std::memcpy(fileBuffer.data<std::uint8_t>(), sdlBuffer, sdlBufferByteSize);
+    else
+        sdlConverter.len_cvt = sdlConverter.len;
+    Buffer output(static_cast<std::size_t>(sdlConverter.len_cvt) / static_cast<std::size_t>(desiredSpecs.channelArrangement), desiredSpecs.sampleRate, desiredSpecs.channelArrangement, desiredSpecs.format);
+    ReadInterleaved(sdlConverter.buf, output);
+    std::free(sdlConverter.buf);
+    return output;
+}
+
+void SampleManagerWAV::ReadInterleaved(const std::uint8_t *data, Buffer &buffer) noexcept
+{
+    const auto arrangement = buffer.channelArrangement();
+    switch (buffer.format()) {
+    case Format::Fixed8:
+        return WriteToBufferImpl(reinterpret_cast<const std::int8_t *>(data), buffer.data<std::int8_t>(), arrangement, buffer.size<std::int8_t>());
+    case Format::Fixed16:
+        return WriteToBufferImpl(reinterpret_cast<const std::int16_t *>(data), buffer.data<std::int16_t>(), arrangement, buffer.size<std::int16_t>());
+    case Format::Fixed32:
+        return WriteToBufferImpl(reinterpret_cast<const std::int32_t *>(data), buffer.data<std::int32_t>(), arrangement, buffer.size<std::int32_t>());
+    default:
+        return WriteToBufferImpl(reinterpret_cast<const float *>(data), buffer.data<float>(), arrangement, buffer.size<float>());
     }
+}
 
-    SDL_FreeWAV(sdlBuffer);
-    return fileBuffer;
+void SampleManagerWAV::WriteInterleaved(const Internal::BufferBase &buffer, std::uint8_t *data) noexcept
+{
+    const auto arrangement = buffer.channelArrangement();
+    switch (buffer.format()) {
+    case Format::Fixed8:
+        return WriteFromBufferImpl(buffer.data<std::int8_t>(), reinterpret_cast<std::int8_t *>(data), arrangement, buffer.size<std::int8_t>());
+    case Format::Fixed16:
+        return WriteFromBufferImpl(buffer.data<std::int16_t>(), reinterpret_cast<std::int16_t *>(data), arrangement, buffer.size<std::int16_t>());
+    case Format::Fixed32:
+        return WriteFromBufferImpl(buffer.data<std::int32_t>(), reinterpret_cast<std::int32_t *>(data), arrangement, buffer.size<std::int32_t>());
+    default:
+        return WriteFromBufferImpl(buffer.data<float>(), reinterpret_cast<float *>(data), arrangement, buffer.size<float>());
+    }
 }
 
 Buffer SampleManagerWAV::LoadFile_old(const std::string &path, const SampleSpecs &desiredSpecs, SampleSpecs &fileSpecs, bool displaySpecs)
@@ -234,7 +279,9 @@ bool SampleManagerWAV::WriteFile(const std::string &path, const BufferView &inpu
         throw std::runtime_error("SampleManagerWAV::WriteFile: Failed opening the file !");
 
 
-    const auto fileSize { inputBuffer.size<std::uint8_t>() - 44u };
+    // The RIFF chunk size counts every byte after its own header: the 'WAVE' tag, the format chunk and the data chunk
+    const auto dataSize { inputBuffer.size<std::uint8_t>() };
+    const auto fileSize { dataSize + 36u };
     HeaderChunk chunk {
         { 'R', 'I', 'F', 'F' },
         static_cast<std::uint32_t>(fileSize),
@@ -262,7 +309,7 @@ bool SampleManagerWAV::WriteFile(const std::string &path, const BufferView &inpu
         fmtFormat,
         channels,
         static_cast<std::uint32_t>(inputBuffer.sampleRate()),
-        static_cast<std::uint32_t>(inputBuffer.sampleRate() * sampleByteSize),
+        static_cast<std::uint32_t>(inputBuffer.sampleRate() * sampleByteSize * channels),
         static_cast<std::uint16_t>(sampleByteSize * channels),
         static_cast<std::uint16_t>(sampleByteSize * 8u)
     };
@@ -287,7 +334,6 @@ bool SampleManagerWAV::WriteFile(const std::string &path, const BufferView &inpu
         // }
     }
 
-    const auto dataSize = fileSize + 44u;
     HeaderData data {
         { 'd', 'a', 't', 'a' },
         static_cast<std::uint32_t>(dataSize)
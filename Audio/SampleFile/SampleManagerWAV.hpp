@@ -70,12 +70,24 @@ struct Audio::SampleManagerWAV
 
     [[nodiscard]] static Buffer LoadFile(const std::string &path, const SampleSpecs &desiredSpecs, SampleSpecs &fileSpecs, bool displaySpecs);
 
+    /** @brief Load a audio WAV file into a buffer, keeping the specs of the file */
+    [[nodiscard]] static Buffer DecodeFile(const std::string &path, SampleSpecs &fileSpecs);
+
+    /** @brief Convert a buffer to the desired specs */
+    [[nodiscard]] static Buffer ConvertBuffer(const Internal::BufferBase &input, const SampleSpecs &desiredSpecs);
+
 private:
     template<typename Type>
     static void WriteToBufferImpl(const Type *input, Type *output, const ChannelArrangement channelArrangement, const std::size_t size) noexcept;
 
     template<typename Type>
     static void WriteFromBufferImpl(const Type *input, Type *output, const ChannelArrangement channelArrangement, const std::size_t size) noexcept;
+
+    /** @brief Split interleaved data into the planar channels of a buffer */
+    static void ReadInterleaved(const std::uint8_t *data, Buffer &buffer) noexcept;
+
+    /** @brief Interleave the planar channels of a buffer into data */
+    static void WriteInterleaved(const Internal::BufferBase &buffer, std::uint8_t *data) noexcept;
 };
 
 #include "SampleManagerWAV.ipp"
@@ -6,24 +6,22 @@
 #include <filesystem>
 #include <fstream>
 
+#include <Audio/DSP/Reformater.hpp>
+
 template<typename Type>
 inline void Audio::SampleManagerWAV::WriteToBufferImpl(const Type *input, Type *output, const ChannelArrangement channelArrangement, const std::size_t size) noexcept
 {
-    const auto arrangement = static_cast<std::size_t>(channelArrangement);
-    for (auto iChannel = 0u; iChannel < arrangement; ++iChannel) {
-        for (auto i = 0u; i < size; ++i) {
-            output[i * (iChannel + 1)] = input[i * arrangement];
-        }
-    }
+    const auto channelCount = static_cast<std::size_t>(channelArrangement);
+    const auto frameCount = size / channelCount;
+
+    DSP::Reformater::Deinterleave(input, output, frameCount, channelCount, frameCount);
 }
 
 template<typename Type>
 inline void Audio::SampleManagerWAV::WriteFromBufferImpl(const Type *input, Type *output, const ChannelArrangement channelArrangement, const std::size_t size) noexcept
 {
-    const auto arrangement = static_cast<std::size_t>(channelArrangement);
-    for (auto iChannel = 0u; iChannel < arrangement; ++iChannel) {
-        for (auto i = 0u; i < size; ++i) {
-            output[i * arrangement] = input[i * (iChannel + 1)];
-        }
-    }
+    const auto channelCount = static_cast<std::size_t>(channelArrangement);
+    const auto frameCount = size / channelCount;
+
+    DSP::Reformater::Interleave(input, output, frameCount, channelCount, frameCount);
 }
@@ -0,0 +1,97 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: SampleStore
+ */
+
+#include <algorithm>
+
+#include "SampleStore.hpp"
+
+using namespace Audio;
+
+SampleStore SampleStore::_Instance {};
+
+BufferOctave &SampleStore::MakeUnique(SharedOctave &octave)
+{
+    std::lock_guard<std::mutex> lock(_Instance._mutex);
+
+    if (octave.use_count() > 1) {
+        auto copy = std::make_shared<BufferOctave>();
+        for (auto i = 0u; i < KeysPerOctave; ++i) {
+            if ((*octave)[i])
+                (*copy)[i].copy((*octave)[i]);
+        }
+        octave = std::move(copy);
+    } else {
+        // The single user may write in place once no one else can acquire the octave, nor convert its decoded file
+        if (auto * const deleter = std::get_deleter<OctaveDeleter>(octave); deleter)
+            deleter->source.reset();
+        const auto it = std::find_if(_Instance._entries.begin(), _Instance._entries.end(), [&octave](const Entry &entry) {
+            return !entry.octave.owner_before(octave) && !octave.owner_before(entry.octave);
+        });
+        if (it != _Instance._entries.end())
+            _Instance._entries.erase(it);
+    }
+    // Every octave is created mutable, only its shared handle is constant
+    return const_cast<BufferOctave &>(*octave);
+}
+
+std::size_t SampleStore::Count(void) noexcept
+{
+    std::lock_guard<std::mutex> lock(_Instance._mutex);
+
+    _Instance.collect();
+    return _Instance._entries.size();
+}
+
+std::size_t SampleStore::CountSources(void) noexcept
+{
+    std::lock_guard<std::mutex> lock(_Instance._mutex);
+    std::vector<const Buffer *> sources;
+
+    for (const auto &entry : _Instance._entries) {
+        if (const auto source = entry.source.lock(); source && std::find(sources.begin(), sources.end(), source.get()) == sources.end())
+            sources.push_back(source.get());
+    }
+    return sources.size();
+}
+
+SharedOctave SampleStore::findOrInsert(Key &&key, std::shared_ptr<BufferOctave> &&octave, const SharedSource &source)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (auto shared = find(key); shared)
+        return shared;
+    collect();
+    _entries.push_back(Entry { std::move(key), octave, source });
+    return octave;
+}
+
+SharedOctave SampleStore::find(const Key &key) noexcept
+{
+    for (const auto &entry : _entries) {
+        if (entry.key == key) {
+            if (auto octave = entry.octave.lock(); octave)
+                return octave;
+        }
+    }
+    return SharedOctave();
+}
+
+SampleStore::SharedSource SampleStore::findSource(const std::string &path) noexcept
+{
+    for (const auto &entry : _entries) {
+        if (entry.key.path != path)
+            continue;
+        if (auto source = entry.source.lock(); source)
+            return source;
+    }
+    return SharedSource();
+}
+
+void SampleStore::collect(void) noexcept
+{
+    _entries.erase(std::remove_if(_entries.begin(), _entries.end(), [](const Entry &entry) {
+        return entry.octave.expired();
+    }), _entries.end());
+}
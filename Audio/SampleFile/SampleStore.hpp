@@ -0,0 +1,98 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: SampleStore
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <Audio/BufferOctave.hpp>
+
+namespace Audio
+{
+    class SampleStore;
+
+    /** @brief Immutable octave shared between every user of a sample */
+    using SharedOctave = std::shared_ptr<const BufferOctave>;
+}
+
+/** @brief Process-wide store of loaded samples
+ *  Users loading the same file with the same specs share a single octave, released with its last user.
+ *  The decoded file is kept while any octave of it is used, other specs are converted from it instead of reading the file again */
+class Audio::SampleStore
+{
+public:
+    /** @brief Identify a loaded octave */
+    struct Key
+    {
+        std::string path {};
+        SampleRate sampleRate { 0u };
+        ChannelArrangement channelArrangement { ChannelArrangement::Mono };
+        Format format { Format::Floating32 };
+        std::size_t typeSize { 0u }; // Sample type used to generate the octave
+
+        /** @brief Equality operator */
+        [[nodiscard]] bool operator==(const Key &other) const noexcept
+            { return sampleRate == other.sampleRate && channelArrangement == other.channelArrangement &&
+                format == other.format && typeSize == other.typeSize && path == other.path; }
+    };
+
+    /** @brief Get the octave of a sample file, generating it only if no one shares it yet
+     *  The file is read only if none of its octaves is used */
+    template<typename Type>
+    [[nodiscard]] static SharedOctave Acquire(const std::string &path, const SampleSpecs &desiredSpecs);
+
+    /** @brief Get a mutable octave, copying it first if other users share it (copy on write)
+     *  The octave is detached from the store so no new user may share it */
+    [[nodiscard]] static BufferOctave &MakeUnique(SharedOctave &octave);
+
+    /** @brief Get the number of octaves still used */
+    [[nodiscard]] static std::size_t Count(void) noexcept;
+
+    /** @brief Get the number of decoded files still kept by the used octaves */
+    [[nodiscard]] static std::size_t CountSources(void) noexcept;
+
+private:
+    /** @brief Decoded file, at the specs of the file */
+    using SharedSource = std::shared_ptr<const Buffer>;
+
+    /** @brief Deleter of the stored octaves, the decoded file is released with the last octave generated from it
+     *  The deleter outlives the octave while weak references remain, so it drops its source explicitly */
+    struct OctaveDeleter
+    {
+        SharedSource source {};
+
+        void operator()(const BufferOctave * const octave) noexcept { delete octave; source.reset(); }
+    };
+
+    /** @brief A weak reference to a loaded octave and its decoded file, they expire with their last user */
+    struct Entry
+    {
+        Key key {};
+        std::weak_ptr<const BufferOctave> octave {};
+        std::weak_ptr<const Buffer> source {};
+    };
+
+    std::mutex _mutex {};
+    std::vector<Entry> _entries {};
+
+    static SampleStore _Instance;
+
+    /** @brief Get a shared octave or register a freshly loaded one if none is alive */
+    [[nodiscard]] SharedOctave findOrInsert(Key &&key, std::shared_ptr<BufferOctave> &&octave, const SharedSource &source);
+
+    /** @brief Find a shared octave, the store must be locked */
+    [[nodiscard]] SharedOctave find(const Key &key) noexcept;
+
+    /** @brief Find the decoded file of a path used by any alive octave, the store must be locked */
+    [[nodiscard]] SharedSource findSource(const std::string &path) noexcept;
+
+    /** @brief Drop the expired entries, the store must be locked */
+    void collect(void) noexcept;
+};
+
+#include "SampleStore.ipp"
@@ -0,0 +1,40 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: SampleStore implementation
+ */
+
+#include "SampleManager.hpp"
+
+template<typename Type>
+inline Audio::SharedOctave Audio::SampleStore::Acquire(const std::string &path, const SampleSpecs &desiredSpecs)
+{
+    Key key {
+        path,
+        desiredSpecs.sampleRate,
+        desiredSpecs.channelArrangement,
+        desiredSpecs.format,
+        sizeof(Type)
+    };
+
+    SharedSource source;
+    {
+        std::lock_guard<std::mutex> lock(_Instance._mutex);
+        if (auto octave = _Instance.find(key); octave)
+            return octave;
+        source = _Instance.findSource(key.path);
+    }
+    // The file is loaded and converted without the lock, a concurrent load of the same key is resolved on insertion
+    if (!source) {
+        SampleSpecs fileSpecs {};
+        source = std::make_shared<const Buffer>(SampleManager<Type>::DecodeSampleFile(path, fileSpecs));
+    }
+    // The octave owns the decoded file, the store only keeps weak references to both
+    std::shared_ptr<BufferOctave> octave(new BufferOctave(), OctaveDeleter { source });
+    auto &root = (*octave)[OctaveRootKey];
+    if (source->sampleRate() == desiredSpecs.sampleRate && source->channelArrangement() == desiredSpecs.channelArrangement && source->format() == desiredSpecs.format)
+        root.copy(*source);
+    else
+        root = SampleManager<Type>::ConvertSample(*source, desiredSpecs);
+    GenerateOctave<Type>(root, *octave);
+    return _Instance.findOrInsert(std::move(key), std::move(octave), source);
+}
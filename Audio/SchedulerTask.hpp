@@ -16,11 +16,19 @@ namespace Audio
     template<IPlugin::Flags Flags, bool ProcessNotesAndControls, bool ProcessAudio, Audio::PlaybackMode Playback>
     class SchedulerTask;
 
+    /** @brief Deduce a task type from a runtime flags, the constructed task is forwarded to 'callback' */
+    template<Audio::PlaybackMode Playback, bool ProcessNotesAndControls, bool ProcessAudio, IPlugin::Flags Deduced = IPlugin::Flags::None,
+            IPlugin::Flags Begin = IPlugin::Flags::AudioInput, IPlugin::Flags End = IPlugin::Flags::NoteOutput, typename Callback>
+    [[nodiscard]] auto DeduceSchedulerTask(Callback &&callback, const IPlugin::Flags flags,
+            const AScheduler *scheduler, Node *node, const NoteEvents * const parentNoteStack,
+            Buffer * const output = nullptr, const bool clearOutput = false, Node * const pathChild = nullptr);
+
     /** @brief Make a task from a runtime flags */
     template<Audio::PlaybackMode Playback, bool ProcessNotesAndControls, bool ProcessAudio, IPlugin::Flags Deduced = IPlugin::Flags::None,
             IPlugin::Flags Begin = IPlugin::Flags::AudioInput, IPlugin::Flags End = IPlugin::Flags::NoteOutput>
     [[nodiscard]] std::pair<Flow::Task, const NoteEvents *> MakeSchedulerTask(Flow::Graph &graph, const IPlugin::Flags flags,
-            const AScheduler *scheduler, Node *node, const NoteEvents * const parentNoteStack);
+            const AScheduler *scheduler, Node *node, const NoteEvents * const parentNoteStack,
+            Buffer * const output = nullptr, const bool clearOutput = false, Node * const pathChild = nullptr);
 }
 
 template<Audio::IPlugin::Flags Flags, bool ProcessNotesAndControls, bool ProcessAudio, Audio::PlaybackMode Playback>
@@ -32,9 +40,13 @@ public:
     static constexpr bool HasAudioInput = static_cast<std::size_t>(Flags) & static_cast<std::size_t>(IPlugin::Flags::AudioInput);
     static constexpr bool HasAudioOutput = static_cast<std::size_t>(Flags) & static_cast<std::size_t>(IPlugin::Flags::AudioOutput);
 
-    /** @brief Construct the task from a node, a scheduler and a parent note stack */
-    SchedulerTask(const AScheduler *scheduler, Node *node, const NoteEvents * const parentNoteStack) noexcept
-        : _scheduler(scheduler), _node(node), _parentNoteStack(parentNoteStack) {}
+    /** @brief Construct the task from a node, a scheduler and a parent note stack
+     *  @param output If not null, the node accumulates its audio into this buffer instead of its own cache (cleared first if clearOutput is true)
+     *  @param pathChild If not null, only the cache of this child is collected (partition branch or task chain) */
+    SchedulerTask(const AScheduler *scheduler, Node *node, const NoteEvents * const parentNoteStack,
+            Buffer * const output = nullptr, const bool clearOutput = false, Node * const pathChild = nullptr) noexcept
+        : _scheduler(scheduler), _node(node), _parentNoteStack(parentNoteStack),
+            _output(output), _pathChild(pathChild), _clearOutput(clearOutput) {}
 
     /** @brief Move constructor */
     SchedulerTask(SchedulerTask &&other) noexcept = default;
@@ -58,6 +70,9 @@ private:
     const NoteEvents *_parentNoteStack { nullptr };
     BufferViews _bufferStack {};
     ControlEvents _controlStack {};
+    Buffer *_output { nullptr };
+    Node *_pathChild { nullptr };
+    bool _clearOutput { false };
 
     /** @brief Get the internal scheduler*/
     [[nodiscard]] const AScheduler &scheduler(void) const noexcept { return *_scheduler; }
@@ -66,6 +81,9 @@ private:
     [[nodiscard]] const Node &node(void) const noexcept { return *_node; }
     [[nodiscard]] Node &node(void) noexcept { return *_node; }
 
+    /** @brief Let the plugin write into 'output' and keep track of its known-silent state */
+    void receiveAudio(IPlugin &plugin, Buffer &output) noexcept;
+
     /** @brief Collect every controls of the current frame */
     [[nodiscard]] bool collectControls(const BeatRange &beatRange) noexcept;
 
@@ -78,6 +96,8 @@ private:
     /** @brief Collect every notes within the current offset */
     void collectPartition(const Partition &partition, const BeatRange &beatRange, const double beatToSampleRatio, const double beatMissOffset, const PartitionInstance &instance = PartitionInstance()) noexcept;
 
-    /** @brief Collect every cached children buffer of the current frame */
+    /** @brief Collect every cached children buffer of the current frame
+     *  Children accumulating into the lane caches are skipped, the lanes are collected instead
+     *  If a path child is set, only its cache is collected */
     bool collectBuffers(void) noexcept;
 };
@@ -6,39 +6,53 @@
 #include <Audio/DSP/Merge.hpp>
 #include <iostream>
 
-template<Audio::PlaybackMode Playback, bool ProcessNotesAndControls, bool ProcessAudio, Audio::IPlugin::Flags Deduced, Audio::IPlugin::Flags Begin, Audio::IPlugin::Flags End>
-inline std::pair<Flow::Task, const Audio::NoteEvents *> Audio::MakeSchedulerTask(Flow::Graph &graph, const IPlugin::Flags flags,
-        const AScheduler *scheduler, Node *node, const NoteEvents * const parentNoteStack)
+template<Audio::PlaybackMode Playback, bool ProcessNotesAndControls, bool ProcessAudio, Audio::IPlugin::Flags Deduced, Audio::IPlugin::Flags Begin, Audio::IPlugin::Flags End, typename Callback>
+inline auto Audio::DeduceSchedulerTask(Callback &&callback, const IPlugin::Flags flags,
+        const AScheduler *scheduler, Node *node, const NoteEvents * const parentNoteStack,
+        Buffer * const output, const bool clearOutput, Node * const pathChild)
 {
     if constexpr (Begin > End) {
-        Audio::SchedulerTask<Deduced, ProcessNotesAndControls, ProcessAudio, Playback> schedulerTask(scheduler, node, parentNoteStack);
-        return std::make_pair(
-            graph.emplace(std::move(schedulerTask)),
-            schedulerTask.noteStack()
-        );
+        return callback(Audio::SchedulerTask<Deduced, ProcessNotesAndControls, ProcessAudio, Playback>(
+            scheduler, node, parentNoteStack, output, clearOutput, pathChild
+        ));
     } else {
         if (static_cast<std::size_t>(flags) & static_cast<std::size_t>(Begin)) {
-            return MakeSchedulerTask<
+            return DeduceSchedulerTask<
                 Playback,
                 ProcessNotesAndControls,
                 ProcessAudio,
                 static_cast<IPlugin::Flags>(static_cast<std::size_t>(Deduced) | static_cast<std::size_t>(Begin)),
                 static_cast<IPlugin::Flags>(static_cast<std::size_t>(Begin) << 1),
                 End
-            >(graph, flags, scheduler, node, parentNoteStack);
+            >(std::forward<Callback>(callback), flags, scheduler, node, parentNoteStack, output, clearOutput, pathChild);
         } else {
-            return MakeSchedulerTask<
+            return DeduceSchedulerTask<
                 Playback,
                 ProcessNotesAndControls,
                 ProcessAudio,
                 Deduced,
                 static_cast<IPlugin::Flags>(static_cast<std::size_t>(Begin) << 1),
                 End
-            >(graph, flags, scheduler, node, parentNoteStack);
+            >(std::forward<Callback>(callback), flags, scheduler, node, parentNoteStack, output, clearOutput, pathChild);
         }
     }
 }
 
+template<Audio::PlaybackMode Playback, bool ProcessNotesAndControls, bool ProcessAudio, Audio::IPlugin::Flags Deduced, Audio::IPlugin::Flags Begin, Audio::IPlugin::Flags End>
+inline std::pair<Flow::Task, const Audio::NoteEvents *> Audio::MakeSchedulerTask(Flow::Graph &graph, const IPlugin::Flags flags,
+        const AScheduler *scheduler, Node *node, const NoteEvents * const parentNoteStack,
+        Buffer * const output, const bool clearOutput, Node * const pathChild)
+{
+    return DeduceSchedulerTask<Playback, ProcessNotesAndControls, ProcessAudio, Deduced, Begin, End>(
+        [&graph](auto &&schedulerTask) {
+            // The note stack is owned by a pointer, it stays valid once the task is moved
+            const auto noteStack = schedulerTask.noteStack();
+            return std::make_pair(graph.emplace(std::move(schedulerTask)), noteStack);
+        },
+        flags, scheduler, node, parentNoteStack, output, clearOutput, pathChild
+    );
+}
+
 template<Audio::IPlugin::Flags Flags, bool ProcessNotesAndControls, bool ProcessAudio, Audio::PlaybackMode Playback>
 inline void Audio::SchedulerTask<Flags, ProcessNotesAndControls, ProcessAudio, Playback>::operator()(void) noexcept
 {
@@ -74,8 +88,15 @@ inline void Audio::SchedulerTask<Flags, ProcessNotesAndControls, ProcessAudio, P
             _bufferStack.clear();
         }
         if constexpr (HasAudioOutput) {
-            node().cache().clear();
-            plugin.receiveAudio(node().cache());
+            if (_output && _clearOutput)
+                _output->clear();
+            // Accumulate directly into the parent lane, a muted node still renders into its own cache
+            if (_output && !node().muted())
+                receiveAudio(plugin, *_output);
+            else {
+                node().cache().clear();
+                receiveAudio(plugin, node().cache());
+            }
         } else {
             // Merge audio
             node().cache().clear();
@@ -85,6 +106,19 @@ inline void Audio::SchedulerTask<Flags, ProcessNotesAndControls, ProcessAudio, P
     }
 }
 
+template<Audio::IPlugin::Flags Flags, bool ProcessNotesAndControls, bool ProcessAudio, Audio::PlaybackMode Playback>
+inline void Audio::SchedulerTask<Flags, ProcessNotesAndControls, ProcessAudio, Playback>::receiveAudio(IPlugin &plugin, Buffer &output) noexcept
+{
+    const bool wasSilent = output.isSilent();
+
+    // Raw writes aren't tracked, only a plugin clearing or merging into its output can set it silent again
+    output.setSilent(false);
+    plugin.receiveAudio(output);
+    // A plugin that declared that it wrote nothing leaves the output as it was
+    if (output.consumeSilenceMark())
+        output.setSilent(wasSilent);
+}
+
 template<Audio::IPlugin::Flags Flags, bool ProcessNotesAndControls, bool ProcessAudio, Audio::PlaybackMode Playback>
 inline bool Audio::SchedulerTask<Flags, ProcessNotesAndControls, ProcessAudio, Playback>::collectControls(const BeatRange &beatRange) noexcept
 {
@@ -96,6 +130,7 @@ inline bool Audio::SchedulerTask<Flags, ProcessNotesAndControls, ProcessAudio, P
     if (auto &events = automationsHeader.controlsOnTheFly; events) {
         _controlStack.insert(_controlStack.end(), events.beginUnsafe(), events.endUnsafe());
         events.clearUnsafe();
+        _scheduler->notifyEventsOnTheFlyConsumed();
     }
     if constexpr (Playback == PlaybackMode::Production) {
         ParamID paramID = 0u;
@@ -154,6 +189,7 @@ inline bool Audio::SchedulerTask<Flags, ProcessNotesAndControls, ProcessAudio, P
     if (auto &events = partitionsHeader.notesOnTheFly; events) {
         _noteStack->insert(_noteStack->end(), events.beginUnsafe(), events.endUnsafe());
         events.clearUnsafe();
+        _scheduler->notifyEventsOnTheFlyConsumed();
     }
     if constexpr (Playback == PlaybackMode::Production) {
         if (auto &instances = partitionsHeader.instances; instances.isSafe()) {
@@ -204,9 +240,16 @@ inline void Audio::SchedulerTask<Flags, ProcessNotesAndControls, ProcessAudio, P
 template<Audio::IPlugin::Flags Flags, bool ProcessNotesAndControls, bool ProcessAudio, Audio::PlaybackMode Playback>
 inline bool Audio::SchedulerTask<Flags, ProcessNotesAndControls, ProcessAudio, Playback>::collectBuffers(void) noexcept
 {
+    if (_pathChild) {
+        if (!_pathChild->muted())
+            _bufferStack.push(_pathChild->cache());
+        return _bufferStack;
+    }
     for (auto &child : node().children()) {
-        if (!child->muted())
+        if (!child->muted() && !child->canAccumulateIntoParent())
             _bufferStack.push(child->cache());
     }
+    for (auto &lane : node().laneCaches())
+        _bufferStack.push(lane);
     return _bufferStack;
 }
@@ -0,0 +1,64 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: Scheduler Task Chain
+ */
+
+#pragma once
+
+#include <memory>
+
+#include <Core/Vector.hpp>
+
+namespace Audio
+{
+    class SchedulerTaskChain;
+}
+
+/** @brief A list of scheduler tasks executed serially as a single graph task
+ *  Used to coarsen chains of nodes that can't be processed in parallel anyway */
+class Audio::SchedulerTaskChain
+{
+public:
+    /** @brief Default constructor */
+    SchedulerTaskChain(void) noexcept = default;
+
+    /** @brief Move constructor */
+    SchedulerTaskChain(SchedulerTaskChain &&other) noexcept = default;
+
+    /** @brief Move assignment */
+    SchedulerTaskChain &operator=(SchedulerTaskChain &&other) noexcept = default;
+
+    /** @brief Append a task at the end of the chain */
+    template<typename Task>
+    void push(Task &&task);
+
+    /** @brief Get the number of fused tasks */
+    [[nodiscard]] std::size_t size(void) const noexcept { return _steps.size(); }
+
+    /** @brief Execution operator */
+    void operator()(void) noexcept;
+
+private:
+    /** @brief Type-erased step of the chain */
+    struct AStep
+    {
+        virtual ~AStep(void) noexcept = default;
+
+        virtual void operator()(void) noexcept = 0;
+    };
+
+    /** @brief Step holding a task */
+    template<typename Task>
+    struct Step final : public AStep
+    {
+        Task task;
+
+        Step(Task &&other) noexcept : task(std::move(other)) {}
+
+        void operator()(void) noexcept final { task(); }
+    };
+
+    Core::TinyVector<std::unique_ptr<AStep>> _steps {};
+};
+
+#include "SchedulerTaskChain.ipp"
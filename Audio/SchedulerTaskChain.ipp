@@ -0,0 +1,16 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: Scheduler Task Chain
+ */
+
+template<typename Task>
+inline void Audio::SchedulerTaskChain::push(Task &&task)
+{
+    _steps.push(std::make_unique<Step<std::remove_reference_t<Task>>>(std::move(task)));
+}
+
+inline void Audio::SchedulerTaskChain::operator()(void) noexcept
+{
+    for (auto &step : _steps)
+        (*step)();
+}
@@ -9,6 +9,8 @@
 #include <math.h>
 #include <cmath>
 
+#include <array>
+
 #include <Core/Assert.hpp>
 
 #include "Base.hpp"
@@ -35,12 +37,23 @@ struct Audio::Midi::NoteConverter
         return static_cast<Key>(12 * std::log(frequency) + MidiRootKey);
     }
 
+    /** @brief Equal temperament frequency of every MIDI key */
+    static inline const std::array<float, KeyCount> KeyFrequencies = [] {
+        std::array<float, KeyCount> frequencies {};
+        for (auto key = 0u; key < KeyCount; ++key)
+            frequencies[key] = static_cast<float>(std::pow(2.0, (static_cast<double>(key) - MidiRootKey) / 12.0) * RootFrequency);
+        return frequencies;
+    }();
+
     /** @brief Convert a MIDI key to a frequency */
     inline static float KeyToFrequency(Key key = MidiRootKey) noexcept {
         if (key > 0x7F)
             key = 0x7F;
-        key -= MidiRootKey;
-        key /= 12;
-        return static_cast<float>(std::pow(key, 2)) * RootFrequency;
+        return KeyFrequencies[key];
+    }
+
+    /** @brief Convert a note tuning to a frequency ratio */
+    inline static double TuningToRatio(const Tuning tuning) noexcept {
+        return std::pow(2.0, static_cast<double>(static_cast<std::int16_t>(tuning)) / 1200.0);
     }
 };
@@ -3,72 +3,125 @@
  * @ Description: Benchmark of the Biquad (filter) class
  */
 
-#include <iostream>
+#include <cmath>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
 #include <Audio/DSP/Biquad.hpp>
 
-using namespace DSP;
+using namespace Audio::DSP;
 
-static void BlockProcessBasic(benchmark::State &state)
+static Biquad::Internal::Coefficients GetSection(const std::size_t index) noexcept
 {
-    // std::cout << (static_cast<float>(state.range(1)) / state.range(0) * 1'000'000.f) << " ns" << std::endl;
-    // auto filter = BiquadFactory<>::CreateFilter<BiquadParam::BasicType::LowPass, BiquadParam::FormType::Inversed>(static_cast<double>(state.range()), 0.25, 0.0, 0.707);
+    return Biquad::Internal::GenerateCoefficientsPeak(48000.0f, 100.0f + 431.0f * static_cast<float>(index % 23u), 3.0f, 1.5f, false);
+}
+
+static std::vector<float> GetSignal(const std::size_t size)
+{
+    std::vector<float> signal(size);
+
+    for (auto i = 0u; i < size; ++i)
+        signal[i] = std::sin(static_cast<float>(i) * 0.1f);
+    return signal;
+}
+
+static void ProcessChain(benchmark::State &state)
+{
+    const auto sectionCount = static_cast<std::size_t>(state.range(0));
+    const auto blockSize = static_cast<std::size_t>(state.range(1));
+    std::vector<Biquad::Filter<Biquad::Internal::Form::Transposed2>> chain(sectionCount);
+    const auto input = GetSignal(blockSize);
+    std::vector<float> output(blockSize);
 
-    // auto filter = Biquad<BiquadParam::BiquadForm::DirectForm1, BiquadParam::BasicType::LowPass>();
-    // auto filter = BiquadMaker<BiquadParam::Optimization::Optimized, float>::MakeBiquad(state.range(0), 0.2, 0);
-    auto filter = BiquadMaker<BiquadParam::Optimization::Optimized, float>::MakeBiquad(state.range(0), 0.2, 0);
-    // filter.
+    for (auto section = 0u; section < sectionCount; ++section) {
+        chain[section].setupCoefficients(GetSection(section));
+        chain[section].resetRegisters();
+    }
+    for (auto _ : state) {
+        chain[0].filterBlock(input.data(), blockSize, output.data());
+        for (auto section = 1u; section < sectionCount; ++section)
+            chain[section].filterBlock(output.data(), blockSize, output.data());
+        benchmark::DoNotOptimize(output.data());
+    }
+}
 
-    benchmark::DoNotOptimize(filter);
+static void ProcessCascade(benchmark::State &state)
+{
+    const auto sectionCount = static_cast<std::size_t>(state.range(0));
+    const auto blockSize = static_cast<std::size_t>(state.range(1));
+    Biquad::Cascade cascade;
+    const auto input = GetSignal(blockSize);
+    std::vector<float> output(blockSize);
+
+    cascade.setSectionCount(sectionCount);
+    for (auto section = 0u; section < sectionCount; ++section)
+        cascade.setupCoefficients(section, GetSection(section));
     for (auto _ : state) {
-        float buf[state.range(1)];
-        // benchmark::DoNotOptimize(*buf);
-        filter.processBlock(buf, state.range(1));
+        cascade.filterBlock(input.data(), blockSize, output.data());
+        benchmark::DoNotOptimize(output.data());
     }
 }
 
-BENCHMARK(BlockProcessBasic)
-    ->Args({ 44100, 512 })
-    ->Args({ 44100, 1024 })
-    ->Args({ 44100, 2048 })
-    ->Args({ 44100, 4096 })
-
-    // ->Args({ 48000, 512 })
-    // ->Args({ 48000, 1024 })
-    // ->Args({ 48000, 2048 })
-    // ->Args({ 48000, 4096 })
-
-    // ->Args({ 92000, 512 })
-    // ->Args({ 92000, 1024 })
-    // ->Args({ 92000, 2048 })
-    // ->Args({ 92000, 4096 })
+// Both curves run the same sections, the cascade pays a pipeline fill and drain of one lane count per block
+BENCHMARK(ProcessChain)
+    ->Args({ 1, 512 })->Args({ 2, 512 })->Args({ 4, 512 })->Args({ 8, 512 })->Args({ 16, 512 })
 ;
 
-static void BlockProcessBasicFMA(benchmark::State &state)
+BENCHMARK(ProcessCascade)
+    ->Args({ 1, 512 })->Args({ 2, 512 })->Args({ 4, 512 })->Args({ 8, 512 })->Args({ 16, 512 })
+;
+
+static void ProcessFilters(benchmark::State &state)
 {
-    auto filter = BiquadMaker<BiquadParam::Optimization::Optimized, float>::MakeBiquad(state.range(0), 0.2, 0);
-    benchmark::DoNotOptimize(filter);
+    constexpr auto SectionCount = 2u;
+    const auto filterCount = static_cast<std::size_t>(state.range(0));
+    const auto blockSize = static_cast<std::size_t>(state.range(1));
+    std::vector<Biquad::Filter<Biquad::Internal::Form::Transposed2>> filters(filterCount * SectionCount);
+    const auto input = GetSignal(blockSize);
+    std::vector<std::vector<float>> outputs(filterCount, std::vector<float>(blockSize));
+
+    for (auto i = 0u; i < filters.size(); ++i) {
+        filters[i].setupCoefficients(GetSection(i));
+        filters[i].resetRegisters();
+    }
     for (auto _ : state) {
-        float buf[state.range(1)];
-        filter.processBlock1(buf, state.range(1));
+        for (auto filter = 0u; filter < filterCount; ++filter) {
+            filters[filter * SectionCount].filterBlock(input.data(), blockSize, outputs[filter].data());
+            for (auto section = 1u; section < SectionCount; ++section)
+                filters[filter * SectionCount + section].filterBlock(outputs[filter].data(), blockSize, outputs[filter].data());
+            benchmark::DoNotOptimize(outputs[filter].data());
+        }
     }
 }
 
-BENCHMARK(BlockProcessBasicFMA)
-    ->Args({ 44100, 512 })
-    ->Args({ 44100, 1024 })
-    ->Args({ 44100, 2048 })
-    ->Args({ 44100, 4096 })
-
-    // ->Args({ 48000, 512 })
-    // ->Args({ 48000, 1024 })
-    // ->Args({ 48000, 2048 })
-    // ->Args({ 48000, 4096 })
-
-    // ->Args({ 92000, 512 })
-    // ->Args({ 92000, 1024 })
-    // ->Args({ 92000, 2048 })
-    // ->Args({ 92000, 4096 })
-;
\ No newline at end of file
+static void ProcessBank(benchmark::State &state)
+{
+    constexpr auto SectionCount = 2u;
+    const auto filterCount = static_cast<std::size_t>(state.range(0));
+    const auto blockSize = static_cast<std::size_t>(state.range(1));
+    Biquad::Bank bank;
+    const auto input = GetSignal(blockSize);
+    std::vector<std::vector<float>> outputs(filterCount, std::vector<float>(blockSize));
+    std::vector<const float *> inputPointers(filterCount, input.data());
+    std::vector<float *> outputPointers(filterCount);
+
+    bank.resize(filterCount, SectionCount);
+    for (auto filter = 0u; filter < filterCount; ++filter) {
+        outputPointers[filter] = outputs[filter].data();
+        for (auto section = 0u; section < SectionCount; ++section)
+            bank.setupCoefficients(filter, section, GetSection(filter * SectionCount + section));
+    }
+    for (auto _ : state) {
+        bank.filterBlock(inputPointers.data(), outputPointers.data(), blockSize);
+        benchmark::DoNotOptimize(outputPointers.data());
+    }
+}
+
+BENCHMARK(ProcessFilters)
+    ->Args({ 2, 512 })->Args({ 4, 512 })->Args({ 8, 512 })->Args({ 16, 512 })
+;
+
+BENCHMARK(ProcessBank)
+    ->Args({ 2, 512 })->Args({ 4, 512 })->Args({ 8, 512 })->Args({ 16, 512 })
+;
@@ -4,6 +4,7 @@
  */
 
 #include <iostream>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
@@ -66,3 +67,38 @@ BENCHMARK(ProcessSPSCQueue)
 // BENCHMARK(ProcessStd)
 //     ->Args({ 44100, 512 })
 // ;
+
+template<bool Partitioned>
+static void ProcessFIR(benchmark::State &state)
+{
+    const auto filterSize = static_cast<std::uint32_t>(state.range(0));
+    const auto blockSize = static_cast<std::uint32_t>(state.range(1));
+    Audio::DSP::FIR::Internal::Instance<float> instance;
+    std::vector<float> input(blockSize), output(blockSize);
+
+    instance.coefficients().resize(filterSize);
+    for (auto i = 0u; i < filterSize; ++i)
+        instance.coefficients()[i] = std::sin(static_cast<float>(i)) / static_cast<float>(filterSize);
+    instance.onCoefficientsChanged();
+    instance.resizeLastInputs(filterSize - 1u);
+    for (auto i = 0u; i < blockSize; ++i)
+        input[i] = std::sin(static_cast<float>(i) * 0.1f);
+    const auto partitionSize = std::max(Audio::DSP::FIR::Internal::Instance<float>::GetPartitionSize(filterSize, blockSize),
+        Audio::DSP::FIR::Internal::Instance<float>::MinPartitionSize);
+    for (auto _ : state) {
+        if constexpr (Partitioned)
+            instance.filterPartitioned<false>(input.data(), blockSize, output.data(), 1.0f, partitionSize);
+        else
+            instance.filterDirect<false>(input.data(), blockSize, output.data(), 1.0f);
+        benchmark::DoNotOptimize(output.data());
+    }
+}
+
+// The crossover of Audio::DSP::FIR::Internal::Instance::PartitionedFilterSize is the filter size where both curves meet
+BENCHMARK_TEMPLATE(ProcessFIR, false)
+    ->Args({ 17, 512 })->Args({ 33, 512 })->Args({ 65, 512 })->Args({ 129, 512 })->Args({ 257, 512 })
+;
+
+BENCHMARK_TEMPLATE(ProcessFIR, true)
+    ->Args({ 17, 512 })->Args({ 33, 512 })->Args({ 65, 512 })->Args({ 129, 512 })->Args({ 257, 512 })->Args({ 1025, 512 })->Args({ 4097, 512 })
+;
@@ -7,6 +7,7 @@ get_filename_component(AudioTestsDir ${CMAKE_CURRENT_LIST_FILE} PATH)
 set(AudioTestsSources
     ${AudioTestsDir}/tests_BeatRange.cpp
     ${AudioTestsDir}/tests_Buffer.cpp
+    ${AudioTestsDir}/tests_AudioBlockQueue.cpp
     ${AudioTestsDir}/tests_Point.cpp
     ${AudioTestsDir}/tests_Automation.cpp
     ${AudioTestsDir}/tests_Automations.cpp
@@ -18,14 +19,20 @@ set(AudioTestsSources
     ${AudioTestsDir}/tests_Merge.cpp
     ${AudioTestsDir}/tests_Resampler.cpp
     ${AudioTestsDir}/tests_Biquad.cpp
+    ${AudioTestsDir}/tests_FIR.cpp
+    ${AudioTestsDir}/tests_Wavetable.cpp
     ${AudioTestsDir}/tests_EnvelopeGenerator.cpp
+    ${AudioTestsDir}/tests_FM.cpp
     ${AudioTestsDir}/tests_Project.cpp
+    ${AudioTestsDir}/tests_PreviewCache.cpp
+    ${AudioTestsDir}/tests_CacheAllocator.cpp
+    ${AudioTestsDir}/tests_Scheduler.cpp
 
     ${AudioTestsDir}/tests_Reformater.cpp
+    ${AudioTestsDir}/tests_UtilsMidi.cpp
 
     # ${AudioTestsDir}/tests_SchedulerTask.cpp
     # ${AudioTestsDir}/tests_Device.cpp
-    # ${AudioTestsDir}/tests_UtilsMidi.cpp
 )
 
 add_executable(${PROJECT_NAME} ${AudioTestsSources})
@@ -0,0 +1,200 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: Unit tests of the audio block queue
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Audio/AudioBlockQueue.hpp>
+
+using namespace Audio;
+
+static constexpr std::size_t QueueBlockSize = 16u;
+
+static void FillBlock(Buffer &block, const float value)
+{
+    for (auto i = 0u; i < QueueBlockSize; ++i)
+        block.data<float>()[i] = value;
+}
+
+TEST(AudioBlockQueue, SwapWithoutCopy)
+{
+    AudioBlockQueue queue;
+    Buffer block(QueueBlockSize * sizeof(float), 44100, ChannelArrangement::Mono, Format::Floating32);
+
+    queue.prepare(2u, QueueBlockSize * sizeof(float), 44100, ChannelArrangement::Mono, Format::Floating32);
+    FillBlock(block, 1.0f);
+    const auto rendered = block.byteData();
+    ASSERT_TRUE(queue.tryPush(block, block.size<std::uint8_t>()));
+    // The producer received a free block instead of its rendered one
+    ASSERT_TRUE(block);
+    ASSERT_NE(block.byteData(), rendered);
+    FillBlock(block, 2.0f);
+    ASSERT_TRUE(queue.tryPush(block, block.size<std::uint8_t>()));
+    // The queue is full
+    ASSERT_FALSE(queue.tryPush(block, block.size<std::uint8_t>()));
+
+    std::vector<float> output(QueueBlockSize * 2u, 0.0f);
+    ASSERT_TRUE(queue.tryPop(reinterpret_cast<std::uint8_t *>(output.data()), output.size() * sizeof(float)));
+    for (auto i = 0u; i < QueueBlockSize; ++i) {
+        ASSERT_EQ(output[i], 1.0f);
+        ASSERT_EQ(output[QueueBlockSize + i], 2.0f);
+    }
+    ASSERT_FALSE(queue.tryPop(reinterpret_cast<std::uint8_t *>(output.data()), sizeof(float)));
+}
+
+TEST(AudioBlockQueue, CapacityMismatch)
+{
+    AudioBlockQueue queue;
+    Buffer block(QueueBlockSize * 2u * sizeof(float), 44100, ChannelArrangement::Mono, Format::Floating32);
+
+    queue.prepare(2u, QueueBlockSize * sizeof(float), 44100, ChannelArrangement::Mono, Format::Floating32);
+    const auto rendered = block.byteData();
+    // A block larger than the slots is refused, it is neither copied nor swapped
+    ASSERT_FALSE(queue.tryPush(block, block.size<std::uint8_t>()));
+    ASSERT_EQ(block.byteData(), rendered);
+    std::vector<float> output(QueueBlockSize, 0.0f);
+    ASSERT_FALSE(queue.tryPop(reinterpret_cast<std::uint8_t *>(output.data()), sizeof(float)));
+}
+
+TEST(AudioBlockQueue, PartialReads)
+{
+    AudioBlockQueue queue;
+    Buffer block(QueueBlockSize * sizeof(float), 44100, ChannelArrangement::Mono, Format::Floating32);
+    std::vector<float> output(QueueBlockSize / 4u, 0.0f);
+    const auto readSize = output.size() * sizeof(float);
+
+    queue.prepare(2u, QueueBlockSize * sizeof(float), 44100, ChannelArrangement::Mono, Format::Floating32);
+    FillBlock(block, 1.0f);
+    // Only the first half of the block is handed over (loop crop)
+    ASSERT_TRUE(queue.tryPush(block, block.size<std::uint8_t>() / 2u));
+    FillBlock(block, 2.0f);
+    ASSERT_TRUE(queue.tryPush(block, block.size<std::uint8_t>()));
+
+    ASSERT_TRUE(queue.tryPop(reinterpret_cast<std::uint8_t *>(output.data()), readSize));
+    ASSERT_EQ(output.front(), 1.0f);
+    ASSERT_TRUE(queue.tryPop(reinterpret_cast<std::uint8_t *>(output.data()), readSize));
+    ASSERT_EQ(output.back(), 1.0f);
+    // The first slot is released, a new block can be pushed
+    FillBlock(block, 3.0f);
+    ASSERT_TRUE(queue.tryPush(block, block.size<std::uint8_t>()));
+    for (auto i = 0u; i < 4u; ++i) {
+        ASSERT_TRUE(queue.tryPop(reinterpret_cast<std::uint8_t *>(output.data()), readSize));
+        ASSERT_EQ(output.front(), 2.0f);
+    }
+    ASSERT_TRUE(queue.tryPop(reinterpret_cast<std::uint8_t *>(output.data()), readSize));
+    ASSERT_EQ(output.front(), 3.0f);
+}
+
+TEST(AudioBlockQueue, StereoInterleave)
+{
+    AudioBlockQueue queue;
+    Buffer block(QueueBlockSize * sizeof(float), 44100, ChannelArrangement::Stereo, Format::Floating32);
+
+    queue.prepare(1u, QueueBlockSize * sizeof(float), 44100, ChannelArrangement::Stereo, Format::Floating32);
+    for (auto i = 0u; i < QueueBlockSize; ++i) {
+        block.data<float>(Channel::Left)[i] = static_cast<float>(i);
+        block.data<float>(Channel::Right)[i] = -static_cast<float>(i);
+    }
+    ASSERT_TRUE(queue.tryPush(block, block.size<std::uint8_t>()));
+
+    // Planar channels are interleaved frame by frame, even across partial reads
+    std::vector<float> output(QueueBlockSize, 0.0f);
+    ASSERT_TRUE(queue.tryPop(reinterpret_cast<std::uint8_t *>(output.data()), output.size() * sizeof(float)));
+    for (auto i = 0u; i < QueueBlockSize / 2u; ++i) {
+        ASSERT_EQ(output[i * 2u], static_cast<float>(i));
+        ASSERT_EQ(output[i * 2u + 1u], -static_cast<float>(i));
+    }
+    ASSERT_TRUE(queue.tryPop(reinterpret_cast<std::uint8_t *>(output.data()), output.size() * sizeof(float)));
+    for (auto i = 0u; i < QueueBlockSize / 2u; ++i) {
+        ASSERT_EQ(output[i * 2u], static_cast<float>(QueueBlockSize / 2u + i));
+        ASSERT_EQ(output[i * 2u + 1u], -static_cast<float>(QueueBlockSize / 2u + i));
+    }
+}
+
+TEST(AudioBlockQueue, Depth)
+{
+    AudioBlockQueue queue;
+    Buffer block(QueueBlockSize * sizeof(float), 44100, ChannelArrangement::Mono, Format::Floating32);
+
+    queue.prepare(4u, QueueBlockSize * sizeof(float), 44100, ChannelArrangement::Mono, Format::Floating32);
+    queue.setDepth(2u);
+    ASSERT_TRUE(queue.tryPush(block, block.size<std::uint8_t>()));
+    ASSERT_TRUE(queue.tryPush(block, block.size<std::uint8_t>()));
+    ASSERT_FALSE(queue.tryPush(block, block.size<std::uint8_t>()));
+    queue.setDepth(8u);
+    ASSERT_EQ(queue.depth(), 4u);
+    ASSERT_TRUE(queue.tryPush(block, block.size<std::uint8_t>()));
+}
+
+TEST(AudioBlockQueue, Retract)
+{
+    AudioBlockQueue queue;
+    Buffer block(QueueBlockSize * sizeof(float), 44100, ChannelArrangement::Mono, Format::Floating32);
+    const AudioBlockQueue::Block *lastKept = nullptr;
+    const auto isValid = [](const AudioBlockQueue::Block &block) { return block.nextRange.from <= 20u; };
+
+    queue.prepare(8u, QueueBlockSize * sizeof(float), 44100, ChannelArrangement::Mono, Format::Floating32);
+    for (auto i = 0u; i < 6u; ++i) {
+        FillBlock(block, static_cast<float>(i));
+        ASSERT_TRUE(queue.tryPush(block, block.size<std::uint8_t>(), BeatRange { (i + 1u) * 10u, (i + 2u) * 10u }, 0.0));
+    }
+    // Blocks ending after beat 20 are dropped
+    ASSERT_TRUE(queue.tryRetract(1u, isValid, lastKept));
+    ASSERT_TRUE(lastKept);
+    ASSERT_EQ(lastKept->nextRange.from, 20u);
+    // Nothing left to drop
+    ASSERT_TRUE(queue.tryRetract(1u, isValid, lastKept));
+    ASSERT_FALSE(lastKept);
+
+    std::vector<float> output(QueueBlockSize, 0.0f);
+    ASSERT_TRUE(queue.tryPop(reinterpret_cast<std::uint8_t *>(output.data()), output.size() * sizeof(float)));
+    ASSERT_EQ(output.front(), 0.0f);
+    ASSERT_TRUE(queue.tryPop(reinterpret_cast<std::uint8_t *>(output.data()), output.size() * sizeof(float)));
+    ASSERT_EQ(output.front(), 1.0f);
+    ASSERT_FALSE(queue.tryPop(reinterpret_cast<std::uint8_t *>(output.data()), output.size() * sizeof(float)));
+}
+
+TEST(AudioBlockQueue, ConcurrentRetract)
+{
+    constexpr std::size_t BlockCount = 20000u;
+
+    AudioBlockQueue queue;
+    Buffer block(QueueBlockSize * sizeof(float), 44100, ChannelArrangement::Mono, Format::Floating32);
+    std::atomic<bool> done { false };
+    std::size_t mismatchCount = 0u;
+
+    queue.prepare(8u, QueueBlockSize * sizeof(float), 44100, ChannelArrangement::Mono, Format::Floating32);
+    // The consumer must read every index once and in order whatever the producer retracts meanwhile
+    std::thread consumer([&queue, &done, &mismatchCount] {
+        std::vector<float> output(QueueBlockSize, 0.0f);
+        for (std::size_t expected = 0u; expected != BlockCount;) {
+            if (!queue.tryPop(reinterpret_cast<std::uint8_t *>(output.data()), output.size() * sizeof(float))) {
+                std::this_thread::yield();
+                continue;
+            }
+            mismatchCount += output.front() != static_cast<float>(expected);
+            expected = static_cast<std::size_t>(output.front()) + 1u;
+        }
+        done = true;
+    });
+    // Each block resumes from the index stored in the previous one, every fourth push retracts the last pushed block
+    std::size_t next = 0u;
+    for (std::size_t pushCount = 0u; !done;) {
+        FillBlock(block, static_cast<float>(next));
+        if (next == BlockCount || !queue.tryPush(block, block.size<std::uint8_t>(), BeatRange { static_cast<Beat>(next + 1u), static_cast<Beat>(next + 2u) }, 0.0)) {
+            std::this_thread::yield();
+            continue;
+        }
+        const AudioBlockQueue::Block *lastKept = nullptr;
+        const Beat cut = static_cast<Beat>(next++);
+        if (++pushCount % 4u == 0u && queue.tryRetract(1u, [cut](const AudioBlockQueue::Block &block) { return block.nextRange.from <= cut; }, lastKept) && lastKept)
+            next = lastKept->nextRange.from;
+    }
+    consumer.join();
+    ASSERT_EQ(mismatchCount, 0u);
+}
@@ -6,8 +6,12 @@
 #include <gtest/gtest.h>
 
 #include <Audio/DSP/Biquad.hpp>
+#include <Audio/DSP/Dispatch.hpp>
 
+#include <algorithm>
+#include <complex>
 #include <iostream>
+#include <vector>
 
 using namespace Audio::DSP;
 
@@ -31,3 +35,171 @@ TEST(Biquad, Instantiation)
     UNUSED(filterT2);
 
 }
+
+/** @brief Stable sections spread over the spectrum */
+static Biquad::Internal::Coefficients GetSection(const std::size_t index) noexcept
+{
+    const auto freq = 100.0f + 431.0f * static_cast<float>(index % 23u);
+
+    if (index % 2u)
+        return Biquad::Internal::GenerateCoefficientsPeak(48000.0f, freq, 6.0f, 1.5f, false);
+    return Biquad::Internal::GenerateCoefficientsLowPass(48000.0f, freq * 2.0f, 0.707f, false);
+}
+
+static std::vector<float> GetSignal(const std::size_t size)
+{
+    std::vector<float> signal(size);
+    std::uint32_t seed = 42u;
+
+    for (auto &sample : signal) {
+        seed = seed * 1664525u + 1013904223u;
+        sample = static_cast<float>(seed >> 8u) / static_cast<float>(1u << 24u) * 2.0f - 1.0f;
+    }
+    return signal;
+}
+
+static constexpr Simd::InstructionSet InstructionSets[] {
+    Simd::InstructionSet::Scalar, Simd::InstructionSet::SSE2, Simd::InstructionSet::AVX2,
+    Simd::InstructionSet::AVX512, Simd::InstructionSet::NEON
+};
+
+TEST(Biquad, CascadeMatchesFilterChain)
+{
+    // Block sizes shorter than the lane count run only the pipeline fill and drain
+    constexpr std::size_t BlockSizes[] { 64u, 3u, 45u, 1u, 128u, 17u, 254u };
+    const auto signal = GetSignal(512u);
+
+    for (const auto sectionCount : { 1u, 3u, 5u, 17u }) {
+        std::vector<Biquad::Filter<Biquad::Internal::Form::Transposed2>> chain(sectionCount);
+        std::vector<float> expected(signal);
+        for (auto section = 0u; section < sectionCount; ++section) {
+            chain[section].setupCoefficients(GetSection(section));
+            chain[section].resetRegisters();
+            chain[section].filterBlock(expected.data(), expected.size(), expected.data());
+        }
+        for (const auto set : InstructionSets) {
+            if (!Simd::ForceInstructionSet(set))
+                continue;
+            Biquad::Cascade cascade;
+            std::vector<float> output(signal.size());
+            cascade.setSectionCount(sectionCount);
+            for (auto section = 0u; section < sectionCount; ++section)
+                cascade.setupCoefficients(section, GetSection(section));
+            auto offset = 0u;
+            for (const auto blockSize : BlockSizes) {
+                cascade.filterBlock(signal.data() + offset, blockSize, output.data() + offset);
+                offset += blockSize;
+            }
+            for (auto i = 0u; i < signal.size(); ++i)
+                ASSERT_NEAR(output[i], expected[i], 1e-4f * std::max(1.0f, std::abs(expected[i])));
+        }
+    }
+    Simd::ResetInstructionSet();
+}
+
+TEST(Biquad, CascadeChannels)
+{
+    constexpr auto BlockSize = 100u;
+    const auto signal = GetSignal(BlockSize);
+    Biquad::Cascade cascade;
+    std::vector<float> left(BlockSize), right(BlockSize);
+
+    cascade.setSectionCount(6u);
+    for (auto section = 0u; section < 6u; ++section)
+        cascade.setupCoefficients(section, GetSection(section));
+    // Interleaving the channels must not mix their registers
+    cascade.filterBlock(signal.data(), BlockSize / 2u, left.data(), 1.0, Audio::Channel::Left);
+    cascade.filterBlock(signal.data(), BlockSize / 2u, right.data(), 1.0, Audio::Channel::Right);
+    cascade.filterBlock(signal.data() + BlockSize / 2u, BlockSize / 2u, left.data() + BlockSize / 2u, 1.0, Audio::Channel::Left);
+    cascade.filterBlock(signal.data() + BlockSize / 2u, BlockSize / 2u, right.data() + BlockSize / 2u, 1.0, Audio::Channel::Right);
+    for (auto i = 0u; i < BlockSize; ++i)
+        ASSERT_EQ(left[i], right[i]);
+}
+
+TEST(Biquad, BankMatchesFilters)
+{
+    constexpr auto SectionCount = 3u;
+    constexpr std::size_t BlockSizes[] { 100u, 7u, 149u };
+    const auto signal = GetSignal(256u);
+
+    for (const auto filterCount : { 1u, 5u, 19u }) {
+        std::vector<std::vector<float>> expected(filterCount);
+        for (auto filter = 0u; filter < filterCount; ++filter) {
+            expected[filter] = signal;
+            for (auto section = 0u; section < SectionCount; ++section) {
+                Biquad::Filter<Biquad::Internal::Form::Transposed2> single;
+                single.setupCoefficients(GetSection(filter * SectionCount + section));
+                single.resetRegisters();
+                single.filterBlock(expected[filter].data(), signal.size(), expected[filter].data());
+            }
+        }
+        for (const auto set : InstructionSets) {
+            if (!Simd::ForceInstructionSet(set))
+                continue;
+            Biquad::Bank bank;
+            std::vector<std::vector<float>> outputs(filterCount, std::vector<float>(signal.size()));
+            std::vector<const float *> inputPointers(filterCount);
+            std::vector<float *> outputPointers(filterCount);
+            bank.resize(filterCount, SectionCount);
+            for (auto filter = 0u; filter < filterCount; ++filter) {
+                for (auto section = 0u; section < SectionCount; ++section)
+                    bank.setupCoefficients(filter, section, GetSection(filter * SectionCount + section));
+            }
+            auto offset = 0u;
+            for (const auto blockSize : BlockSizes) {
+                for (auto filter = 0u; filter < filterCount; ++filter) {
+                    inputPointers[filter] = signal.data() + offset;
+                    outputPointers[filter] = outputs[filter].data() + offset;
+                }
+                bank.filterBlock(inputPointers.data(), outputPointers.data(), blockSize);
+                offset += blockSize;
+            }
+            for (auto filter = 0u; filter < filterCount; ++filter) {
+                for (auto i = 0u; i < signal.size(); ++i)
+                    ASSERT_NEAR(outputs[filter][i], expected[filter][i], 1e-4f * std::max(1.0f, std::abs(expected[filter][i])));
+            }
+        }
+    }
+    Simd::ResetInstructionSet();
+}
+
+/** @brief Magnitude response in decibels of a section at a given frequency */
+static float GetResponse(const Biquad::Internal::Coefficients &coefficients, const float sampleRate, const float freq) noexcept
+{
+    const auto z = std::polar(1.0, -2.0 * M_PI * static_cast<double>(freq / sampleRate));
+    const auto numerator = static_cast<double>(coefficients.b[0]) + static_cast<double>(coefficients.b[1]) * z + static_cast<double>(coefficients.b[2]) * z * z;
+    const auto denominator = 1.0 + static_cast<double>(coefficients.a[1]) * z + static_cast<double>(coefficients.a[2]) * z * z;
+
+    return static_cast<float>(20.0 * std::log10(std::abs(numerator / denominator)));
+}
+
+TEST(Biquad, GenerateEqualizerCoefficients)
+{
+    constexpr auto SampleRate = 48000.0f;
+    const auto generate = [](const Filter::AdvancedType type, const float freq, const float gain, const float q, const bool qAsBandWidth) {
+        return Biquad::GenerateCoefficients(Biquad::Internal::Specs { type, SampleRate, { freq, 0.0f }, gain, q, qAsBandWidth });
+    };
+
+    const auto peak = generate(Filter::AdvancedType::Peak, 1000.0f, 6.0f, 1.0f, true);
+    EXPECT_NEAR(GetResponse(peak, SampleRate, 1000.0f), 6.0f, 0.01f);
+    EXPECT_NEAR(GetResponse(peak, SampleRate, 20.0f), 0.0f, 0.1f);
+    // Half of the gain is reached half an octave away from the center
+    EXPECT_NEAR(GetResponse(peak, SampleRate, 1000.0f * std::sqrt(2.0f)), 3.0f, 0.2f);
+
+    const auto cut = generate(Filter::AdvancedType::Peak, 4000.0f, -12.0f, 2.0f, false);
+    EXPECT_NEAR(GetResponse(cut, SampleRate, 4000.0f), -12.0f, 0.01f);
+
+    const auto lowShelf = generate(Filter::AdvancedType::LowShelf, 200.0f, 9.0f, 0.707f, false);
+    EXPECT_NEAR(GetResponse(lowShelf, SampleRate, 5.0f), 9.0f, 0.05f);
+    EXPECT_NEAR(GetResponse(lowShelf, SampleRate, 200.0f), 4.5f, 0.05f);
+    EXPECT_NEAR(GetResponse(lowShelf, SampleRate, 10000.0f), 0.0f, 0.05f);
+
+    const auto highShelf = generate(Filter::AdvancedType::HighShelf, 5000.0f, -6.0f, 0.707f, false);
+    EXPECT_NEAR(GetResponse(highShelf, SampleRate, 23000.0f), -6.0f, 0.05f);
+    EXPECT_NEAR(GetResponse(highShelf, SampleRate, 5000.0f), -3.0f, 0.05f);
+    EXPECT_NEAR(GetResponse(highShelf, SampleRate, 50.0f), 0.0f, 0.05f);
+
+    // A flat band lets the signal through
+    const auto flat = generate(Filter::AdvancedType::Peak, 1000.0f, 0.0f, 1.0f, true);
+    EXPECT_NEAR(GetResponse(flat, SampleRate, 1000.0f), 0.0f, 1e-4f);
+}
@@ -3,6 +3,12 @@
  * @ Description: Unit tests of Buffer class
  */
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include <Audio/Buffer.hpp>
@@ -72,6 +78,119 @@ TEST(Buffer, BufferAllocatorOutOfRange)
     Internal::BufferAllocator::Deallocate(header);
 }
 
+TEST(Buffer, BufferAllocatorMagazineOverflow)
+{
+    constexpr auto Count = Internal::BufferAllocator::MagazineCapacity * 2u;
+    std::array<Internal::AllocationHeader *, Count> headers {};
+
+    Internal::BufferAllocator::Clear();
+
+    for (auto &header : headers)
+        header = Internal::BufferAllocator::Allocate(1, 1, ChannelArrangement::Mono, Format::Fixed8);
+    // Overflowing the thread magazine flushes allocations to the global bucket
+    for (auto &header : headers)
+        Internal::BufferAllocator::Deallocate(header);
+    for (auto i = 0u; i < Count; ++i) {
+        const auto header = Internal::BufferAllocator::Allocate(1, 1, ChannelArrangement::Mono, Format::Fixed8);
+        ASSERT_NE(std::find(headers.begin(), headers.end(), header), headers.end());
+        headers[i] = header;
+    }
+    for (auto &header : headers)
+        Internal::BufferAllocator::Deallocate(header);
+}
+
+TEST(Buffer, BufferAllocatorConcurrentChurn)
+{
+    constexpr auto PairCount = 2u;
+    constexpr auto IterationCount = 10000u;
+    std::size_t capacity = 0u;
+    const auto bucketIndex = Internal::BufferAllocator::GetBucketIndex(16u, capacity);
+    std::vector<std::thread> threads;
+    std::vector<Buffer> handed;
+    std::mutex mutex;
+    std::atomic<std::size_t> freedCount { 0u };
+    std::atomic<bool> churning { true };
+
+    Internal::BufferAllocator::Clear();
+    const auto before = Internal::BufferAllocator::Stats(bucketIndex);
+
+    // Buffers are allocated by producers and released by consumers, moving allocations across thread magazines
+    for (auto i = 0u; i < PairCount; ++i) {
+        threads.emplace_back([&] {
+            for (auto j = 0u; j < IterationCount; ++j) {
+                Buffer buffer(16, 1, ChannelArrangement::Mono, Format::Fixed8);
+                std::lock_guard<std::mutex> lock(mutex);
+                handed.push_back(std::move(buffer));
+            }
+        });
+        threads.emplace_back([&] {
+            while (freedCount < PairCount * IterationCount) {
+                Buffer buffer;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (handed.empty())
+                        continue;
+                    buffer = std::move(handed.back());
+                    handed.pop_back();
+                }
+                ++freedCount;
+            }
+        });
+    }
+    // Trim the global buckets while they are refilled
+    std::thread trimmer([&churning] {
+        while (churning)
+            Internal::BufferAllocator::Trim(4u);
+    });
+    for (auto &thread : threads)
+        thread.join();
+    churning = false;
+    trimmer.join();
+
+    // Exited threads flushed their magazines and published their hits
+    auto stats = Internal::BufferAllocator::Stats(bucketIndex);
+    ASSERT_EQ(stats.hits + stats.fallbacks, before.hits + before.fallbacks + PairCount * IterationCount);
+    ASSERT_EQ(stats.retainedCount, stats.allocatedCount);
+    ASSERT_GE(stats.highWaterCount, 1u);
+    Internal::BufferAllocator::Clear();
+    stats = Internal::BufferAllocator::Stats(bucketIndex);
+    ASSERT_EQ(stats.retainedCount, 0u);
+    ASSERT_EQ(stats.allocatedCount, 0u);
+}
+
+TEST(Buffer, BufferAllocatorReserveStatsTrim)
+{
+    constexpr auto ByteSize = 4096u;
+    std::size_t capacity = 0u;
+    const auto bucketIndex = Internal::BufferAllocator::GetBucketIndex(ByteSize, capacity);
+
+    Internal::BufferAllocator::Clear();
+    ASSERT_EQ(capacity, ByteSize);
+
+    const auto before = Internal::BufferAllocator::Stats(bucketIndex);
+    Internal::BufferAllocator::Reserve(ByteSize, 4u);
+    auto stats = Internal::BufferAllocator::Stats(bucketIndex);
+    ASSERT_EQ(stats.capacity, ByteSize);
+    ASSERT_EQ(stats.retainedCount, 4u);
+    ASSERT_EQ(stats.fallbacks, before.fallbacks + 4u);
+    ASSERT_GE(stats.highWaterCount, 4u);
+
+    // Reserved allocations are served without reaching the system allocator
+    {
+        Buffer buffer(ByteSize, 44100, ChannelArrangement::Mono, Format::Fixed8);
+        stats = Internal::BufferAllocator::Stats(bucketIndex);
+        ASSERT_EQ(stats.fallbacks, before.fallbacks + 4u);
+        ASSERT_EQ(stats.hits, before.hits + 1u);
+    }
+
+    ASSERT_EQ(Internal::BufferAllocator::Trim(1u), 3u * (ByteSize + Core::CacheLineSize));
+    stats = Internal::BufferAllocator::Stats(bucketIndex);
+    ASSERT_EQ(stats.retainedCount, 1u);
+    ASSERT_EQ(stats.allocatedCount, 1u);
+    Internal::BufferAllocator::Clear();
+    ASSERT_EQ(Internal::BufferAllocator::Stats(bucketIndex).allocatedCount, 0u);
+}
+
 
 TEST(Buffer, BufferSmallCopy)
 {
@@ -91,3 +210,82 @@ TEST(Buffer, BufferSmallCopy)
     for (auto i = 0; i < 8; ++i)
         ASSERT_EQ(source.data<char>()[i], 42);
 }
+
+TEST(Buffer, BufferPlanarChannels)
+{
+    Buffer buffer(4 * sizeof(float), 44100, ChannelArrangement::Stereo, Format::Floating32);
+
+    ASSERT_EQ(buffer.channelCount(), 2u);
+    ASSERT_EQ(buffer.channelSampleCount(), 4u);
+    ASSERT_EQ(buffer.data<float>(Channel::Left), buffer.data<float>());
+    ASSERT_EQ(buffer.data<float>(Channel::Right), buffer.data<float>() + 4);
+    ASSERT_EQ(std::as_const(buffer).data<float>(Channel::Right), buffer.data<float>() + 4);
+}
+
+TEST(Buffer, BufferSilentFlag)
+{
+    constexpr auto Size = 100u;
+    Buffer buffer(Size * sizeof(float), 44100, ChannelArrangement::Mono, Format::Floating32);
+
+    ASSERT_FALSE(buffer.isSilent());
+    buffer.clear();
+    ASSERT_TRUE(buffer.isSilent());
+    ASSERT_TRUE(buffer.isZero());
+    // Raw writes are declared by the writer
+    buffer.data<float>()[Size - 1] = 0.25f;
+    buffer.setSilent(false);
+    ASSERT_FALSE(buffer.isZero());
+    ASSERT_FALSE(buffer.isBelowThreshold(0.1f));
+    ASSERT_TRUE(buffer.isBelowThreshold(0.5f));
+    buffer.data<float>()[Size - 1] = 0.0f;
+    ASSERT_TRUE(buffer.isZero());
+    buffer.data<float>()[3] = -0.25f;
+    ASSERT_FALSE(buffer.isZero());
+    ASSERT_FALSE(buffer.isBelowThreshold(0.1f));
+
+    // Copies keep the state, an in-place resize forgets it
+    buffer.clear();
+    Buffer target;
+    target.copy(buffer);
+    ASSERT_TRUE(target.isSilent());
+    target.resize(Size * sizeof(float) / 2u, 44100, ChannelArrangement::Mono, Format::Floating32);
+    ASSERT_FALSE(target.isSilent());
+    ASSERT_TRUE(target.isZero());
+
+    ASSERT_FALSE(buffer.consumeSilenceMark());
+    buffer.markSilent();
+    ASSERT_TRUE(buffer.consumeSilenceMark());
+    ASSERT_FALSE(buffer.consumeSilenceMark());
+}
+
+TEST(Buffer, BufferAllocatorArena)
+{
+    constexpr auto ByteSize = 1024u;
+    std::size_t capacity = 0u;
+    const auto bucketIndex = Internal::BufferAllocator::GetBucketIndex(ByteSize, capacity);
+
+    Internal::BufferAllocator::Clear();
+    const auto backing = Internal::BufferAllocator::InitArena({ Internal::BufferArena::HugePageSize, true, false });
+    ASSERT_NE(backing, Internal::BufferAllocator::ArenaBacking::None);
+    ASSERT_EQ(Internal::BufferAllocator::GetArenaBacking(), backing);
+
+    const auto header = Internal::BufferAllocator::Allocate(ByteSize, 44100, ChannelArrangement::Mono, Format::Fixed8);
+    ASSERT_TRUE(Internal::BufferAllocator::IsArenaAllocation(header));
+    Internal::BufferAllocator::Deallocate(header);
+    // Arena allocations stay pooled
+    ASSERT_EQ(Internal::BufferAllocator::Trim(), 0u);
+    ASSERT_EQ(Internal::BufferAllocator::Stats(bucketIndex).retainedCount, 1u);
+    ASSERT_EQ(Internal::BufferAllocator::Allocate(ByteSize, 44100, ChannelArrangement::Mono, Format::Fixed8), header);
+
+    // The arena can't be unmapped while one of its allocations is owned
+    ASSERT_FALSE(Internal::BufferAllocator::ReleaseArena());
+    ASSERT_EQ(Internal::BufferAllocator::GetArenaBacking(), backing);
+    Internal::BufferAllocator::Deallocate(header);
+    // Reset the arena, the following allocations reach the system again
+    ASSERT_TRUE(Internal::BufferAllocator::ReleaseArena());
+    ASSERT_EQ(Internal::BufferAllocator::GetArenaBacking(), Internal::BufferAllocator::ArenaBacking::None);
+    ASSERT_EQ(Internal::BufferAllocator::Stats(bucketIndex).retainedCount, 0u);
+    const auto systemHeader = Internal::BufferAllocator::Allocate(ByteSize, 44100, ChannelArrangement::Mono, Format::Fixed8);
+    ASSERT_FALSE(Internal::BufferAllocator::IsArenaAllocation(systemHeader));
+    Internal::BufferAllocator::Deallocate(systemHeader);
+}
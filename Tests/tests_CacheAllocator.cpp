@@ -0,0 +1,72 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: Unit tests of the cache allocator
+ */
+
+#include <gtest/gtest.h>
+
+#include <Audio/CacheAllocator.hpp>
+
+using namespace Audio;
+
+static constexpr std::size_t ModelByteSize = 64u * sizeof(float);
+
+TEST(CacheAllocator, OverlappingLifetimes)
+{
+    Node master(nullptr), a(&master), b(&master), c(&master);
+    CacheAllocator allocator;
+    CacheAllocator::Pool pool;
+    const Buffer model(ModelByteSize, 44100, ChannelArrangement::Mono, Format::Floating32);
+
+    // 'a' and 'b' may be produced in parallel, 'c' is produced once both were consumed
+    const auto stepA = allocator.addStep();
+    const auto stepB = allocator.addStep();
+    const auto stepMaster = allocator.addStep();
+    const auto stepC = allocator.addStep();
+    const auto stepEnd = allocator.addStep();
+    allocator.precede(stepA, stepMaster);
+    allocator.precede(stepB, stepMaster);
+    allocator.precede(stepMaster, stepC);
+    allocator.precede(stepC, stepEnd);
+    allocator.addCache(&a, stepA, stepMaster);
+    allocator.addCache(&b, stepB, stepMaster);
+    allocator.addCache(&c, stepC, stepEnd);
+    allocator.addCache(&master, stepMaster, stepEnd);
+
+    ASSERT_EQ(allocator.allocate(pool, model, true), 2u);
+    ASSERT_EQ(pool.size(), 2u);
+    ASSERT_FALSE(master.isCacheShared());
+    ASSERT_TRUE(a.isCacheShared());
+    ASSERT_NE(&a.cache(), &b.cache());
+    ASSERT_TRUE(&c.cache() == &a.cache() || &c.cache() == &b.cache());
+    ASSERT_EQ(a.cache().channelByteSize(), ModelByteSize);
+}
+
+TEST(CacheAllocator, SerialLane)
+{
+    Node master(nullptr), a(&master), b(&master), c(&master);
+    CacheAllocator allocator;
+    CacheAllocator::Pool pool;
+    const Buffer model(ModelByteSize, 44100, ChannelArrangement::Mono, Format::Floating32);
+
+    // Caches only used by their own step, the steps run serially
+    const auto stepA = allocator.addStep();
+    const auto stepB = allocator.addStep();
+    const auto stepC = allocator.addStep();
+    allocator.precede(stepA, stepB);
+    allocator.precede(stepB, stepC);
+    allocator.addCache(&a, stepA);
+    allocator.addCache(&b, stepB);
+    allocator.addCache(&c, stepC);
+
+    ASSERT_EQ(allocator.allocate(pool, model, true), 1u);
+    ASSERT_EQ(&a.cache(), &b.cache());
+    ASSERT_EQ(&b.cache(), &c.cache());
+
+    // Restoring an own cache keeps the specs
+    a.bindCache(nullptr);
+    ASSERT_FALSE(a.isCacheShared());
+    ASSERT_EQ(a.cache().channelByteSize(), ModelByteSize);
+    b.bindCache(nullptr);
+    c.bindCache(nullptr);
+}
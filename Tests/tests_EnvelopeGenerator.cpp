@@ -3,9 +3,12 @@
  * @ Description: Unit tests of Envelope Generator class
  */
 
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include <Audio/DSP/EnvelopeGenerator.hpp>
+#include <Audio/DSP/Dispatch.hpp>
 
 using namespace Audio;
 
@@ -53,3 +56,84 @@ TEST(EnvelopeGenerator, Simple_AttackDecayReleaseSustain)
     }
     UNUSED(env);
 }
+
+/** @brief Render the same note twice, sample per sample and by blocks of odd sizes, the note off falls inside a block */
+template<DSP::EnvelopeType Type>
+static void TestBlockGains(const float attack, const float decay, const float sustain, const float release)
+{
+    constexpr Key Note { 42u };
+    constexpr std::uint32_t NoteOff = 3001u;
+    constexpr std::uint32_t Length = 12000u;
+    DSP::EnvelopeBase<Type> samples;
+    DSP::EnvelopeBase<Type> blocks;
+    std::vector<float> gains(Size);
+
+    for (std::uint32_t index = 0u, block = 0u; index < Length; ++block) {
+        const auto blockSize = std::min<std::uint32_t>(Length - index, 97u + 211u * (block % 5u));
+        if (index <= NoteOff && NoteOff < index + blockSize) {
+            for (auto i = index; i < NoteOff; ++i)
+                UNUSED(samples.getGain(Note, i, 0.0f, attack, 0.0f, decay, sustain, release, SR));
+            samples.setTriggerIndex(Note, NoteOff);
+            blocks.getGains(Note, index, gains.data(), NoteOff - index, 0.0f, attack, 0.0f, decay, sustain, release, SR);
+            blocks.setTriggerIndex(Note, NoteOff);
+            blocks.getGains(Note, NoteOff, gains.data() + NoteOff - index, index + blockSize - NoteOff, 0.0f, attack, 0.0f, decay, sustain, release, SR);
+            for (auto i = NoteOff; i < index + blockSize; ++i)
+                UNUSED(samples.getGain(Note, i, 0.0f, attack, 0.0f, decay, sustain, release, SR));
+            index += blockSize;
+            ASSERT_EQ(blocks.lastGain(Note), samples.lastGain(Note));
+            continue;
+        }
+        blocks.getGains(Note, index, gains.data(), blockSize, 0.0f, attack, 0.0f, decay, sustain, release, SR);
+        for (auto i = 0u; i < blockSize; ++i, ++index)
+            ASSERT_EQ(gains[i], samples.getGain(Note, index, 0.0f, attack, 0.0f, decay, sustain, release, SR));
+        ASSERT_EQ(blocks.lastGain(Note), samples.lastGain(Note));
+    }
+    ASSERT_EQ(blocks.lastGain(Note), 0.0f);
+}
+
+TEST(EnvelopeGenerator, BlockGains_AttackRelease)
+{
+    // Note off during the attack, then after it
+    TestBlockGains<DSP::EnvelopeType::AR>(0.1f, 0.0f, 0.0f, 0.05f);
+    TestBlockGains<DSP::EnvelopeType::AR>(0.01f, 0.0f, 0.0f, 0.05f);
+}
+
+TEST(EnvelopeGenerator, BlockGains_AttackDecay)
+{
+    // Note off during the decay, then once the enveloppe ended
+    TestBlockGains<DSP::EnvelopeType::AD>(0.02f, 0.1f, 0.0f, 0.0f);
+    TestBlockGains<DSP::EnvelopeType::AD>(0.01f, 0.02f, 0.0f, 0.0f);
+}
+
+TEST(EnvelopeGenerator, BlockGains_AttackDecayReleaseSustain)
+{
+    // Note off during the attack, the decay and the sustain
+    TestBlockGains<DSP::EnvelopeType::ADSR>(0.1f, 0.05f, 0.5f, 0.1f);
+    TestBlockGains<DSP::EnvelopeType::ADSR>(0.02f, 0.1f, 0.5f, 0.1f);
+    TestBlockGains<DSP::EnvelopeType::ADSR>(0.01f, 0.02f, 0.7f, 0.1f);
+    TestBlockGains<DSP::EnvelopeType::ADSR>(0.01f, 0.02f, 1.0f, 0.1f);
+}
+
+TEST(EnvelopeGenerator, MultiplyGains)
+{
+    constexpr std::size_t Count = 1003u;
+    std::vector<float> input(Count), gains(Count), output(Count), expected(Count);
+
+    for (auto i = 0u; i < Count; ++i) {
+        input[i] = static_cast<float>(i % 17u) - 8.0f;
+        gains[i] = static_cast<float>(i) / static_cast<float>(Count);
+    }
+    for (const auto set : { DSP::Simd::InstructionSet::Scalar, DSP::Simd::InstructionSet::SSE2, DSP::Simd::InstructionSet::AVX2,
+            DSP::Simd::InstructionSet::AVX512, DSP::Simd::InstructionSet::NEON }) {
+        if (!DSP::Simd::ForceInstructionSet(set))
+            continue;
+        // Unaligned pointers and a tail shorter than any lane count
+        DSP::Simd::Kernels().multiplyGains(input.data() + 1, gains.data() + 1, output.data() + 1, Count - 1u, 0.5f, false);
+        for (auto i = 1u; i < Count; ++i)
+            ASSERT_EQ(output[i], input[i] * gains[i] * 0.5f);
+        DSP::Simd::Kernels().multiplyGains(input.data() + 1, gains.data() + 1, output.data() + 1, Count - 1u, 0.5f, true);
+        for (auto i = 1u; i < Count; ++i)
+            ASSERT_EQ(output[i], input[i] * gains[i] * 0.5f * 2.0f);
+    }
+    DSP::Simd::ResetInstructionSet();
+}
@@ -0,0 +1,197 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: Unit tests of FIR filters
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Audio/DSP/FFT.hpp>
+#include <Audio/DSP/FIR.hpp>
+
+using namespace Audio;
+
+TEST(FFT, RoundTrip)
+{
+    constexpr auto Size = 256u;
+    DSP::RealFFT<float> fft(Size);
+    std::vector<float> input(Size), output(Size), real(fft.binCount()), imag(fft.binCount());
+
+    for (auto i = 0u; i < Size; ++i)
+        input[i] = std::sin(static_cast<float>(i) * 0.37f) + static_cast<float>(i % 5u) * 0.1f;
+    fft.forward(input.data(), real.data(), imag.data());
+    // A pure sum of the samples lands in the first bin
+    float sum = 0.0f;
+    for (const auto sample : input)
+        sum += sample;
+    ASSERT_NEAR(real[0], sum, 1e-3f);
+    ASSERT_EQ(imag[0], 0.0f);
+    fft.inverse(real.data(), imag.data(), output.data());
+    for (auto i = 0u; i < Size; ++i)
+        ASSERT_NEAR(output[i] / static_cast<float>(Size / 2u), input[i], 1e-5f);
+}
+
+TEST(FIR, PartitionedMatchesDirect)
+{
+    constexpr auto FilterSize = 251u;
+    constexpr auto BlockSize = 256u;
+    DSP::FIR::Internal::Instance<float> direct, partitioned;
+    std::vector<float> input(BlockSize), expected(BlockSize), output(BlockSize);
+
+    ASSERT_NE(DSP::FIR::Internal::Instance<float>::GetPartitionSize(FilterSize, BlockSize), 0u);
+    ASSERT_EQ(DSP::FIR::Internal::Instance<float>::GetPartitionSize(FilterSize, 100u), 0u);
+    for (auto *instance : { &direct, &partitioned }) {
+        instance->coefficients().resize(FilterSize);
+        for (auto i = 0u; i < FilterSize; ++i)
+            instance->coefficients()[i] = std::cos(static_cast<float>(i) * 0.05f) / static_cast<float>(FilterSize);
+        instance->onCoefficientsChanged();
+        instance->resizeLastInputs(FilterSize - 1u);
+        for (auto &sample : instance->lastInput())
+            sample = 0.0f;
+    }
+    for (auto block = 0u; block < 8u; ++block) {
+        for (auto i = 0u; i < BlockSize; ++i)
+            input[i] = std::sin(static_cast<float>(block * BlockSize + i) * 0.21f);
+        // Coefficients changes and switches to the direct form must keep both filters in sync
+        if (block == 4u) {
+            for (auto *instance : { &direct, &partitioned }) {
+                for (auto &coefficient : instance->coefficients())
+                    coefficient *= 0.5f;
+                instance->onCoefficientsChanged();
+            }
+        }
+        direct.filterDirect<false>(input.data(), BlockSize, expected.data(), 0.8f);
+        if (block == 2u)
+            partitioned.filterDirect<false>(input.data(), BlockSize, output.data(), 0.8f);
+        else
+            partitioned.filter<false>(input.data(), BlockSize, output.data(), 0.8f);
+        for (auto i = 0u; i < BlockSize; ++i)
+            ASSERT_NEAR(output[i], expected[i], 1e-5f);
+    }
+}
+
+TEST(FIR, DirectEveryInstructionSet)
+{
+    constexpr auto FilterSize = 33u;
+    constexpr std::uint32_t BlockSizes[] { 64u, 7u, 45u, 1u, 128u };
+    std::vector<float> signal, coefficients(FilterSize), expected, output;
+
+    for (auto i = 0u; i < FilterSize; ++i)
+        coefficients[i] = std::sin(static_cast<float>(i + 1u) * 0.3f) / static_cast<float>(FilterSize);
+    for (const auto blockSize : BlockSizes) {
+        for (auto i = 0u; i < blockSize; ++i)
+            signal.push_back(std::cos(static_cast<float>(signal.size()) * 0.17f));
+    }
+    // Reference convolution of the whole signal, blocks shorter than the history must keep it
+    expected.resize(signal.size());
+    for (auto i = 0u; i < signal.size(); ++i) {
+        double sample = 0.0;
+        for (auto k = 0u; k < FilterSize; ++k) {
+            if (i + k >= FilterSize - 1u)
+                sample += static_cast<double>(signal[i + k - (FilterSize - 1u)]) * coefficients[k];
+        }
+        expected[i] = static_cast<float>(sample * 0.5);
+    }
+    output.resize(signal.size());
+    for (const auto set : { DSP::Simd::InstructionSet::Scalar, DSP::Simd::InstructionSet::SSE2, DSP::Simd::InstructionSet::AVX2,
+            DSP::Simd::InstructionSet::AVX512, DSP::Simd::InstructionSet::NEON }) {
+        if (!DSP::Simd::ForceInstructionSet(set))
+            continue;
+        DSP::FIR::Internal::Instance<float> instance;
+        instance.coefficients().resize(FilterSize);
+        std::copy(coefficients.begin(), coefficients.end(), instance.coefficients().begin());
+        instance.resizeLastInputs(FilterSize - 1u);
+        for (auto &sample : instance.lastInput())
+            sample = 0.0f;
+        auto offset = 0u;
+        for (const auto blockSize : BlockSizes) {
+            instance.filterDirect<false>(signal.data() + offset, blockSize, output.data() + offset, 0.5f);
+            offset += blockSize;
+        }
+        for (auto i = 0u; i < signal.size(); ++i)
+            ASSERT_NEAR(output[i], expected[i], 1e-6f);
+    }
+    DSP::Simd::ResetInstructionSet();
+}
+
+TEST(FIR, BandFilterFoldsGains)
+{
+    constexpr auto BlockSize = 512u;
+    DSP::FIR::BandFilter<10u, float> unit, half;
+    std::vector<float> input(BlockSize), expected(BlockSize), output(BlockSize);
+    float unitGains[10], halfGains[10];
+
+    for (auto i = 0u; i < 10u; ++i) {
+        unitGains[i] = 1.0f;
+        halfGains[i] = 0.5f;
+    }
+    unit.init(DSP::Filter::WindowType::Hanning, 44100.0f, 123u);
+    half.init(DSP::Filter::WindowType::Hanning, 44100.0f, 123u);
+    for (auto block = 0u; block < 4u; ++block) {
+        for (auto i = 0u; i < BlockSize; ++i)
+            input[i] = std::sin(static_cast<float>(block * BlockSize + i) * 0.05f);
+        unit.filter(input.data(), BlockSize, expected.data(), unitGains);
+        half.filter(input.data(), BlockSize, output.data(), halfGains);
+        // The first block crossfades from the unit gains, then the folded kernel is exactly scaled
+        for (auto i = 0u; i < BlockSize; ++i) {
+            if (block)
+                ASSERT_NEAR(output[i], expected[i] * 0.5f, 1e-4f);
+            else
+                ASSERT_NEAR(output[i], expected[i] * (1.0f - 0.5f * static_cast<float>(i + 1u) / BlockSize), 1e-4f);
+        }
+    }
+}
+
+TEST(FIR, BackgroundDesign)
+{
+    constexpr auto BlockSize = 256u;
+    const DSP::Filter::FIRSpecs from(DSP::Filter::BasicType::LowPass, DSP::Filter::WindowType::Hanning, 64u, 44100.0f, 1000.0f, 0.0f, 1.0f);
+    const DSP::Filter::FIRSpecs to(DSP::Filter::BasicType::LowPass, DSP::Filter::WindowType::Hanning, 64u, 44100.0f, 4000.0f, 0.0f, 1.0f);
+    DSP::FIR::BasicFilter<float> filter(from);
+    std::vector<float> input(BlockSize, 1.0f), output(BlockSize), expected(from.filterSize);
+
+    // Unchanged specs never request a design
+    ASSERT_FALSE(filter.setSpecs(from));
+    ASSERT_TRUE(filter.setSpecs(to));
+    ASSERT_TRUE(filter.isDesignPending());
+    filter.filter(input.data(), BlockSize, output.data());
+    DSP::Filter::Designer::Flush();
+    filter.filter(input.data(), BlockSize, output.data());
+    ASSERT_FALSE(filter.isDesignPending());
+    DSP::Filter::GenerateFilter<true>(to, expected.data());
+    for (auto i = 0u; i < to.filterSize; ++i)
+        ASSERT_EQ(filter.coefficients()[i], expected[i]);
+    // Both designs are cached
+    ASSERT_GE(DSP::Filter::Designer::CachedCount(), 2u);
+}
+
+TEST(FIR, BackgroundOrderChange)
+{
+    constexpr auto BlockSize = 256u;
+    const DSP::Filter::FIRSpecs from(DSP::Filter::BasicType::LowPass, DSP::Filter::WindowType::Hanning, 64u, 44100.0f, 1000.0f, 0.0f, 1.0f);
+    const DSP::Filter::FIRSpecs to(DSP::Filter::BasicType::LowPass, DSP::Filter::WindowType::Hanning, 256u, 44100.0f, 1000.0f, 0.0f, 1.0f);
+    DSP::FIR::BasicFilter<float> filter(from);
+    std::vector<float> input(BlockSize, 1.0f), output(BlockSize), expected(to.filterSize);
+
+    // A constant input settles to the DC gain of the kernel
+    for (auto i = 0u; i < 4u; ++i)
+        filter.filter(input.data(), BlockSize, output.data());
+    const auto settled = output.back();
+    ASSERT_TRUE(filter.setSpecs(to));
+    filter.filter(input.data(), BlockSize, output.data());
+    DSP::Filter::Designer::Flush();
+    filter.filter(input.data(), BlockSize, output.data());
+    ASSERT_FALSE(filter.isDesignPending());
+    ASSERT_EQ(filter.coefficients().size(), to.filterSize);
+    // The longer kernel is crossfaded in from the previous one instead of starting from a silent history
+    ASSERT_NEAR(output[0], settled, 1e-2f);
+    for (auto i = 0u; i < 2u; ++i)
+        filter.filter(input.data(), BlockSize, output.data());
+    DSP::Filter::GenerateFilter<true>(to, expected.data());
+    float gain = 0.0f;
+    for (const auto coefficient : expected)
+        gain += coefficient;
+    ASSERT_NEAR(output.back(), gain, 1e-4f);
+}
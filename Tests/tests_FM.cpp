@@ -0,0 +1,70 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: Unit tests of the FM operators
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include <Audio/DSP/FM.hpp>
+
+using namespace Audio;
+
+TEST(FM, ModulatedSine)
+{
+    constexpr std::size_t Count = 1001u;
+    constexpr double Phase = 1234.567;
+    constexpr double Increment = 0.0137;
+    constexpr float Scale = 0.5f;
+    std::vector<float> modulation(Count), gains(Count), output(Count);
+
+    for (auto i = 0u; i < Count; ++i) {
+        modulation[i] = std::sin(static_cast<float>(i) * 0.05f) * 3.0f;
+        gains[i] = static_cast<float>(i) / static_cast<float>(Count);
+    }
+    for (const auto set : { DSP::Simd::InstructionSet::Scalar, DSP::Simd::InstructionSet::SSE2, DSP::Simd::InstructionSet::AVX2,
+            DSP::Simd::InstructionSet::AVX512, DSP::Simd::InstructionSet::NEON }) {
+        if (!DSP::Simd::ForceInstructionSet(set))
+            continue;
+        // -100 dB of a full scale sine
+        DSP::Simd::Kernels().modulatedSine(output.data(), nullptr, nullptr, 0.0f, Phase, Increment, Count, false);
+        for (auto i = 0u; i < Count; ++i)
+            ASSERT_NEAR(output[i], std::sin(2.0 * M_PI * (Phase + static_cast<double>(i) * Increment)), 1e-5);
+        DSP::Simd::Kernels().modulatedSine(output.data(), gains.data(), modulation.data(), Scale, Phase, Increment, Count, true);
+        for (auto i = 0u; i < Count; ++i) {
+            const auto phase = 2.0 * M_PI * (Phase + static_cast<double>(i) * Increment);
+            const auto expected = std::sin(phase) + gains[i] * std::sin(phase + M_PI * static_cast<double>(modulation[i]));
+            ASSERT_NEAR(output[i], expected, 2e-5);
+        }
+    }
+    DSP::Simd::ResetInstructionSet();
+}
+
+TEST(FM, FeedbackOperator)
+{
+    constexpr SampleRate Rate = 48000u;
+    constexpr Key Note { 69u };
+    constexpr float Frequency = 440.0f;
+    constexpr std::uint32_t BlockSize = 256u;
+    const DSP::FM::Internal::Operator op { 1.0f, 0.01f, 0.02f, 0.5f, 0.01f, 1.0f, 0, 3u };
+    DSP::FM::Schema<2u> schema;
+    DSP::EnvelopeBase<DSP::EnvelopeType::ADSR, 2u> envelope;
+    std::vector<float> output(BlockSize);
+
+    schema.setSampleRate(Rate);
+    schema.prepareOperators({ op, op });
+    for (std::uint32_t index = 0u; index < 8u * BlockSize; index += BlockSize) {
+        schema.process<false>(output.data(), BlockSize, 1.0f, index, Note, Frequency);
+        for (auto i = 0u; i < BlockSize; ++i) {
+            // Each feedback step is one more sine of the operator, modulated by the previous one
+            const auto phase = 2.0 * M_PI * static_cast<double>(index + i) * static_cast<double>(Frequency) / static_cast<double>(Rate);
+            auto expected = std::sin(phase);
+            for (auto step = 0u; step < op.feedback; ++step)
+                expected = std::sin(phase + expected);
+            expected *= envelope.getGain<0u>(Note, index + i, 0.0f, op.attack, 0.0f, op.decay, op.sustain, op.release, Rate);
+            ASSERT_NEAR(output[i], expected, 1e-4);
+        }
+    }
+}
@@ -68,6 +68,98 @@ TEST(MergeVariadic, float)
         );
     }
 }
+
+TEST(Merge, SilentInputs)
+{
+    constexpr auto Size = 16u;
+    Buffer silent(Size * sizeof(float), 44100, ChannelArrangement::Mono, Format::Floating32);
+    Buffer loud(Size * sizeof(float), 44100, ChannelArrangement::Mono, Format::Floating32);
+    Buffer output(Size * sizeof(float), 44100, ChannelArrangement::Mono, Format::Floating32);
+
+    silent.clear();
+    for (auto i = 0u; i < Size; ++i)
+        loud.data<float>()[i] = static_cast<float>(i);
+    loud.setSilent(false);
+
+    BufferViews inputs;
+    inputs.push(silent);
+    inputs.push(silent);
+    output.setSilent(false);
+    DSP::Merge<float>(inputs, output, 1.0f);
+    ASSERT_TRUE(output.isSilent());
+    ASSERT_TRUE(output.isZero());
+
+    inputs.push(loud);
+    DSP::Merge<float>(inputs, output, 0.5f);
+    ASSERT_FALSE(output.isSilent());
+    for (auto i = 0u; i < Size; ++i)
+        ASSERT_EQ(output.data<float>()[i], static_cast<float>(i) * 0.5f);
+
+    DSP::Merge<float>(silent, output, 1.0f);
+    ASSERT_TRUE(output.isSilent());
+    ASSERT_TRUE(output.isZero());
+}
+
+TEST(Merge, ManyInputsAcrossTiles)
+{
+    // More inputs than a kernel group and more samples than a tile, with a tail
+    constexpr auto Size = 1500u;
+    constexpr auto InputCount = 9u;
+    std::vector<Buffer> buffers;
+    Buffer output(Size * sizeof(float), 44100, ChannelArrangement::Mono, Format::Floating32);
+    BufferViews inputs;
+
+    for (auto k = 0u; k < InputCount; ++k) {
+        auto &buffer = buffers.emplace_back(Size * sizeof(float), 44100, ChannelArrangement::Mono, Format::Floating32);
+        for (auto i = 0u; i < Size; ++i)
+            buffer.data<float>()[i] = static_cast<float>(i % 7u + k);
+        buffer.setSilent(k == 4u);
+    }
+    for (auto &buffer : buffers)
+        inputs.push(buffer);
+    DSP::Merge<float>(inputs, output, 0.25f);
+    for (auto i = 0u; i < Size; ++i) {
+        float expected = 0.0f;
+        for (auto k = 0u; k < InputCount; ++k) {
+            if (k != 4u)
+                expected += static_cast<float>(i % 7u + k);
+        }
+        ASSERT_EQ(output.data<float>()[i], expected * 0.25f);
+    }
+}
+
+TEST(Merge, EveryInstructionSet)
+{
+    constexpr auto Size = 1027u;
+    constexpr auto InputCount = 6u;
+    std::vector<Buffer> buffers;
+    Buffer expected(Size * sizeof(float), 44100, ChannelArrangement::Mono, Format::Floating32);
+    Buffer output(Size * sizeof(float), 44100, ChannelArrangement::Mono, Format::Floating32);
+    BufferViews inputs;
+
+    for (auto k = 0u; k < InputCount; ++k) {
+        auto &buffer = buffers.emplace_back(Size * sizeof(float), 44100, ChannelArrangement::Mono, Format::Floating32);
+        for (auto i = 0u; i < Size; ++i)
+            buffer.data<float>()[i] = static_cast<float>(i % 13u) - static_cast<float>(k);
+    }
+    for (auto &buffer : buffers)
+        inputs.push(buffer);
+    ASSERT_TRUE(DSP::Simd::ForceInstructionSet(DSP::Simd::InstructionSet::Scalar));
+    DSP::Merge<float>(inputs, expected, 0.5f);
+    // Every kernel supported by the host must produce the scalar result
+    for (const auto set : { DSP::Simd::InstructionSet::SSE2, DSP::Simd::InstructionSet::AVX2,
+            DSP::Simd::InstructionSet::AVX512, DSP::Simd::InstructionSet::NEON }) {
+        if (!DSP::Simd::ForceInstructionSet(set))
+            continue;
+        ASSERT_EQ(DSP::Simd::Kernels().instructionSet, set);
+        DSP::Merge<float>(inputs, output, 0.5f);
+        for (auto i = 0u; i < Size; ++i)
+            ASSERT_EQ(output.data<float>()[i], expected.data<float>()[i]);
+    }
+    DSP::Simd::ResetInstructionSet();
+    ASSERT_TRUE(DSP::Simd::IsSupported(DSP::Simd::Kernels().instructionSet));
+}
+
 /*
     using Tuple = std::tuple<float *, float>;
 
@@ -0,0 +1,134 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: Unit tests of the preview cache
+ */
+
+#include <gtest/gtest.h>
+
+#include <Audio/PreviewCache.hpp>
+
+using namespace Audio;
+
+static constexpr std::size_t BlockCount = 8u;
+
+static Buffer MakeBlock(const float value)
+{
+    constexpr std::size_t BlockSize = 64u;
+
+    Buffer buffer(BlockSize * sizeof(float), 44100, ChannelArrangement::Mono, Format::Floating32);
+    for (auto i = 0u; i < BlockSize; ++i)
+        buffer.data<float>()[i] = value;
+    return buffer;
+}
+
+TEST(PreviewCache, RecordAndReplay)
+{
+    PreviewCache cache;
+    Buffer output = MakeBlock(0.0f);
+
+    ASSERT_FALSE(cache.begin(42u, 100u, true, output, BlockCount));
+    ASSERT_EQ(cache.state(), PreviewCache::State::Record);
+    for (auto i = 0u; i < 4u; ++i) {
+        Buffer block = MakeBlock(static_cast<float>(i + 1));
+        cache.record(block, BeatRange { i * 10u, (i + 1u) * 10u });
+    }
+    cache.complete();
+    ASSERT_EQ(cache.state(), PreviewCache::State::Idle);
+    ASSERT_EQ(cache.size(), 1u);
+
+    ASSERT_TRUE(cache.begin(42u, 100u, true, output, BlockCount));
+    ASSERT_EQ(cache.state(), PreviewCache::State::Replay);
+    for (auto i = 0u; i < 4u; ++i) {
+        ASSERT_TRUE(cache.replay(output));
+        ASSERT_EQ(output.data<float>()[0], static_cast<float>(i + 1));
+    }
+    // Exhausted without a silent tail, the rendering must resume
+    ASSERT_FALSE(cache.replay(output));
+}
+
+TEST(PreviewCache, SilentTail)
+{
+    PreviewCache cache;
+    Buffer output = MakeBlock(1.0f);
+    Buffer block = MakeBlock(1.0f);
+    Buffer silent = MakeBlock(0.0f);
+
+    ASSERT_FALSE(cache.begin(1u, 10u, true, block, BlockCount));
+    cache.record(block, BeatRange { 0u, 10u });
+    // Silent blocks before the tail beat don't complete the recording
+    cache.record(silent, BeatRange { 5u, 15u });
+    ASSERT_EQ(cache.state(), PreviewCache::State::Record);
+    cache.record(silent, BeatRange { 10u, 20u });
+    ASSERT_EQ(cache.state(), PreviewCache::State::Idle);
+
+    ASSERT_TRUE(cache.begin(1u, 10u, true, block, BlockCount));
+    for (auto i = 0u; i < 3u; ++i)
+        ASSERT_TRUE(cache.replay(output));
+    ASSERT_TRUE(cache.replay(output));
+    ASSERT_TRUE(output.isZero());
+}
+
+TEST(PreviewCache, IncompleteRecordingIsDiscarded)
+{
+    PreviewCache cache;
+    Buffer block = MakeBlock(1.0f);
+
+    ASSERT_FALSE(cache.begin(7u, 100u, true, block, BlockCount));
+    cache.record(block, BeatRange { 0u, 10u });
+    cache.stop();
+    ASSERT_EQ(cache.size(), 0u);
+    ASSERT_FALSE(cache.begin(7u, 100u, false, block, BlockCount));
+    ASSERT_EQ(cache.state(), PreviewCache::State::Idle);
+}
+
+TEST(PreviewCache, LeastRecentlyUsedEviction)
+{
+    PreviewCache cache;
+    Buffer block = MakeBlock(1.0f);
+
+    cache.setCapacity(2u);
+    for (auto hash = 1u; hash <= 2u; ++hash) {
+        ASSERT_FALSE(cache.begin(hash, 0u, true, block, BlockCount));
+        cache.record(block, BeatRange { 0u, 10u });
+        cache.complete();
+    }
+    // Use the first preview so the second one becomes the least recently used
+    ASSERT_TRUE(cache.begin(1u, 0u, true, block, BlockCount));
+    cache.stop();
+    ASSERT_FALSE(cache.begin(3u, 0u, true, block, BlockCount));
+    cache.record(block, BeatRange { 0u, 10u });
+    cache.complete();
+    ASSERT_EQ(cache.size(), 2u);
+    ASSERT_TRUE(cache.begin(1u, 0u, true, block, BlockCount));
+    ASSERT_TRUE(cache.begin(3u, 0u, true, block, BlockCount));
+    ASSERT_FALSE(cache.begin(2u, 0u, false, block, BlockCount));
+}
+
+TEST(PreviewCache, MaxEntryByteSize)
+{
+    PreviewCache cache;
+    Buffer block = MakeBlock(1.0f);
+
+    cache.setMaxEntryByteSize(block.size<std::uint8_t>());
+    ASSERT_FALSE(cache.begin(1u, 100u, true, block, BlockCount));
+    cache.record(block, BeatRange { 0u, 10u });
+    ASSERT_EQ(cache.state(), PreviewCache::State::Record);
+    cache.record(block, BeatRange { 10u, 20u });
+    ASSERT_EQ(cache.state(), PreviewCache::State::Idle);
+    ASSERT_EQ(cache.size(), 0u);
+}
+
+TEST(PreviewCache, ReservedBlocks)
+{
+    PreviewCache cache;
+    Buffer block = MakeBlock(1.0f);
+
+    ASSERT_FALSE(cache.begin(1u, 100u, true, block, 2u));
+    cache.record(block, BeatRange { 0u, 10u });
+    cache.record(block, BeatRange { 10u, 20u });
+    ASSERT_EQ(cache.state(), PreviewCache::State::Record);
+    // The preview doesn't fit in the reserved blocks, it isn't cached
+    cache.record(block, BeatRange { 20u, 30u });
+    ASSERT_EQ(cache.state(), PreviewCache::State::Idle);
+    ASSERT_EQ(cache.size(), 0u);
+}
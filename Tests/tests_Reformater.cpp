@@ -96,3 +96,24 @@ TEST(Reformater, FromFloatingBounds)
     Reformater::Reformat<F64, S8>(&f64in, &s8out, 1u);
     ASSERT_EQ(s8out, 0);
 }
+
+TEST(Reformater, InterleaveRoundTrip)
+{
+    constexpr std::size_t FrameCount = 8u;
+    F32 planar[FrameCount * 2u];
+    F32 interleaved[FrameCount * 2u];
+    F32 result[FrameCount * 2u];
+
+    for (auto i = 0u; i < FrameCount; ++i) {
+        planar[i] = static_cast<F32>(i);
+        planar[FrameCount + i] = -static_cast<F32>(i);
+    }
+    Reformater::Interleave(planar, interleaved, FrameCount, 2u, FrameCount);
+    for (auto i = 0u; i < FrameCount; ++i) {
+        ASSERT_EQ(interleaved[i * 2u], static_cast<F32>(i));
+        ASSERT_EQ(interleaved[i * 2u + 1u], -static_cast<F32>(i));
+    }
+    Reformater::Deinterleave(interleaved, result, FrameCount, 2u, FrameCount);
+    for (auto i = 0u; i < FrameCount * 2u; ++i)
+        ASSERT_EQ(result[i], planar[i]);
+}
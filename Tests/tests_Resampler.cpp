@@ -3,9 +3,12 @@
  * @ Description: Unit tests of Resampling
  */
 
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include <Audio/DSP/Resampler.hpp>
+#include <Audio/DSP/SincResampler.hpp>
 
 using namespace Audio;
 
@@ -44,6 +47,119 @@ TEST(Resampler, SizesHelper)
 }
 
 
+/** @brief Reference resampling: zero stuffing, full prototype filtering then decimation */
+static std::vector<Type> NaiveResample(const std::vector<Type> &input, const std::uint32_t interpolation, const std::uint32_t decimation, const std::uint32_t processSize)
+{
+    const auto factor = std::max(interpolation, decimation);
+    const DSP::Filter::FIRSpecs specs(DSP::Filter::BasicType::LowPass, DSP::Filter::WindowType::Hanning,
+        factor * processSize, 48000.0f, 48000.0f / 2.0f / static_cast<float>(factor), 0.0f, 1.0f);
+    std::vector<float> filter(specs.filterSize);
+    std::vector<Type> output((input.size() * interpolation) / decimation);
+
+    DSP::Filter::GenerateFilter(specs, filter.data());
+    for (auto m = 0u; m < output.size(); ++m) {
+        const auto n = m * decimation;
+        double sample = 0.0;
+        for (auto t = 0u; t < specs.filterSize && t <= n; ++t) {
+            if ((n - t) % interpolation == 0u)
+                sample += static_cast<double>(input[(n - t) / interpolation]) * filter[t];
+        }
+        output[m] = static_cast<Type>(sample * interpolation);
+    }
+    return output;
+}
+
+TEST(Resampler, PolyphaseMatchesReference)
+{
+    constexpr auto InputSize = 400u;
+    std::vector<Type> input(InputSize);
+    Rs resampler;
+
+    for (auto i = 0u; i < InputSize; ++i)
+        input[i] = std::sin(static_cast<float>(i) * 0.05f) + 0.25f * std::sin(static_cast<float>(i) * 0.9f);
+    for (const auto upScale : { false, true }) {
+        const auto expected = upScale ?
+            NaiveResample(input, Rs::InterpolationSemitoneFactor, Rs::DecimationSemitoneFactor, 8u) :
+            NaiveResample(input, Rs::DecimationSemitoneFactor, Rs::InterpolationSemitoneFactor, 8u);
+        std::vector<Type> output(Rs::GetResampleSemitoneBufferSize(InputSize, upScale));
+        ASSERT_EQ(output.size(), expected.size());
+        resampler.resampleSemitone<false, 8u>(input.data(), output.data(), InputSize, 48000, upScale);
+        for (auto i = 0u; i < output.size(); ++i)
+            ASSERT_NEAR(output[i], expected[i], 1e-4f);
+    }
+    for (const auto nOctave : { -2, -1, 1, 2 }) {
+        const auto factor = 1u << std::abs(nOctave);
+        const auto expected = NaiveResample(input, nOctave < 0 ? factor : 1u, nOctave < 0 ? 1u : factor, 8u);
+        std::vector<Type> output(Rs::GetResampleOctaveBufferSize(InputSize, nOctave));
+        ASSERT_EQ(output.size(), expected.size());
+        resampler.resampleOctave<false, 8u>(input.data(), output.data(), InputSize, 48000, nOctave);
+        for (auto i = 0u; i < output.size(); ++i)
+            ASSERT_NEAR(output[i], expected[i], 1e-4f);
+    }
+}
+
+TEST(Resampler, SharedFilterBanks)
+{
+    const auto bank = Rs::GetFilterBank(Rs::InterpolationSemitoneFactor, Rs::DecimationSemitoneFactor, 8u);
+
+    ASSERT_EQ(bank, Rs::GetFilterBank(Rs::InterpolationSemitoneFactor, Rs::DecimationSemitoneFactor, 8u));
+    ASSERT_NE(bank, Rs::GetFilterBank(Rs::DecimationSemitoneFactor, Rs::InterpolationSemitoneFactor, 8u));
+    ASSERT_EQ(bank->phaseSize, 9u);
+    ASSERT_EQ(bank->coefficients.size(), Rs::InterpolationSemitoneFactor * bank->phaseSize);
+}
+
+TEST(SincResampler, UnitRatio)
+{
+    constexpr auto Size = 64u;
+    std::vector<Type> input(Size), output(Size);
+    DSP::SincResampler<Type> resampler(DSP::SincResampler<Type>::Quality::High);
+
+    for (auto i = 0u; i < Size; ++i)
+        input[i] = static_cast<Type>(i % 7u) - 3.0f;
+    // The kernel crosses zero on every other sample
+    ASSERT_EQ(resampler.process<false>(input.data(), Size, output.data(), Size, 1.0), Size);
+    for (auto i = 0u; i < Size; ++i)
+        ASSERT_NEAR(output[i], input[i], 1e-5f);
+    ASSERT_EQ(resampler.process<false>(input.data(), Size, output.data(), Size, 1.0), 0u);
+}
+
+TEST(SincResampler, FractionalRatio)
+{
+    constexpr auto Size = 2048u;
+    constexpr auto Ratio = 0.7937005259840998; // 4 semitones down
+    constexpr auto Frequency = 0.02;
+    std::vector<Type> input(Size), output(Size * 2u);
+    DSP::SincResampler<Type> resampler(DSP::SincResampler<Type>::Quality::High);
+
+    for (auto i = 0u; i < Size; ++i)
+        input[i] = static_cast<Type>(std::sin(2.0 * M_PI * Frequency * i));
+    const auto count = resampler.process<false>(input.data(), Size, output.data(), static_cast<std::uint32_t>(output.size()), Ratio);
+    ASSERT_EQ(count, static_cast<std::uint32_t>(std::ceil(Size / Ratio)));
+    // Far from the source edges the output follows the sine at its fractional positions
+    for (auto i = 64u; i < count - 64u; ++i)
+        ASSERT_NEAR(output[i], std::sin(2.0 * M_PI * Frequency * i * Ratio), 1e-3);
+}
+
+TEST(SincResampler, StreamingBlocks)
+{
+    constexpr auto Size = 1000u;
+    constexpr auto BlockSize = 37u;
+    std::vector<Type> input(Size), expected(Size), output(Size);
+    DSP::SincResampler<Type> whole, blocks;
+
+    for (auto i = 0u; i < Size; ++i)
+        input[i] = std::sin(static_cast<float>(i) * 0.1f) * std::cos(static_cast<float>(i) * 0.013f);
+    const auto count = whole.process<false>(input.data(), Size, expected.data(), Size, 1.37);
+    auto produced = 0u;
+    while (produced < count)
+        produced += blocks.process<false>(input.data(), Size, output.data() + produced, std::min(BlockSize, Size - produced), 1.37);
+    ASSERT_EQ(produced, count);
+    for (auto i = 0u; i < count; ++i)
+        ASSERT_EQ(output[i], expected[i]);
+    ASSERT_EQ(DSP::SincResampler<Type>::GetSincTable(16u), DSP::SincResampler<Type>::GetSincTable(16u));
+    ASSERT_EQ(whole.tapCount(), DSP::SincResampler<Type>::GetTapCount(DSP::SincResampler<Type>::Quality::Medium));
+}
+
 // TEST(Resampler, DefaultOctave)
 // {
 //     Buffer buf(Size * sizeof(T), 48000, ChannelArrangement::Mono);
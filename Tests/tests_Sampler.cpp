@@ -4,6 +4,8 @@
  */
 
 #include <gtest/gtest.h>
+#include <cmath>
+#include <filesystem>
 #include <iostream>
 
 #include <Audio/Plugins/Sampler.hpp>
@@ -54,3 +56,77 @@ TEST(Sampler, MetaData)
     ASSERT_EQ(pMeta.controls.size(), Sampler::ControlCount);
 
 }
+
+TEST(Sampler, SharedOctaveCopyOnWrite)
+{
+    SharedOctave octave = std::make_shared<BufferOctave>();
+    auto &root = const_cast<BufferOctave &>(*octave)[OctaveRootKey];
+    root = Buffer(4 * sizeof(float), 44100, ChannelArrangement::Mono, Format::Floating32);
+    root.data<float>()[0] = 42.0f;
+
+    // A shared octave is copied before being written
+    SharedOctave other = octave;
+    auto &unique = SampleStore::MakeUnique(other);
+    ASSERT_NE(other.get(), octave.get());
+    ASSERT_EQ(unique[OctaveRootKey].data<float>()[0], 42.0f);
+    unique[OctaveRootKey].data<float>()[0] = 24.0f;
+    ASSERT_EQ((*octave)[OctaveRootKey].data<float>()[0], 42.0f);
+
+    // A single user writes in place
+    const auto *address = other.get();
+    ASSERT_EQ(&SampleStore::MakeUnique(other), address);
+}
+
+/** @brief Write a short mono sample file in the temporary directory */
+static std::string WriteTestSample(const char * const name)
+{
+    constexpr std::size_t SampleCount = 4096u;
+    const auto path = (std::filesystem::temp_directory_path() / name).string();
+    Buffer sample(SampleCount * sizeof(float), 44100, ChannelArrangement::Mono, Format::Floating32);
+
+    for (auto i = 0u; i < SampleCount; ++i)
+        sample.data<float>()[i] = std::sin(static_cast<float>(i) * 0.05f) * 0.5f;
+    if (!SampleManager<float>::WriteSampleFile(path, sample))
+        return std::string();
+    return path;
+}
+
+TEST(Sampler, SampleStoreShare)
+{
+    const auto path = WriteTestSample("tests_Sampler_SampleStoreShare.wav");
+    const SampleSpecs mono { 44100, ChannelArrangement::Mono, Format::Floating32, 0u };
+    const SampleSpecs stereo { 44100, ChannelArrangement::Stereo, Format::Floating32, 0u };
+    const auto count = SampleStore::Count();
+    const auto sourceCount = SampleStore::CountSources();
+
+    ASSERT_FALSE(path.empty());
+    {
+        // The same file with the same specs is loaded once
+        auto first = SampleStore::Acquire<float>(path, mono);
+        auto second = SampleStore::Acquire<float>(path, mono);
+        ASSERT_TRUE(first);
+        ASSERT_EQ(first.get(), second.get());
+        ASSERT_EQ(SampleStore::Count(), count + 1u);
+
+        // Other specs get their own octave
+        auto other = SampleStore::Acquire<float>(path, stereo);
+        ASSERT_NE(other.get(), first.get());
+        ASSERT_EQ((*other)[OctaveRootKey].channelCount(), 2u);
+        ASSERT_EQ((*other)[OctaveRootKey].channelSampleCount(), (*first)[OctaveRootKey].channelSampleCount());
+        ASSERT_EQ(SampleStore::Count(), count + 2u);
+        // Both octaves are generated from a single decoded file
+        ASSERT_EQ(SampleStore::CountSources(), sourceCount + 1u);
+
+        // An octave stays in the store while any user holds it
+        first.reset();
+        ASSERT_EQ(SampleStore::Count(), count + 2u);
+        ASSERT_EQ(SampleStore::Acquire<float>(path, mono).get(), second.get());
+        second.reset();
+        ASSERT_EQ(SampleStore::Count(), count + 1u);
+        ASSERT_EQ(SampleStore::CountSources(), sourceCount + 1u);
+    }
+    // The last user released every octave along with the decoded file
+    ASSERT_EQ(SampleStore::CountSources(), sourceCount);
+    ASSERT_EQ(SampleStore::Count(), count);
+    std::filesystem::remove(path);
+}
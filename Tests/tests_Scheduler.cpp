@@ -0,0 +1,169 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: Unit tests of the scheduler rendering
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Audio/AScheduler.hpp>
+#include <Audio/PluginTable.hpp>
+
+using namespace Audio;
+
+static constexpr SampleRate TestSampleRate = 48000u;
+static constexpr BlockSize TestBlockSize = 1024u;
+
+/** @brief Scheduler rendering until it is paused */
+class TestScheduler final : public AScheduler
+{
+public:
+    TestScheduler(ProjectPtr &&project) : AScheduler(std::move(project)) {}
+
+    ~TestScheduler(void) override = default;
+
+    [[nodiscard]] std::size_t generatedBlocks(void) const noexcept { return _generatedBlocks.load(); }
+
+    bool onAudioBlockGenerated(void) override
+    {
+        ++_generatedBlocks;
+        return dispatchEvents();
+    }
+
+    bool onAudioQueueBusy(void) override { return dispatchEvents(); }
+
+    /** @brief Render from the first beat, reading 'blockCount' blocks
+     *  'onPlay' is called once the rendering started, before any block is read */
+    template<typename OnPlay>
+    [[nodiscard]] std::vector<float> render(const std::size_t blockCount, OnPlay &&onPlay)
+    {
+        std::vector<float> output(blockCount * TestBlockSize);
+
+        _generatedBlocks = 0u;
+        currentBeatRange<PlaybackMode::Production>() = { 0u, processBeatSize() };
+        setState(State::Play);
+        onPlay();
+        for (auto i = 0u; i < blockCount; ++i)
+            read(output.data() + i * TestBlockSize);
+        setState(State::Pause);
+        wait();
+        return output;
+    }
+
+    /** @brief Read a single block from the audio queue, waiting until it is available */
+    void read(float * const block)
+    {
+        while (!consumeAudioData(reinterpret_cast<std::uint8_t *>(block), TestBlockSize * sizeof(float)))
+            std::this_thread::yield();
+    }
+
+    /** @brief Edit the project from 'editBeat' while it is rendered, the edit is applied between two blocks */
+    template<typename Apply>
+    void edit(const Beat editBeat, Apply &&apply)
+    {
+        std::lock_guard<std::mutex> lock(_eventMutex);
+        addEditEvent(editBeat, std::forward<Apply>(apply));
+    }
+
+    /** @brief Wait until 'count' blocks were generated since play */
+    void waitGeneratedBlocks(const std::size_t count) const noexcept
+    {
+        while (generatedBlocks() < count)
+            std::this_thread::yield();
+    }
+
+private:
+    std::atomic<std::size_t> _generatedBlocks { 0u };
+    std::mutex _eventMutex {};
+
+    bool dispatchEvents(void)
+    {
+        std::lock_guard<std::mutex> lock(_eventMutex);
+
+        dispatchApplyEvents();
+        dispatchNotifyEvents();
+        if (state() == State::Play)
+            return false;
+        graphExited();
+        return true;
+    }
+};
+
+/** @brief Create a project whose master mixes an oscillator node at the end of a chain of 'mixerCount' mixers */
+static ProjectPtr MakeProject(const std::size_t mixerCount, Partition &&partition, const BeatRange &instance)
+{
+    auto project = std::make_shared<Project>(Core::FlatString("project"));
+    auto &table = PluginTable::Get();
+    Node *parent;
+
+    project->master() = std::make_unique<Node>(nullptr, table.instantiate("__internal__:/Mixer"));
+    parent = project->master().get();
+    for (auto i = 0u; i < mixerCount; ++i)
+        parent = parent->children().push(std::make_unique<Node>(parent, table.instantiate("__internal__:/Mixer"))).get();
+    auto &oscillator = parent->children().push(std::make_unique<Node>(parent, table.instantiate("__internal__:/Oscillator")));
+    oscillator->partitions().push(std::move(partition));
+    oscillator->partitions().headerCustomType().instances.push(PartitionInstance { 0u, 0u, instance });
+    return project;
+}
+
+static void PrepareScheduler(AScheduler &scheduler)
+{
+    scheduler.setProcessParamByBlockSize(TestBlockSize, TestSampleRate);
+    scheduler.prepareCache(AudioSpecs { TestSampleRate, ChannelArrangement::Mono, Format::Floating32, TestBlockSize });
+}
+
+TEST(Scheduler, RenderAheadRetract)
+{
+    constexpr std::size_t BlockCount = 64u;
+    constexpr Beat EditBeat = 192u;
+
+    PluginTable::Init();
+    // Every note is released before the edit, the second one starts in the dropped blocks and is removed by the edit
+    TestScheduler scheduler(MakeProject(0u, Partition { Note({ 0u, 64u }), Note({ 224u, 288u }, 72u) }, BeatRange { 0u, 512u }));
+    scheduler.setRenderAheadDuration(2.0f);
+    PrepareScheduler(scheduler);
+
+    const auto reference = scheduler.render(BlockCount, [] {});
+    const auto retracted = scheduler.render(BlockCount, [&scheduler] {
+        // Let the scheduler render past the second note before the edit
+        scheduler.waitGeneratedBlocks(60u);
+        const auto generated = scheduler.generatedBlocks();
+        scheduler.edit(EditBeat, [&scheduler] {
+            scheduler.project()->master()->children()[0]->partitions()[0] = Partition { Note({ 0u, 64u }) };
+        });
+        // Free a slot in case the queue is full, the first block is never dropped
+        std::vector<float> block(TestBlockSize);
+        scheduler.read(block.data());
+        // A block in flight and a retract failing on this read may both complete before the retract
+        scheduler.waitGeneratedBlocks(generated + 3u);
+    });
+    const auto edited = scheduler.render(BlockCount, [] {});
+
+    // The removed note was audible in the blocks rendered ahead before the edit
+    ASSERT_FALSE(std::equal(edited.begin(), edited.end(), reference.begin()));
+    // The first block was read before the others, the resumed rendering starts from a fresh state matching an uninterrupted one of the edited project
+    for (auto i = TestBlockSize; i < retracted.size(); ++i)
+        ASSERT_EQ(retracted[i - TestBlockSize], edited[i]);
+}
+
+TEST(Scheduler, TaskFusion)
+{
+    constexpr std::size_t BlockCount = 32u;
+
+    PluginTable::Init();
+    TestScheduler scheduler(MakeProject(3u, Partition { Note({ 0u, 64u }), Note({ 32u, 96u }, 72u) }, BeatRange { 0u, 256u }));
+    PrepareScheduler(scheduler);
+
+    // The chain of mixers is rendered by a single fused task, then by a task per node
+    const auto fused = scheduler.render(BlockCount, [] {});
+    scheduler.setTaskFusion(false);
+    const auto unfused = scheduler.render(BlockCount, [] {});
+    ASSERT_TRUE(std::any_of(fused.begin(), fused.end(), [](const float sample) { return sample != 0.0f; }));
+    for (auto i = 0u; i < fused.size(); ++i)
+        ASSERT_EQ(fused[i], unfused[i]);
+}
@@ -20,3 +20,20 @@ TEST(NoteConverter, FrequencyToKey)
 
     EXPECT_EQ(Midi::NoteConverter::FrequencyToKey(22'000), Midi::NoteConverter::FrequencyToKey(20'000));
 }
+
+TEST(NoteConverter, KeyToFrequency)
+{
+    EXPECT_FLOAT_EQ(Midi::NoteConverter::KeyToFrequency(), 440.0f);
+    EXPECT_FLOAT_EQ(Midi::NoteConverter::KeyToFrequency(81u), 880.0f);
+    EXPECT_FLOAT_EQ(Midi::NoteConverter::KeyToFrequency(57u), 220.0f);
+    EXPECT_NEAR(Midi::NoteConverter::KeyToFrequency(60u), 261.6256f, 1e-3f);
+    EXPECT_EQ(Midi::NoteConverter::KeyToFrequency(200u), Midi::NoteConverter::KeyToFrequency(127u));
+}
+
+TEST(NoteConverter, TuningToRatio)
+{
+    EXPECT_DOUBLE_EQ(Midi::NoteConverter::TuningToRatio(0u), 1.0);
+    EXPECT_DOUBLE_EQ(Midi::NoteConverter::TuningToRatio(1200u), 2.0);
+    EXPECT_DOUBLE_EQ(Midi::NoteConverter::TuningToRatio(static_cast<Tuning>(-1200)), 0.5);
+    EXPECT_NEAR(Midi::NoteConverter::TuningToRatio(100u), SemitoneUpDelta, 1e-9);
+}
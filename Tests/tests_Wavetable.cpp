@@ -0,0 +1,92 @@
+/**
+ * @ Author: Pierre Veysseyre
+ * @ Description: Unit tests of the wavetable oscillator and the noise generator
+ */
+
+#include <gtest/gtest.h>
+
+#include <complex>
+#include <vector>
+
+#include <Audio/DSP/Wavetable.hpp>
+
+using namespace Audio;
+
+/** @brief Magnitude of the DFT bin of a frequency */
+static double GetMagnitude(const std::vector<float> &signal, const double frequency, const double sampleRate)
+{
+    std::complex<double> sum {};
+
+    for (auto i = 0u; i < signal.size(); ++i)
+        sum += static_cast<double>(signal[i]) * std::polar(1.0, -2.0 * M_PI * frequency * static_cast<double>(i) / sampleRate);
+    return std::abs(sum) * 2.0 / static_cast<double>(signal.size());
+}
+
+TEST(Wavetable, Sine)
+{
+    constexpr SampleRate Rate = 48000u;
+    constexpr auto Frequency = 441.0f;
+    DSP::Wavetable wavetable(DSP::Wavetable::Waveform::Sine);
+    std::vector<float> output(1000u);
+
+    wavetable.generate<false>(output.data(), output.size(), 0u, Frequency, Rate, 0.5f);
+    for (auto i = 0u; i < output.size(); ++i)
+        ASSERT_NEAR(output[i], 0.5f * std::sin(2.0 * M_PI * Frequency * i / Rate), 1e-5);
+}
+
+TEST(Wavetable, PhaseOfNoteIndex)
+{
+    constexpr SampleRate Rate = 44100u;
+    constexpr auto Frequency = 1234.5f;
+    DSP::Wavetable wavetable(DSP::Wavetable::Waveform::Saw);
+    const auto increment = DSP::Wavetable::GetPhaseIncrement(Frequency, Rate);
+    std::vector<float> whole(300u), blocks(300u);
+
+    wavetable.generate<false>(whole.data(), whole.size(), 0u, Frequency, Rate);
+    // A block starting at a note index reads the phase of that index
+    auto phase = wavetable.generate<false>(blocks.data(), 100u, 0u, Frequency, Rate);
+    ASSERT_EQ(phase, 100u * increment);
+    phase = wavetable.generate<false>(blocks.data() + 100u, 77u, 100u * increment, Frequency, Rate);
+    wavetable.generate<true>(blocks.data() + 177u, 123u, phase, Frequency, Rate);
+    for (auto i = 0u; i < whole.size(); ++i)
+        ASSERT_EQ(whole[i], blocks[i]);
+}
+
+TEST(Wavetable, BandLimited)
+{
+    constexpr double Rate = 48000.0;
+    std::vector<float> output(4800u);
+
+    for (const auto waveform : { DSP::Wavetable::Waveform::Square, DSP::Wavetable::Waveform::Saw, DSP::Wavetable::Waveform::Triangle }) {
+        DSP::Wavetable wavetable(waveform);
+        // Harmonics 9, 11 and 13 of a naive waveform would fold back under the Nyquist frequency, between the true harmonics
+        wavetable.generate<false>(output.data(), output.size(), 0u, 3100.0f, static_cast<SampleRate>(Rate));
+        ASSERT_GE(GetMagnitude(output, 3100.0, Rate), 0.5);
+        for (const auto alias : { Rate - 3100.0 * 9.0, 3100.0 * 11.0 - Rate, 3100.0 * 13.0 - Rate })
+            ASSERT_NEAR(GetMagnitude(output, std::abs(alias), Rate), 0.0, 1e-3);
+    }
+    ASSERT_EQ(DSP::Wavetable::GetLevel(20.0f, 48000u), 0u);
+    ASSERT_EQ(DSP::Wavetable::GetLevel(15000.0f, 48000u), DSP::Wavetable::LevelCount - 1u);
+}
+
+TEST(Wavetable, Noise)
+{
+    constexpr auto Size = 100'003u;
+    DSP::NoiseGenerator first(42u), second(42u), other(43u);
+    std::vector<float> a(Size), b(Size), c(Size);
+    double sum = 0.0, power = 0.0;
+
+    first.generate<false>(a.data(), Size);
+    second.generate<false>(b.data(), Size);
+    other.generate<false>(c.data(), Size);
+    for (auto i = 0u; i < Size; ++i) {
+        ASSERT_EQ(a[i], b[i]);
+        ASSERT_TRUE(a[i] >= -1.0f && a[i] < 1.0f);
+        sum += a[i];
+        power += a[i] * a[i];
+    }
+    // Uniform noise has a null mean and a variance of 1 / 3
+    ASSERT_NEAR(sum / Size, 0.0, 0.01);
+    ASSERT_NEAR(power / Size, 1.0 / 3.0, 0.01);
+    ASSERT_NE(a[0], c[0]);
+}